@@ -7,34 +7,65 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <bit>
 #include <cassert>
 #include <cctype>
 #include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <climits>
 #include <cmath>
+#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
 #include <cstdio> // to prevent messing <cstdio> after forbidding scanf(), printf(), fopen() by macro
 #include <cstdlib> // to prevent messing <cstdlib> after forbidding exit() and _Exit() by macro
 #include <cstring>
+#include <deque>
 #include <fcntl.h>
 #include <exception>
+#include <functional>
 #include <fstream> // to prevent messing <fstream> after forbidding ifstream and fstream by macro
 #include <iostream> // to prevent messing <iostream> after forbidding cin is forbidden by macro
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <random>
+#include <sched.h>
 #include <set>
+#include <span>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <sys/mman.h>
 #include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <sys/wait.h>
+#include <thread>
 #include <type_traits>
+#include <unordered_set>
 #include <unistd.h> // to prevent messing <unistd.h> after forbidding _exit() by macro
 #include <utility>
 #include <vector>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Compressed input support: define OI_H_ZLIB (and link with -lz) for gzip, OI_H_ZSTD (and link with
+// -lzstd) for zstd
+#ifdef OI_H_ZLIB
+#include <zlib.h>
+#endif
+#ifdef OI_H_ZSTD
+#include <zstd.h>
+#endif
 
 using std::string;
 using std::vector;
@@ -69,8 +100,9 @@ struct InwerVerdict {
         struct StreamImpl {
             int exit_code;
             bool printed = false;
+            std::unique_ptr<std::stringstream> captured = nullptr; // inside FirstFailure::run()
 
-            ~StreamImpl();
+            ~StreamImpl() noexcept(false);
 
             template<class T>
             StreamImpl& operator<<(T&& arg);
@@ -141,17 +173,429 @@ struct Char {
     Char(char& var_, const char* variants_) : var{var_}, variants{variants_} {}
 };
 
+// Reads rows lines of exactly cols characters from alphabet into one buffer, so that the cell in
+// row r and column c (0-based) is var[r * cols + c]. Lines are separated like by >> nl, and the
+// newline after the last one is not scanned, like with Line.
+struct Grid {
+    string& var;
+    size_t rows, cols;
+    const char* alphabet;
+
+    Grid(string& var_, size_t rows_, size_t cols_, const char* alphabet_)
+    : var{var_}, rows{rows_}, cols{cols_}, alphabet{alphabet_} {
+        assert(strchr(alphabet, '\n') == nullptr);
+    }
+};
+
+class Constraint;
+
 template <class T>
 struct Num {
     T& var;
     T min, max; // inclusive
+    Constraint* sum = nullptr;
 
     Num(T& var_, T min_, T max_) : var{var_}, min{min_}, max{max_} { assert(min <= max); }
+
+    // Adds the scanned value to c. Use like this: scanner >> Num{n, 1, max_n}.sum_into(total_n)
+    Num sum_into(Constraint& c) && {
+        static_assert(std::is_integral_v<T>, "Only integers can be summed into a Constraint");
+        sum = &c;
+        return *this;
+    }
 };
 
 template <class A, class B, class C>
 Num(A, B, C) -> Num<A>;
 
+// Integer with bounds known at compile time, use like this: scanner >> CNum<int, 1, max_n>{n}
+// Unless the bounds are huge (at least 10^18 in absolute value), the number is parsed without
+// overflow checks: a number with more significant digits than the bounds have is out of range as
+// soon as the excess digit is read, and the range check is one unsigned comparison.
+template <class T, T Min, T Max>
+struct CNum {
+    static_assert(std::is_integral_v<T> && Min <= Max);
+    T& var;
+};
+
+class Scanner;
+
+// Bound on a sum over the test cases of a test, e.g. the sum of n. Values are added by
+// Num::sum_into(), without overflow. Use like this:
+//     oi::Constraint total_n{"n", 1'000'000};
+//     for (...) {
+//         scanner >> oi::Num{n, 1, max_n}.sum_into(total_n) >> oi::nl;
+//         ...
+//         total_n.end_test_case(scanner); // errors if the sum so far exceeds the limit
+//     }
+class Constraint {
+public:
+    Constraint(const char* name_, int64_t max_) : name{name_}, max{max_} {}
+
+    template <class T>
+    void add(T value) noexcept {
+        static_assert(std::is_integral_v<T>);
+        if (!std::in_range<int64_t>(value) || __builtin_add_overflow(sum, static_cast<int64_t>(value), &sum)) {
+            overflowed = true;
+        }
+    }
+
+    // Checks the limit and counts the test case. Violation is reported by scanner.error() with the
+    // number of the test case, so that it has the scanner's position.
+    void end_test_case(Scanner& scanner);
+
+    [[nodiscard]] int64_t value() const noexcept { return sum; } // meaningless if exceeded()
+    [[nodiscard]] bool exceeded() const noexcept { return overflowed || sum > max; }
+
+private:
+    const char* name;
+    int64_t max;
+    int64_t sum = 0;
+    bool overflowed = false;
+    uint64_t test_cases = 0;
+};
+
+// Scoring of a checker with many test cases in one test. Counts passed and failed test cases and
+// formats only the message of the first failure, so calling fail() is as cheap as pass() afterwards.
+// Use like this:
+//     oi::ScoreAggregator score{lang};
+//     for (...) { if (ok) { score.pass(); } else { score.fail("Expected ", x); } }
+//     score.exit_with_verdict();
+class ScoreAggregator {
+public:
+    // Returns the score in [0, 100] given the number of passed test cases out of total > 0
+    using ScoringFn = int (*)(uint64_t passed, uint64_t total);
+
+    static int proportional(uint64_t passed, uint64_t total) noexcept {
+        return static_cast<int>(passed * 100 / total);
+    }
+
+    static int all_or_nothing(uint64_t passed, uint64_t total) noexcept {
+        return passed == total ? 100 : 0;
+    }
+
+    explicit ScoreAggregator(Lang lang_, ScoringFn scoring_ = proportional) : lang{lang_}, scoring{scoring_} {}
+
+    void pass() noexcept { ++passed; }
+
+    template <class... Msg>
+    void fail(Msg&&... msg);
+
+    [[nodiscard]] uint64_t passed_count() const noexcept { return passed; }
+    [[nodiscard]] uint64_t failed_count() const noexcept { return failed; }
+
+    // Exits through checker_verdict: exit_ok() if every test case passed, otherwise with the score
+    // given by the scoring function and the first failure message (0 points means WRONG).
+    [[noreturn]] void exit_with_verdict();
+
+private:
+    Lang lang;
+    ScoringFn scoring;
+    uint64_t passed = 0, failed = 0;
+    uint64_t first_failed_case = 0; // 1-based
+    string first_failure_msg;
+};
+
+namespace detail {
+enum class FailureKind : uint8_t { CheckerWrong, InwerWrong, LaxScanner };
+} // namespace detail
+
+// Position of a failure in the order of a sequential run: by the test case, then by the token
+struct LogicalPos {
+    uint64_t test_case = 0;
+    uint64_t token = 0;
+
+    auto operator<=>(const LogicalPos&) const = default;
+};
+
+// Arbitration of failures found by the worker threads of a parallel checker or inwer, so that the
+// verdict is the same as in a sequential run. Inside run(pos, fn), a failure through
+// Scanner::error(), checker_verdict.exit_wrong() or inwer_verdict.exit_wrong() does not exit the
+// program but is proposed at pos, and the earliest proposed failure wins. Work of the test cases
+// after the earliest failure so far is skipped. Use like this:
+//     oi::FirstFailure first_failure;
+//     // on the workers, for test case i:
+//     first_failure.run({.test_case = i}, [&] { ... });
+//     // on the main thread, after joining the workers:
+//     first_failure.exit_if_failed();
+class FirstFailure {
+public:
+    // Returns false if fn failed or was skipped because an earlier test case has already failed
+    template <class Fn>
+    bool run(LogicalPos pos, Fn&& fn);
+
+    // Proposes the failure of checker_verdict.exit_wrong(msg...) at pos. The message is formatted only
+    // if it is the earliest failure so far.
+    template <class... Msg>
+    void propose_wrong(LogicalPos pos, Msg&&... msg);
+
+    // True if a failure of an earlier test case has been proposed, so the work at pos is useless
+    [[nodiscard]] bool cancelled(LogicalPos pos) const noexcept {
+        return pos.test_case > first_test_case.load(std::memory_order_relaxed);
+    }
+
+    // Exits exactly as the earliest proposed failure would in a sequential run. Returns if there is
+    // no failure.
+    void exit_if_failed();
+
+private:
+    // Test case of first_pos, read without locking by cancelled()
+    std::atomic<uint64_t> first_test_case = std::numeric_limits<uint64_t>::max();
+    std::mutex mutex;
+    std::optional<LogicalPos> first_pos;
+    detail::FailureKind first_kind = detail::FailureKind::CheckerWrong;
+    string first_msg;
+
+    // Returns false if a failure at pos or before it has already been proposed; otherwise the caller
+    // has to fill first_kind and first_msg while holding the lock
+    bool take_first(LogicalPos pos);
+};
+
+// Number of threads worth running: the CPUs in the affinity mask, limited by the CPU quota of the
+// process's cgroup (cpu.max, or cpu.cfs_quota_us in cgroup v1). It is 1 on sio2. Elsewhere, a positive
+// OI_THREADS environment variable overrides the detection (like OMP_NUM_THREADS).
+[[nodiscard]] unsigned available_threads();
+
+// Tasks run on the shared work-stealing pool of available_threads() - 1 workers. wait() runs pending
+// tasks on the calling thread too, so groups may be nested. With one available thread there are no
+// workers and run() executes the task immediately. Use like this:
+//     oi::TaskGroup tg;
+//     tg.run([&] { a = f(); });
+//     tg.run([&] { b = g(); });
+//     tg.wait();
+class TaskGroup {
+public:
+    TaskGroup() = default;
+    ~TaskGroup() { wait_for_pending(); }
+
+    template <class Fn>
+    void run(Fn&& fn);
+
+    // Waits for all the tasks run so far and rethrows the first exception thrown by them
+    void wait();
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup(TaskGroup&&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+    TaskGroup& operator=(TaskGroup&&) = delete;
+
+private:
+    std::atomic<size_t> pending = 0;
+    std::mutex exception_mutex;
+    std::exception_ptr exception;
+
+    void wait_for_pending() noexcept;
+};
+
+// Calls fn(begin, end) in parallel for the chunks [0, chunk), [chunk, 2 * chunk), ... of [0, n), and
+// returns when all of them are done. The chunks do not depend on the number of threads, so e.g.
+// seeding a Random with the chunk's begin gives the same results everywhere.
+// Use like this: oi::parallel_for(n, 4096, [&](size_t begin, size_t end) { ... });
+template <class Fn>
+void parallel_for(size_t n, size_t chunk, Fn&& fn);
+
+// Round-trip latency statistics of an interaction, in nanoseconds.
+struct LatencyStats {
+    uint64_t count = 0;
+    uint64_t total_ns = 0;
+    uint64_t min_ns = std::numeric_limits<uint64_t>::max();
+    uint64_t max_ns = 0;
+
+    void record(uint64_t ns) noexcept;
+
+    [[nodiscard]] double mean_ns() const noexcept;
+};
+
+// Buffered writer to a file descriptor, meant for interactors (and generators). Nothing is written
+// until flush() or until the buffer fills up, so a whole round of an interaction is sent with a
+// single write().
+// Use like this: writer << x << ' ' << y << '\n'; writer.flush();
+class Writer {
+public:
+    static constexpr size_t default_buffer_size = 1 << 16;
+
+    explicit Writer(int fd_, size_t buffer_size = default_buffer_size);
+    explicit Writer(const char* file_path, size_t buffer_size = default_buffer_size);
+
+    // Flushes the buffer
+    ~Writer();
+
+    Writer& operator<<(char c);
+    Writer& operator<<(std::string_view str);
+
+    template <class T> requires std::is_arithmetic_v<T> && (!std::is_same_v<T, bool>)
+    Writer& operator<<(T val);
+
+    // Writes the buffered data. If a Scanner is tied to this writer, the time until the reply
+    // arrives is recorded in round_trip_stats().
+    void flush();
+
+    [[nodiscard]] const LatencyStats& round_trip_stats() const noexcept { return round_trips; }
+
+    // Private buffer of one chunk of write_parallel(), formatting exactly like the Writer
+    class Chunk {
+    public:
+        Chunk& operator<<(char c);
+        Chunk& operator<<(std::string_view str);
+
+        template <class T> requires std::is_arithmetic_v<T> && (!std::is_same_v<T, bool>)
+        Chunk& operator<<(T val);
+
+    private:
+        friend class Writer;
+
+        std::unique_ptr<char[]> buff;
+        size_t buff_capacity = 0;
+        size_t buff_size = 0;
+
+        char* reserve(size_t len);
+    };
+
+    // Writes the output of fn(chunk, begin, end) for the chunks [0, chunk_size),
+    // [chunk_size, 2 * chunk_size), ... of [0, n) in order, byte-identical to formatting them one
+    // after another with this Writer. The chunks are formatted on the available_threads() into
+    // private buffers, a few per thread at a time. A regular file gets them with pwritev() at the
+    // offsets following from the sizes of the previous chunks, anything else (e.g. a pipe) with
+    // writev() in order; either way while the next chunks are being formatted.
+    // Use like this:
+    //     writer.write_parallel(m, 1 << 14, [&](oi::Writer::Chunk& out, size_t begin, size_t end) {
+    //         for (size_t i = begin; i < end; ++i) { out << edges[i].a << ' ' << edges[i].b << '\n'; }
+    //     });
+    template <class Fn>
+    void write_parallel(size_t n, size_t chunk_size, Fn&& fn);
+
+    Writer(const Writer&) = delete;
+    Writer(Writer&&) = delete;
+    Writer& operator=(const Writer&) = delete;
+    Writer& operator=(Writer&&) = delete;
+
+private:
+    friend class Scanner;
+
+    // Enough for any integer and the shortest representation of any floating-point number
+    static constexpr size_t max_number_len = 32;
+
+    int fd;
+    bool owns_fd = false;
+    std::unique_ptr<char[]> buff;
+    size_t buff_capacity;
+    size_t buff_size = 0;
+
+    std::optional<std::chrono::steady_clock::time_point> awaiting_reply_since;
+    LatencyStats round_trips;
+
+    char* reserve(size_t len);
+    void write_all(const char* data, size_t len);
+    // Writes all of iov, at *offset with pwritev() (advancing *offset) or with writev() if offset is
+    // null
+    void write_all(std::span<iovec> iov, off_t* offset);
+    void on_reply() noexcept;
+};
+
+// Tunes a pipe or a socket used for an interaction, so that a whole round fits in the kernel buffer
+// and a write() never stops halfway: sets the pipe buffer size (F_SETPIPE_SZ) or the socket buffer
+// sizes (SO_SNDBUF, SO_RCVBUF). On SOCK_SEQPACKET sockets every write() of the Writer is one message:
+// an explicit flush(), but also an automatic one when its buffer fills up, so a round is a single
+// message only if it fits in the Writer's buffer. The Scanner reads every message whole, however long.
+// buffer_size should then be at least the Writer's buffer size.
+// Returns false if fd is neither a pipe nor a socket or the kernel refused the new size.
+bool tune_interactive_fd(int fd, int buffer_size) noexcept;
+
+// Anonymous memory mapped with mmap() and advised with MADV_HUGEPAGE, aligned to 2 MiB. Random
+// accesses to big arrays then miss the TLB much less often. If transparent huge pages are not
+// available, it is just regular memory.
+class HugePages {
+public:
+    static constexpr size_t huge_page_size = 2 << 20;
+
+    HugePages() = default;
+    explicit HugePages(size_t bytes);
+    ~HugePages();
+
+    HugePages(HugePages&& other) noexcept;
+    HugePages& operator=(HugePages&& other) noexcept;
+    HugePages(const HugePages&) = delete;
+    HugePages& operator=(const HugePages&) = delete;
+
+    [[nodiscard]] char* data() const noexcept { return mem; }
+    [[nodiscard]] size_t size() const noexcept { return len; }
+
+private:
+    char* mem = nullptr;
+    size_t len = 0;
+};
+
+// Bump allocator over HugePages. Memory is given back only by reset() (which keeps it for reuse) or
+// the destructor, so reset() it e.g. at the beginning of every test case.
+// Use with standard containers through ArenaAllocator.
+class HugePageArena {
+public:
+    explicit HugePageArena(size_t chunk_size_ = 16 * HugePages::huge_page_size)
+    : chunk_size{chunk_size_} {}
+
+    void* allocate(size_t bytes, size_t alignment);
+
+    // Invalidates everything allocated so far
+    void reset() noexcept {
+        current_chunk = 0;
+        used = 0;
+    }
+
+    HugePageArena(const HugePageArena&) = delete;
+    HugePageArena(HugePageArena&&) = delete;
+    HugePageArena& operator=(const HugePageArena&) = delete;
+    HugePageArena& operator=(HugePageArena&&) = delete;
+
+private:
+    size_t chunk_size;
+    vector<HugePages> chunks;
+    size_t current_chunk = 0;
+    size_t used = 0; // in chunks[current_chunk]
+};
+
+// Standard allocator adaptor for HugePageArena; deallocate() is a no-op.
+// Use like this: vector<int, oi::ArenaAllocator<int>> v(n, oi::ArenaAllocator<int>{arena});
+template <class T>
+struct ArenaAllocator {
+    using value_type = T;
+
+    HugePageArena* arena;
+
+    explicit ArenaAllocator(HugePageArena& arena_) noexcept : arena{&arena_} {}
+
+    template <class U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena{other.arena} {} // NOLINT
+
+    T* allocate(size_t n) { return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T))); }
+
+    void deallocate(T* /*unused*/, size_t /*unused*/) noexcept {}
+
+    template <class U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept {
+        return arena == other.arena;
+    }
+};
+
+// Byte-level rules for validate_bytes(). Control characters other than '\n', '\t' and '\r' and
+// the DEL character are never allowed.
+namespace detail {
+class DecompressionThread;
+} // namespace detail
+
+struct BytePolicy {
+    bool allow_tab = false;
+    bool allow_cr = false;
+    bool allow_non_ascii = false; // bytes 128-255
+    bool allow_trailing_whitespace = false; // space (or an allowed tab) before a newline or EOF
+    bool require_final_newline = true;
+};
+
+// Checks the whole unread input against policy in one vectorized pass, so that token parsing can
+// assume a clean byte set. The first violation is reported by scanner.error() at its line and
+// position. The rest of an input read through a FILE* (e.g. stdin) is read into memory first; a
+// Scanner reading from an fd is not supported. Use like this: oi::validate_bytes(scanner, {});
+void validate_bytes(Scanner& scanner, const BytePolicy& policy = {});
+
 class Scanner {
 public:
     enum class Mode {
@@ -163,22 +607,61 @@ public:
              // non-whitespace ignores whitespace, destructor does nothing
         TestInput, // eof DOES NOT ignore newline or whitespace, nl and '\n' DOES NOT ignore
                    // whitespace, whitespace IS NOT equivalent, destructor scans eof
+        Trusted, // for input that has already been validated (e.g. by the inwer): scanning
+                 // non-whitespace ignores whitespace including newlines, nl and '\n' skip the rest
+                 // of the line, no range, length or variant checks, no position tracking, malformed
+                 // input is a bug(), destructor does nothing
     };
 
+    // Scans byte by byte with getc_unlocked(). This is the reference implementation: every other
+    // backend has to behave exactly like it, which is checked by the OI_H_DIFF_TESTS target.
     Scanner(FILE* file_, Mode mode_, Lang lang_);
+    // A regular file is mapped into memory as a whole, which enables mark(), rewind() and peek().
+    // A gzip- or zstd-compressed regular file (detected by its magic bytes) is decompressed into
+    // memory on a helper thread while it is scanned, so it is scanned exactly like the uncompressed
+    // one, see OI_H_ZLIB and OI_H_ZSTD. The part before the first mark() is freed once scanned.
     Scanner(const char* file_path, Mode mode_, Lang lang_);
 
-    ~Scanner();
+    struct Memory {
+        std::string_view data; // has to outlive the Scanner
+    };
+
+    // Use like this: oi::Scanner{oi::Scanner::Memory{str}, mode, lang}
+    Scanner(Memory memory, Mode mode_, Lang lang_);
+
+    // Reads directly from fd (e.g. a pipe connected to the solution in an interactive task). Every
+    // refill is a single read() that returns whatever is available, so scanning never waits for more
+    // than the current token. Before blocking on read(), tied_writer (if set) is flushed and the time
+    // until the reply arrives is recorded in tied_writer->round_trip_stats(). fd is not closed.
+    Scanner(int fd_, Mode mode_, Lang lang_, Writer* tied_writer_ = nullptr);
+
+    // Throws if the destructor checks fail inside FirstFailure::run()
+    ~Scanner() noexcept(false);
+
+    struct Pos {
+        size_t line;
+        size_t pos;
+    };
 
+    // Reports an error at the last scanned char
     template <class... Msg>
     [[noreturn]] void error(Msg&&... msg);
 
+    // Reports an error at pos, e.g. a position saved with last_pos() when the offending token was
+    // scanned
+    template <class... Msg>
+    [[noreturn]] void error_at(Pos pos, Msg&&... msg);
+
+    // Position of the last scanned char (not tracked in Mode::Trusted)
+    [[nodiscard]] Pos last_pos() const noexcept { return last_char_pos; }
+
     Scanner& operator>>(const char& c);
     Scanner& operator>>(EofType /*unused*/);
     Scanner& operator>>(NlType /*unused*/);
     Scanner& operator>>(IgnoreWsType /*unused*/);
 
-    // Reads line without the trailing newline character.
+    // Reads line without the trailing newline character, at most max_size characters of it (a longer
+    // line is an error, reported as soon as the limit is exceeded).
     // Use like this: scanner >> Line{s, 1000}
     Scanner& operator>>(Line line);
 
@@ -188,11 +671,22 @@ public:
     // Use like this: scanner >> Char{c, "TN"}
     Scanner& operator>>(Char chr);
 
+    // Use like this: scanner >> Grid{cells, n, w, ".#"}
+    Scanner& operator>>(Grid grid);
+
     // Use like this: scanner >> Num{x, -1000, 1000}
     // Works with double too: scanner >> Num{x, -3.14, 3.14}
     template <class T>
     Scanner& operator>>(Num<T> num);
 
+    // Use like this: scanner >> CNum<int, 1, 1000>{x}
+    template <class T, T Min, T Max>
+    Scanner& operator>>(CNum<T, Min, Max> num);
+
+    // Same as k times: scanner >> Line{ignored, any_size} >> nl, but on in-memory input it only
+    // searches for newlines, without looking at the contents of the lines.
+    Scanner& skip_lines(size_t k);
+
     Scanner(const Scanner&) = delete;
     Scanner(Scanner&&) = delete;
     Scanner& operator=(const Scanner&) = delete;
@@ -214,16 +708,45 @@ public:
 
     void do_destructor_checks();
 
+    [[nodiscard]] Lang get_lang() const noexcept { return lang; }
+
+    class Mark;
+
+    // True iff the input is in memory (or is being decompressed into it), i.e. mark(), rewind() and
+    // peek() are supported
+    [[nodiscard]] bool is_in_memory() const noexcept { return in_memory; }
+
+    // Remembers the current position, so that the input can be scanned again from there.
+    // Use like this: auto m = scanner.mark(); ...; scanner.rewind(m);
+    [[nodiscard]] Mark mark() const;
+    // Restores the state (position, pending whitespace) exactly as it was at the time of mark()
+    void rewind(const Mark& m);
+
+    // Returns up to n next bytes of the input without consuming them. These are raw bytes, so they
+    // include whitespace that would be ignored or is yet to be scanned in the current Mode.
+    [[nodiscard]] std::string_view peek(size_t n) const;
+
 protected:
-    FILE* file;
+    FILE* file = nullptr;
     FILE* owned_file = nullptr;
+    int fd = -1;
+    // fd is a SOCK_SEQPACKET socket: every underflow() reads one whole message
+    bool seqpacket = false;
+    Writer* tied_writer = nullptr;
     Mode mode;
     Lang lang;
 
-    struct Pos {
-        size_t line;
-        size_t pos;
-    };
+    // Bytes read from fd (or the whole input, if in_memory) but not yet scanned: [buff_pos, buff_end)
+    std::unique_ptr<char[]> buff;
+    size_t buff_capacity = 0;
+    const char* buff_pos = nullptr;
+    const char* buff_end = nullptr;
+
+    bool in_memory = false;
+    void* mapping = nullptr;
+    size_t mapping_size = 0;
+    // The input is being decompressed into memory: [buff_pos, buff_end) grows as it is scanned
+    std::unique_ptr<detail::DecompressionThread> decompressor;
 
     Pos next_char_pos = {.line = 1, .pos = 1};
     Pos last_char_pos = {.line = 1, .pos = 1};
@@ -235,115 +758,503 @@ protected:
     enum class DelayedUnreadChars : uint8_t { WHITESPACE, NEWLINE };
     std::vector<DelayedUnreadChars> delayed_unread_chars;
 
+    void check_in_memory(const char* func) const;
+    // Reads the rest of file into buff (or waits for the rest of the decompressed input), after which
+    // the Scanner works as if it was in memory from the beginning
+    void read_rest_into_memory();
+    // Decompressed input only: waits for the data past buff_end; returns false at the end of input
+    bool wait_for_decompressed() noexcept;
+    void release() noexcept;
+
     bool getchar(int& ch) noexcept; // returns true if not eofed
     void ungetchar(int ch) noexcept;
+    int underflow() noexcept; // returns the next char when the buffer is empty
+    // Mode::Trusted versions of getchar() and ungetchar(), without position tracking
+    int getchar_trusted() noexcept;
+    void ungetchar_trusted(int ch) noexcept;
+    void skip_ws_trusted() noexcept; // including newlines
     static string char_description(int ch);
 
     void read_delayed_unread_chars();
 
+    friend void validate_bytes(Scanner& scanner, const BytePolicy& policy);
+
+    // In-memory only: moves the ungotten char (if any) back to the buffer, so that the unread input
+    // is exactly [buff_pos, buff_end). Returns false if EOF has been reached.
+    bool flush_ungotten_char() noexcept;
+    // In-memory only: consumes [buff_pos, target) as if by getchar()
+    void consume_to(const char* target) noexcept;
+    // Same as consume_to(target), for any buffer, if [buff_pos, target) contains no newline
+    void consume_to_in_line(const char* target) noexcept;
+
     template <class T>
     void scan_integer(T& val);
 
+    template <class T>
+    void scan_integer_trusted(T& val);
+
     template <class T>
     void scan_floating_point(T& val);
 };
 
-class Random {
+class Scanner::Mark {
+    friend class Scanner;
+
+    const char* buff_pos;
+    Pos next_char_pos, last_char_pos, prev_last_char_pos;
+    bool eofed;
+    std::optional<int> next_char;
+    std::vector<DelayedUnreadChars> delayed_unread_chars;
+};
+
+// Lazy range of numbers read from the scanner, each one as if by scanner >> Num{x, min, max}. Use
+// like this:
+//     for (int id : oi::tokens(scanner, 1, m).take(k)) { ... }
+// A value is read when the iterator reaches it, so errors are reported in the order of iteration.
+// Without take() the range is unbounded and iteration ends when the loop breaks (or on a read
+// error). Unless separated_by() is used, nothing is read between the numbers, which is right for
+// Mode::UserOutput, Mode::Lax and Mode::Trusted; with Mode::TestInput use .separated_by(' ').
+template <class T>
+class Tokens {
 public:
-    explicit Random(uint_fast64_t seed = 5489);
+    class iterator {
+    public:
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
 
-    template <class T> requires std::is_arithmetic_v<T>
-    T operator()(T min, T max);
+        T operator*() const noexcept { return value; }
 
-    template <class RandomAccessIterator>
-    void shuffle(RandomAccessIterator begin, RandomAccessIterator end);
+        iterator& operator++() {
+            if (--left > 0) {
+                if (tokens->separator) {
+                    *tokens->scanner >> *tokens->separator;
+                }
+                read();
+            }
+            return *this;
+        }
 
-    template <class T>
-    void shuffle(T& container) {
-        shuffle(container.begin(), container.end());
+        void operator++(int) { ++*this; }
+
+        bool operator==(std::default_sentinel_t /*unused*/) const noexcept { return left == 0; }
+
+    private:
+        friend class Tokens;
+
+        const Tokens* tokens;
+        size_t left;
+        T value{};
+
+        iterator(const Tokens* tokens_, size_t left_) : tokens{tokens_}, left{left_} {
+            if (left > 0) {
+                read();
+            }
+        }
+
+        void read() { *tokens->scanner >> Num{value, tokens->min, tokens->max}; }
+    };
+
+    Tokens(Scanner& scanner_, T min_, T max_) : scanner{&scanner_}, min{min_}, max{max_} {
+        assert(min <= max);
     }
 
-    Random(const Random&) = delete;
-    Random(Random&&) = default;
-    Random& operator=(const Random&) = delete;
-    Random& operator=(Random&&) = default;
+    // Reads the first number
+    [[nodiscard]] iterator begin() const { return iterator{this, count}; }
+    [[nodiscard]] std::default_sentinel_t end() const noexcept { return {}; }
+
+    // The same range, limited to the first k numbers
+    [[nodiscard]] Tokens take(size_t k) const noexcept {
+        Tokens res = *this;
+        res.count = std::min(count, k);
+        return res;
+    }
+
+    // The same range, with separator read between consecutive numbers
+    [[nodiscard]] Tokens separated_by(char separator_) const noexcept {
+        Tokens res = *this;
+        res.separator = separator_;
+        return res;
+    }
 
 private:
-    std::mt19937_64 generator;
+    Scanner* scanner;
+    T min, max;
+    size_t count = std::numeric_limits<size_t>::max();
+    std::optional<char> separator;
 };
 
-struct TestInput {
-    string str;
+template <class T>
+[[nodiscard]] Tokens<T> tokens(Scanner& scanner, T min, std::type_identity_t<T> max) {
+    return {scanner, min, max};
+}
 
-    explicit TestInput(string str_) : str{std::move(str_)} {}
+struct GraphOptions {
+    bool directed = false;
+    bool allow_loops = true;
+    bool allow_multi_edges = true;
+    // If true, every edge has a third number (e.g. its colour) in range [attribute_min, attribute_max]
+    bool with_attribute = false;
+    int attribute_min = 0, attribute_max = 0;
 };
 
-struct TestOutput {
-    string str;
+// Graph in the compressed sparse row format. Vertices are numbered from 1 to n, edges from 0 to m - 1
+// in the input order. Arcs leaving v are [offset[v], offset[v + 1]) in arc_to / arc_edge. Every
+// undirected edge gives two arcs, except for a loop, which gives one.
+struct Graph {
+    int n = 0, m = 0;
+    bool directed = false;
+    vector<int> edge_from, edge_to;
+    vector<int> edge_attribute; // empty unless GraphOptions::with_attribute
+    vector<int> offset; // size n + 2
+    vector<int> arc_to, arc_edge;
+
+    [[nodiscard]] int degree(int v) const noexcept {
+        return offset[static_cast<size_t>(v) + 1] - offset[static_cast<size_t>(v)];
+    }
 
-    explicit TestOutput(string str_) : str{std::move(str_)} {}
+    [[nodiscard]] std::span<const int> neighbours(int v) const noexcept {
+        auto u = static_cast<size_t>(v);
+        return {arc_to.data() + offset[u], arc_to.data() + offset[u + 1]};
+    }
+
+    [[nodiscard]] std::span<const int> incident_edges(int v) const noexcept {
+        auto u = static_cast<size_t>(v);
+        return {arc_edge.data() + offset[u], arc_edge.data() + offset[u + 1]};
+    }
 };
 
-struct UserOutput {
-    string str;
+// Reads m lines "a b" (or "a b c" with an attribute), 1 <= a, b <= n, and builds the adjacency in two
+// linear passes (counting sort), without any per-vertex allocations.
+// Use like this: auto g = oi::read_graph(scanner, n, m, {.directed = true, .allow_loops = false});
+Graph read_graph(Scanner& scanner, int n, int m, const GraphOptions& options = {});
 
-    explicit UserOutput(string str_) : str{std::move(str_)} {}
+enum class SequenceOrder { Any, NonDecreasing, Increasing, NonIncreasing, Decreasing };
+
+struct SequenceOptions {
+    SequenceOrder order = SequenceOrder::Any;
+    bool distinct = false; // implied by SequenceOrder::Increasing and SequenceOrder::Decreasing
+    std::optional<int64_t> max_sum = std::nullopt;
 };
 
-struct CheckerOutput {
-    string str;
+// Reads n integers from [min, max] separated by single spaces, checking the options as every number
+// is read, so a violation is reported at the position of the number that breaks it. The newline
+// after the last number is not scanned, like with Line. Duplicates are found with an epoch-stamped
+// array over [min, max] if the range is not much bigger than n, and with a hash set otherwise.
+// Use like this: auto a = oi::read_sequence(scanner, n, 1, max_a, {.distinct = true, .max_sum = max_s});
+template <class T>
+vector<T> read_sequence(Scanner& scanner, size_t n, T min, std::type_identity_t<T> max,
+                        const SequenceOptions& options = {});
 
-    explicit CheckerOutput(string str_) : str{std::move(str_)} {}
-};
+// Linear-time validation of certificates printed by solutions (permutations, paths, trees, ...)
+namespace cert {
 
-} // namespace oi
+// Set of numbers from [0, n). Clearing it is O(1): elements are stamped with the current epoch.
+class EpochSet {
+public:
+    // Empties the set and changes the universe to [0, n)
+    void reset(size_t n);
 
-#define CONCAT_RAW(a, b) a##b
-#define CONCAT(a, b) CONCAT_RAW(a, b)
-#define CHECKER_TEST(...)                                                             \
-    namespace {                                                                       \
-    __attribute__((constructor)) void CONCAT(checker_test_constructor_, __LINE__)() { \
-        ::oi::detail::get_checker_test_fns().emplace_back([] {                        \
-            using oi::CheckerOutput;                                                  \
-            using oi::TestInput;                                                      \
-            using oi::TestOutput;                                                     \
-            using oi::UserOutput;                                                     \
-            ::oi::detail::checker_test(                                               \
-                string{__FILE__ ":"} + std::to_string(__LINE__), __VA_ARGS__          \
-            );                                                                        \
-        });                                                                           \
-    }                                                                                 \
-    }
+    // Returns false if x was already in the set
+    bool insert(size_t x) noexcept;
 
-//////////////////////////////// Implementation ////////////////////////////////
+    [[nodiscard]] bool contains(size_t x) const noexcept { return stamp[x] == epoch; }
 
-namespace oi {
+private:
+    vector<uint32_t> stamp;
+    uint32_t epoch = 0;
+};
 
-inline std::set<Scanner*>& get_all_scanners() noexcept {
-    static std::set<Scanner*> scanners;
-    [[maybe_unused]] static bool x = [] {
-        void (*func)() = [] {
-            // To succeed, the destructor checks have to pass
-            for (auto* scanner : get_all_scanners()) {
-                scanner->do_destructor_checks();
-            }
-        };
-        if (atexit(func)) {
-            std::terminate();
-        }
-        return true;
-    }();
-    return scanners;
-}
+// Disjoint set union with path compression and union by size. Like EpochSet, reset() is O(1).
+class Dsu {
+public:
+    // Makes every element of [0, n) a singleton
+    void reset(size_t n);
 
-[[noreturn]] inline void CheckerVerdict::exit_ok() {
-    // To get the whole score, the destructor checks have to pass
-    for (auto* scanner : get_all_scanners()) {
-        scanner->do_destructor_checks();
-    }
-    std::cout << "OK\n\n100\n" << std::flush;
-    _exit(0);
-}
+    size_t find(size_t x) noexcept;
+
+    // Returns false if a and b were already in the same set
+    bool unite(size_t a, size_t b) noexcept;
+
+    [[nodiscard]] size_t sets_count() const noexcept { return sets; }
+
+private:
+    vector<uint32_t> stamp;
+    vector<uint32_t> parent;
+    vector<uint32_t> size;
+    uint32_t epoch = 0;
+    size_t sets = 0;
+
+    void touch(size_t x) noexcept;
+};
+
+// Vertices are numbered from 1 to g.n and edges from 1 to g.m (as usually printed by solutions).
+// Every check returns std::nullopt if the certificate is valid and the error message otherwise.
+// Scratch memory is kept between the checks, so one Validator should be reused across test cases.
+// Use like this: if (auto err = validator.permutation(p)) { oi::checker_verdict.exit_wrong(*err); }
+class Validator {
+public:
+    explicit Validator(Lang lang_) : lang{lang_} {}
+
+    // p is a permutation of 1, 2, ..., p.size()
+    std::optional<string> permutation(std::span<const int> p);
+
+    // All values are in [min, max] and are pairwise distinct; takes O(max - min) memory
+    std::optional<string> distinct(std::span<const int> vals, int min, int max);
+
+    // vertices form a simple path in g
+    std::optional<string> path(const Graph& g, std::span<const int> vertices);
+
+    // vertices form a simple cycle in g (in undirected graphs of at least 3 vertices)
+    std::optional<string> cycle(const Graph& g, std::span<const int> vertices);
+
+    // edges form a spanning tree of g
+    std::optional<string> spanning_tree(const Graph& g, std::span<const int> edges);
+
+    // edges form a matching in g
+    std::optional<string> matching(const Graph& g, std::span<const int> edges);
+
+    // g is connected
+    std::optional<string> connected(const Graph& g);
+
+    // The edges of the undirected graph g form no cycle
+    std::optional<string> acyclic(const Graph& g);
+
+private:
+    Lang lang;
+    EpochSet seen;
+    Dsu dsu;
+
+    std::optional<string> distinct_vertices(const Graph& g, std::span<const int> vertices);
+    std::optional<string> distinct_edges(const Graph& g, std::span<const int> edges);
+    std::optional<string> edge_exists(const Graph& g, int from, int to) const;
+    // Adds edge e to dsu; fails if its ends are already connected
+    std::optional<string> unite_edge(const Graph& g, int e);
+
+    template <class... Msg>
+    static string concat(Msg&&... msg);
+};
+
+} // namespace cert
+
+// Checks of graphs from test inputs for inwers, each in O(n + m) time without recursion. Scratch
+// memory is kept between the calls, so checking many test cases does not reallocate. A failure
+// exits through inwer_verdict.exit_wrong(), with vertices and edges numbered from 1.
+// Use like this: oi::graph_checks::tree(oi::read_graph(scanner, n, n - 1), lang);
+namespace graph_checks {
+
+void no_loops(const Graph& g, Lang lang);
+
+// Edges of a directed graph are the same if they have the same direction
+void no_multi_edges(const Graph& g, Lang lang);
+
+// A directed graph has to be weakly connected
+void connected(const Graph& g, Lang lang);
+
+// g has to be undirected
+void tree(const Graph& g, Lang lang);
+
+// g has to be directed
+void dag(const Graph& g, Lang lang);
+
+} // namespace graph_checks
+
+class Random {
+public:
+    explicit Random(uint_fast64_t seed = 5489);
+
+    template <class T> requires std::is_arithmetic_v<T>
+    T operator()(T min, T max);
+
+    // Distribution of i in [0, weights.size()) with probability proportional to weights[i], sampled
+    // in O(1) by Walker's alias method. Building it (by Vose's method) takes O(n).
+    class Discrete {
+    public:
+        template <class Weights>
+        explicit Discrete(const Weights& weights);
+
+        [[nodiscard]] size_t size() const noexcept { return columns.size(); }
+
+    private:
+        friend class Random;
+
+        // Column i gives i if the coin is below threshold (out of 2^64), and alias otherwise. Both
+        // are in one struct, so that a sample touches one cache line.
+        struct Column {
+            uint64_t threshold;
+            uint64_t alias;
+        };
+        vector<Column> columns;
+    };
+
+    // Use like this:
+    //     auto colour_dist = rd.discrete(colour_weights); // once
+    //     int colour = static_cast<int>(rd(colour_dist)); // for every sample
+    template <class Weights>
+    [[nodiscard]] static Discrete discrete(const Weights& weights) {
+        return Discrete{weights};
+    }
+
+    size_t operator()(const Discrete& dist);
+
+    // Fills out with samples of dist, the same as rd(dist) for every element in order
+    template <class T> requires std::is_integral_v<T>
+    void fill(std::span<T> out, const Discrete& dist);
+
+    // Fills out with elements of alphabet drawn uniformly at random. Every 64-bit draw gives many
+    // symbols: 64 / log2(k) for an alphabet of size k that is a power of two, and otherwise m such
+    // that k^m <= 2^56, by the unbiased multiply-shift method of Brackett-Rozinsky and Lemire (a draw
+    // is rejected with probability below 2^-8). Use like this: rd.sequence(std::span{v}, vals);
+    template <class T, class Alphabet>
+    void sequence(std::span<T> out, const Alphabet& alphabet);
+
+    // Use like this: auto s = rd.string(n, "ab");
+    std::string string(size_t len, std::string_view alphabet) {
+        std::string res(len, '\0');
+        sequence(std::span{res}, alphabet);
+        return res;
+    }
+
+    template <class RandomAccessIterator>
+    void shuffle(RandomAccessIterator begin, RandomAccessIterator end);
+
+    template <class T>
+    void shuffle(T& container) {
+        shuffle(container.begin(), container.end());
+    }
+
+    // Uniformly random permutation computed on all available threads, the same for the same seed
+    // regardless of their number (but different from shuffle()). Every element is sent to one of
+    // the blocks of about 2^16 elements drawn at random, and then the blocks are shuffled separately
+    // and concatenated. The random numbers come from fast SplitMix64 substreams of the chunks and
+    // blocks, seeded by one draw from this generator. Needs memory for a copy of the elements.
+    template <class RandomAccessIterator>
+    void parallel_shuffle(RandomAccessIterator begin, RandomAccessIterator end);
+
+    template <class T>
+    void parallel_shuffle(T& container) {
+        parallel_shuffle(container.begin(), container.end());
+    }
+
+    Random(const Random&) = delete;
+    Random(Random&&) = default;
+    Random& operator=(const Random&) = delete;
+    Random& operator=(Random&&) = default;
+
+private:
+    std::mt19937_64 generator;
+};
+
+struct TestInput {
+    string str;
+
+    explicit TestInput(string str_) : str{std::move(str_)} {}
+};
+
+struct TestOutput {
+    string str;
+
+    explicit TestOutput(string str_) : str{std::move(str_)} {}
+};
+
+struct UserOutput {
+    string str;
+
+    explicit UserOutput(string str_) : str{std::move(str_)} {}
+};
+
+struct CheckerOutput {
+    string str;
+
+    explicit CheckerOutput(string str_) : str{std::move(str_)} {}
+};
+
+} // namespace oi
+
+#define CONCAT_RAW(a, b) a##b
+#define CONCAT(a, b) CONCAT_RAW(a, b)
+#define CHECKER_TEST(...)                                                             \
+    namespace {                                                                       \
+    __attribute__((constructor)) void CONCAT(checker_test_constructor_, __LINE__)() { \
+        ::oi::detail::get_checker_test_fns().emplace_back([] {                        \
+            using oi::CheckerOutput;                                                  \
+            using oi::TestInput;                                                      \
+            using oi::TestOutput;                                                     \
+            using oi::UserOutput;                                                     \
+            ::oi::detail::checker_test(                                               \
+                string{__FILE__ ":"} + std::to_string(__LINE__), __VA_ARGS__          \
+            );                                                                        \
+        });                                                                           \
+    }                                                                                 \
+    }
+
+//////////////////////////////// Implementation ////////////////////////////////
+
+namespace oi {
+
+namespace detail {
+
+// True on a thread inside FirstFailure::run(), where failures are thrown as CapturedFailure
+inline bool& capturing_failures() noexcept {
+    thread_local bool capturing = false;
+    return capturing;
+}
+
+// std::uncaught_exceptions() when capturing started on this thread, so that ~Scanner can tell an
+// exception thrown while capturing from one that was already propagating (e.g. through a TaskGroup
+// destructor that runs pending tasks)
+inline int& capture_uncaught_base() noexcept {
+    thread_local int base = 0;
+    return base;
+}
+
+struct CapturedFailure {
+    FailureKind kind;
+    string msg; // everything that would have been printed, without the trailing newline
+};
+
+} // namespace detail
+
+inline std::set<Scanner*>& get_all_scanners() noexcept {
+    static std::set<Scanner*> scanners;
+    [[maybe_unused]] static bool x = [] {
+        void (*func)() = [] {
+            // To succeed, the destructor checks have to pass
+            for (auto* scanner : get_all_scanners()) {
+                scanner->do_destructor_checks();
+            }
+        };
+        if (atexit(func)) {
+            std::terminate();
+        }
+        return true;
+    }();
+    return scanners;
+}
+
+// Scanners may be constructed and destroyed concurrently by the workers of a parallel checker
+inline std::mutex& get_all_scanners_mutex() noexcept {
+    static std::mutex mutex;
+    return mutex;
+}
+
+inline void register_scanner(Scanner* scanner) {
+    std::lock_guard lock{get_all_scanners_mutex()};
+    get_all_scanners().emplace(scanner);
+}
+
+inline void unregister_scanner(Scanner* scanner) {
+    std::lock_guard lock{get_all_scanners_mutex()};
+    get_all_scanners().erase(scanner);
+}
+
+[[noreturn]] inline void CheckerVerdict::exit_ok() {
+    // To get the whole score, the destructor checks have to pass
+    for (auto* scanner : get_all_scanners()) {
+        scanner->do_destructor_checks();
+    }
+    std::cout << "OK\n\n100\n" << std::flush;
+    _exit(0);
+}
 
 template <class... Msg>
 [[noreturn]] void CheckerVerdict::exit_ok_with_score(int score, Msg&&... msg) {
@@ -372,6 +1283,13 @@ inline void CheckerVerdict::set_partial_score(int score, Msg&&... msg) {
 
 template <class... Msg>
 [[noreturn]] void CheckerVerdict::exit_wrong(Msg&&... msg) {
+    if (detail::capturing_failures()) {
+        std::stringstream ss;
+        if constexpr (sizeof...(msg) > 0) {
+            (ss << ... << std::forward<Msg>(msg));
+        }
+        throw detail::CapturedFailure{detail::FailureKind::CheckerWrong, std::move(ss).str()};
+    }
     if (partial_score) {
         std::cout << "OK\n";
         std::cout << partial_score_msg;
@@ -395,17 +1313,27 @@ InwerVerdict::Stream::StreamImpl InwerVerdict::Stream::operator()() {
             scanner->do_destructor_checks();
         }
     }
+    if (exit_code != 0 && detail::capturing_failures()) {
+        return StreamImpl{exit_code, false, std::make_unique<std::stringstream>()};
+    }
     return StreamImpl{exit_code};
 }
 
 template<class T>
 InwerVerdict::Stream::StreamImpl& InwerVerdict::Stream::StreamImpl::operator<<(T&& arg) {
     printed = true;
-    std::cout << std::forward<T>(arg);
+    if (captured) {
+        *captured << std::forward<T>(arg);
+    } else {
+        std::cout << std::forward<T>(arg);
+    }
     return *this;
 }
 
-InwerVerdict::Stream::StreamImpl::~StreamImpl() {
+InwerVerdict::Stream::StreamImpl::~StreamImpl() noexcept(false) {
+    if (captured) {
+        throw detail::CapturedFailure{detail::FailureKind::InwerWrong, std::move(*captured).str()};
+    }
     if (printed) {
         std::cout << '\n';
     }
@@ -437,874 +1365,3494 @@ template <class... Msg>
     detail::exit_with_error_msg(2, "BUG: ", std::forward<Msg>(msg)...);
 }
 
-inline Scanner::Scanner(FILE* file_, Mode mode_, Lang lang_)
-: file{file_}
-, mode{mode_}
-, lang{lang_} {
-    get_all_scanners().emplace(this);
-}
-
-inline Scanner::Scanner(const char* file_path, Mode mode_, Lang lang_)
-: file{[file_path] {
-    FILE* f = fopen(file_path, "r");
-    if (!f) {
-        bug("fopen() failed - ", strerror(errno));
+template <class... Msg>
+void ScoreAggregator::fail(Msg&&... msg) {
+    if (failed++ > 0) {
+        return;
+    }
+    first_failed_case = passed + failed;
+    if constexpr (sizeof...(msg) > 0) {
+        std::stringstream ss;
+        (ss << ... << std::forward<Msg>(msg));
+        first_failure_msg = std::move(ss).str();
     }
-    return f;
-}()}
-, owned_file{file}
-, mode{mode_}
-, lang{lang_} {
-    get_all_scanners().emplace(this);
 }
 
-inline Scanner::~Scanner() {
-    do_destructor_checks();
+constexpr const char* test_case_prefix[] = {
+    "Test case ",
+    "Przypadek testowy ",
+};
 
-    get_all_scanners().erase(this);
-    if (owned_file) {
-        (void)fclose(owned_file);
+[[noreturn]] inline void ScoreAggregator::exit_with_verdict() {
+    if (failed == 0) {
+        checker_verdict.exit_ok();
+    }
+    int score = scoring(passed, passed + failed);
+    oi_assert(0 <= score && score <= 100, "scoring function returned ", score);
+    const char* prefix = test_case_prefix[static_cast<int>(lang)];
+    const char* separator = first_failure_msg.empty() ? "" : ": ";
+    if (score == 0) {
+        checker_verdict.exit_wrong(prefix, first_failed_case, separator, first_failure_msg);
     }
+    checker_verdict.exit_ok_with_score(score, prefix, first_failed_case, separator, first_failure_msg);
 }
 
-template <class... Msg>
-[[noreturn]] void do_error(Scanner::Mode mode, Msg&&... msg) {
-    switch (mode) {
-    case Scanner::Mode::UserOutput: checker_verdict.exit_wrong(std::forward<Msg>(msg)...);
-    case Scanner::Mode::Lax: detail::exit_with_error_msg(4, "Lax scanner: ", std::forward<Msg>(msg)...);
-    case Scanner::Mode::TestInput:
-        (inwer_verdict.exit_wrong() << ... << std::forward<Msg>(msg));
+template <class Fn>
+bool FirstFailure::run(LogicalPos pos, Fn&& fn) {
+    if (cancelled(pos)) {
+        return false;
     }
-    __builtin_unreachable();
+    bool& capturing = detail::capturing_failures();
+    oi_assert(!capturing, "FirstFailure::run() cannot be nested");
+    capturing = true;
+    detail::capture_uncaught_base() = std::uncaught_exceptions();
+    try {
+        std::forward<Fn>(fn)();
+    } catch (detail::CapturedFailure& failure) {
+        capturing = false;
+        std::lock_guard lock{mutex};
+        if (take_first(pos)) {
+            first_kind = failure.kind;
+            first_msg = std::move(failure.msg);
+        }
+        return false;
+    } catch (...) {
+        capturing = false;
+        throw;
+    }
+    capturing = false;
+    return true;
 }
 
 template <class... Msg>
-[[noreturn]] void Scanner::error(Msg&&... msg) {
-    switch (lang) {
-    case Lang::EN:
-        do_error(
-            mode,
-            "Line ",
-            last_char_pos.line,
-            ", position ",
-            last_char_pos.pos,
-            ": ",
-            std::forward<Msg>(msg)...
-        );
-    case Lang::PL:
-        do_error(
-            mode,
-            "Wiersz ",
-            last_char_pos.line,
-            ", pozycja ",
-            last_char_pos.pos,
-            ": ",
-            std::forward<Msg>(msg)...
-        );
+void FirstFailure::propose_wrong(LogicalPos pos, Msg&&... msg) {
+    std::lock_guard lock{mutex};
+    if (take_first(pos)) {
+        std::stringstream ss;
+        if constexpr (sizeof...(msg) > 0) {
+            (ss << ... << std::forward<Msg>(msg));
+        }
+        first_kind = detail::FailureKind::CheckerWrong;
+        first_msg = std::move(ss).str();
     }
-    __builtin_unreachable();
 }
 
-constexpr const char* read_eof_expected_a_string[] = {
-    "Read EOF, expected a string",
-    "Wczytano EOF, oczekiwano napisu",
-};
-constexpr const char* too_long_string[] = {
-    "Too long string",
-    "Zbyt dlugi napis",
-};
-constexpr const char* read_eof_expected_a_number[] = {
-    "Read EOF, expected a number",
-    "Wczytano EOF, oczekiwano liczby",
-};
-constexpr const char* read_minus_expected_a_positive_number[] = {
-    "Read '-', expected a non-negative number",
-    "Wczytano '-', oczekiwano nieujemnej liczby",
-};
-constexpr const char* integer_value_out_of_range[] = {
-    "Integer value out of range",
-    "Liczba calkowita spoza zakresu",
-};
-constexpr const char* real_number_value_out_of_range[] = {
-    "Real number value out of range",
-    "Liczba rzeczywista spoza zakresu",
-};
+inline bool FirstFailure::take_first(LogicalPos pos) {
+    if (first_pos && *first_pos <= pos) {
+        return false;
+    }
+    first_pos = pos;
+    first_test_case.store(pos.test_case, std::memory_order_relaxed);
+    return true;
+}
 
-inline Scanner& Scanner::operator>>(const char& c) {
-    switch (mode) {
-    case Mode::UserOutput:
-    case Mode::Lax: {
-        if (isspace(c)) {
-            if (c == '\n') {
-                delayed_unread_chars.emplace_back(DelayedUnreadChars::NEWLINE);
-            } else {
-                delayed_unread_chars.emplace_back(DelayedUnreadChars::WHITESPACE);
-            }
-            return *this;
+inline void FirstFailure::exit_if_failed() {
+    std::lock_guard lock{mutex};
+    if (!first_pos) {
+        return;
+    }
+    switch (first_kind) {
+    case detail::FailureKind::CheckerWrong: checker_verdict.exit_wrong(first_msg);
+    case detail::FailureKind::InwerWrong: {
+        if (first_msg.empty()) {
+            inwer_verdict.exit_wrong();
+        } else {
+            inwer_verdict.exit_wrong() << first_msg;
         }
     } break;
-    case Mode::TestInput: break;
+    case detail::FailureKind::LaxScanner: detail::exit_with_error_msg(4, first_msg);
     }
+}
 
-    read_delayed_unread_chars();
-    switch (mode) {
-    case Mode::UserOutput:
-    case Mode::Lax: {
-        *this >> ignore_ws;
-    } break;
-    case Mode::TestInput: break;
-    }
+namespace detail {
 
-    int ch = 0;
-    if (!getchar(ch)) {
-        switch (lang) {
-        case Lang::EN: error("Read EOF, expected ", char_description(c));
-        case Lang::PL: error("Wczytano EOF, oczekiwano ", char_description(c));
+inline bool we_are_running_on_sio2();
+
+// Returns the limit of the cgroup (v2 or v1) of the process in CPUs, rounded up, if there is one
+inline std::optional<unsigned> cgroup_cpu_limit() {
+    auto parse = [](std::string_view str) -> std::optional<int64_t> {
+        int64_t val = 0;
+        auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), val);
+        if (ec != std::errc{} || ptr != str.data() + str.size()) {
+            return std::nullopt;
+        }
+        return val;
+    };
+    auto ceil_ratio = [](std::optional<int64_t> quota, std::optional<int64_t> period) -> std::optional<unsigned> {
+        if (!quota || !period || *quota <= 0 || *period <= 0) {
+            return std::nullopt;
+        }
+        return static_cast<unsigned>((*quota + *period - 1) / *period);
+    };
+
+    // cgroup v2: "<quota> <period>" or "max <period>" in cpu.max of the cgroup from line "0::<path>"
+    string cpu_max_path = "/sys/fs/cgroup/cpu.max";
+    std::ifstream proc_cgroup{"/proc/self/cgroup"};
+    for (string line; std::getline(proc_cgroup, line);) {
+        if (line.starts_with("0::")) {
+            cpu_max_path = "/sys/fs/cgroup" + line.substr(3) + "/cpu.max";
         }
     }
-    if (ch != c) {
-        switch (lang) {
-        case Lang::EN: error("Read ", char_description(ch), ", expected ", char_description(c));
-        case Lang::PL:
-            error("Wczytano ", char_description(ch), ", oczekiwano ", char_description(c));
+    if (std::ifstream cpu_max{cpu_max_path}) {
+        string quota, period;
+        if (cpu_max >> quota >> period) {
+            return ceil_ratio(parse(quota), parse(period)); // "max" gives std::nullopt
         }
     }
-    return *this;
+
+    // cgroup v1: quota is -1 if there is no limit
+    std::ifstream quota_file{"/sys/fs/cgroup/cpu/cpu.cfs_quota_us"};
+    std::ifstream period_file{"/sys/fs/cgroup/cpu/cpu.cfs_period_us"};
+    string quota, period;
+    if (quota_file >> quota && period_file >> period) {
+        return ceil_ratio(parse(quota), parse(period));
+    }
+    return std::nullopt;
 }
 
-inline Scanner& Scanner::operator>>(EofType /*unused*/) {
-    int ch = 0;
-    switch (mode) {
-    case Mode::UserOutput:
-    case Mode::Lax: {
-        // Ignore delayed chars
-        delayed_unread_chars.clear();
-        // Ignore whitespace including newline
-        for (;;) {
-            if (!getchar(ch)) {
-                return *this;
-            }
-            if (!isspace(ch)) {
-                ungetchar(ch);
-                break;
+// Every worker has a deque of tasks: it pushes and pops its own tasks at the back, and steals from
+// the front of the others' deques. Tasks submitted by other threads go to a separate injection
+// deque. Idle workers sleep until a task is submitted.
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t workers);
+    ~ThreadPool();
+
+    [[nodiscard]] size_t workers_count() const noexcept { return threads.size(); }
+
+    void submit(std::move_only_function<void()> task);
+
+    // Runs one pending task on the calling thread; returns false if there is none
+    bool try_run_one();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::move_only_function<void()>> tasks;
+    };
+
+    vector<std::unique_ptr<Queue>> queues; // queues[i] of the worker i, the injection one at the end
+    vector<std::thread> threads;
+    std::atomic<size_t> queued = 0;
+    std::mutex sleep_mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+
+    static size_t& current_worker() noexcept {
+        thread_local size_t worker = std::numeric_limits<size_t>::max(); // not a worker
+        return worker;
+    }
+
+    std::optional<std::move_only_function<void()>> pop();
+};
+
+inline ThreadPool::ThreadPool(size_t workers) {
+    for (size_t i = 0; i <= workers; ++i) {
+        queues.emplace_back(std::make_unique<Queue>());
+    }
+    for (size_t i = 0; i < workers; ++i) {
+        threads.emplace_back([this, i] {
+            current_worker() = i;
+            for (;;) {
+                if (auto task = pop()) {
+                    (*task)();
+                    continue;
+                }
+                std::unique_lock lock{sleep_mutex};
+                wake.wait(lock, [this] { return stopping || queued.load() > 0; });
+                if (stopping) {
+                    return;
+                }
             }
-        }
-    } break;
-    case Mode::TestInput: break;
+        });
     }
+}
 
-    if (getchar(ch)) {
-        switch (lang) {
-        case Lang::EN: error("Read ", char_description(ch), ", expected EOF");
-        case Lang::PL: error("Wczytano ", char_description(ch), ", oczekiwano EOF");
-        }
+inline ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock{sleep_mutex};
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
     }
-    return *this;
 }
 
-inline Scanner& Scanner::operator>>(NlType /*unused*/) {
-    return *this >> '\n';
+inline void ThreadPool::submit(std::move_only_function<void()> task) {
+    size_t worker = current_worker();
+    auto& queue = *queues[worker < threads.size() ? worker : threads.size()];
+    {
+        std::lock_guard lock{queue.mutex};
+        queue.tasks.emplace_back(std::move(task));
+    }
+    {
+        std::lock_guard lock{sleep_mutex}; // so that a worker going to sleep does not miss it
+        ++queued;
+    }
+    wake.notify_one();
 }
 
-inline Scanner& Scanner::operator>>(IgnoreWsType /*unused*/) {
-    read_delayed_unread_chars();
-    int ch = 0;
-    for (;;) {
-        if (!getchar(ch)) {
-            ungetchar(EOF);
-            break;
+inline std::optional<std::move_only_function<void()>> ThreadPool::pop() {
+    if (queued.load() == 0) {
+        return std::nullopt;
+    }
+    auto take = [this](Queue& queue, bool from_back) -> std::optional<std::move_only_function<void()>> {
+        std::lock_guard lock{queue.mutex};
+        if (queue.tasks.empty()) {
+            return std::nullopt;
         }
-        if (ch == '\n' || !isspace(ch)) {
-            ungetchar(ch);
-            break;
+        std::optional<std::move_only_function<void()>> task;
+        if (from_back) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        } else {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        --queued;
+        return task;
+    };
+    size_t self = current_worker();
+    if (self < threads.size()) {
+        if (auto task = take(*queues[self], true)) {
+            return task;
         }
     }
-    return *this;
+    // Steal, starting after self so that the thieves spread over the queues
+    size_t start = self < threads.size() ? self + 1 : 0;
+    for (size_t k = 0; k < queues.size(); ++k) {
+        size_t i = (start + k) % queues.size();
+        if (i != self) {
+            if (auto task = take(*queues[i], false)) {
+                return task;
+            }
+        }
+    }
+    return std::nullopt;
 }
 
-inline Scanner& Scanner::operator>>(Line line) {
-    read_delayed_unread_chars();
-    line.var.clear();
-    int ch = 0;
-    for (;;) {
-        if (!getchar(ch)) {
-            ungetchar(EOF);
-            break;
+inline bool ThreadPool::try_run_one() {
+    if (auto task = pop()) {
+        (*task)();
+        return true;
+    }
+    return false;
+}
+
+// nullptr if there is only one available thread
+inline ThreadPool* thread_pool() {
+    static auto pool = []() -> std::unique_ptr<ThreadPool> {
+        auto threads = available_threads();
+        return threads > 1 ? std::make_unique<ThreadPool>(threads - 1) : nullptr;
+    }();
+    return pool.get();
+}
+
+} // namespace detail
+
+inline unsigned available_threads() {
+    if (detail::we_are_running_on_sio2()) {
+        return 1;
+    }
+    if (const char* env = getenv("OI_THREADS")) {
+        unsigned threads = 0;
+        auto [ptr, ec] = std::from_chars(env, env + strlen(env), threads);
+        if (ec == std::errc{} && *ptr == '\0' && threads > 0) {
+            return threads;
         }
-        if (ch == '\n') {
-            ungetchar(ch);
-            break;
+    }
+    unsigned threads = std::max(std::thread::hardware_concurrency(), 1U);
+    cpu_set_t set;
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        threads = static_cast<unsigned>(std::max(CPU_COUNT(&set), 1));
+    }
+    if (auto limit = detail::cgroup_cpu_limit()) {
+        threads = std::min(threads, std::max(*limit, 1U));
+    }
+    return threads;
+}
+
+template <class Fn>
+void TaskGroup::run(Fn&& fn) {
+    auto* pool = detail::thread_pool();
+    if (!pool) {
+        try {
+            std::forward<Fn>(fn)();
+        } catch (...) {
+            if (!exception) {
+                exception = std::current_exception();
+            }
         }
-        line.var += static_cast<char>(ch);
+        return;
     }
-    return *this;
+    pending.fetch_add(1);
+    // The task runs in the capture context of its submitter, whichever thread picks it up (e.g. one
+    // waiting inside an unrelated FirstFailure::run())
+    pool->submit([this, fn = std::forward<Fn>(fn), capturing = detail::capturing_failures()]() mutable {
+        bool outer_capturing = std::exchange(detail::capturing_failures(), capturing);
+        int outer_base = std::exchange(detail::capture_uncaught_base(), std::uncaught_exceptions());
+        try {
+            fn();
+        } catch (...) {
+            std::lock_guard lock{exception_mutex};
+            if (!exception) {
+                exception = std::current_exception();
+            }
+        }
+        detail::capturing_failures() = outer_capturing;
+        detail::capture_uncaught_base() = outer_base;
+        pending.fetch_sub(1, std::memory_order_release);
+    });
 }
 
-inline Scanner& Scanner::operator>>(Str str) {
-    read_delayed_unread_chars();
-    switch (mode) {
-    case Mode::UserOutput:
-    case Mode::Lax: {
-        *this >> ignore_ws;
-    } break;
-    case Mode::TestInput: break;
+inline void TaskGroup::wait_for_pending() noexcept {
+    while (pending.load(std::memory_order_acquire) > 0) {
+        if (!detail::thread_pool()->try_run_one()) {
+            std::this_thread::yield();
+        }
     }
+}
 
-    str.var.clear();
-    int ch = 0;
-    if (!getchar(ch)) {
-        error(read_eof_expected_a_string[static_cast<int>(lang)]);
+inline void TaskGroup::wait() {
+    wait_for_pending();
+    std::lock_guard lock{exception_mutex};
+    if (exception) {
+        std::rethrow_exception(std::exchange(exception, nullptr));
     }
-    if (isspace(ch)) {
-        switch (lang) {
-        case Lang::EN: error("Read ", char_description(ch), ", expected a string");
-        case Lang::PL: error("Wczytano ", char_description(ch), ", oczekiwano napisu");
+}
+
+template <class Fn>
+void parallel_for(size_t n, size_t chunk, Fn&& fn) {
+    oi_assert(chunk > 0);
+    size_t chunks = n / chunk + (n % chunk != 0);
+    std::atomic<size_t> next_chunk = 0;
+    auto work = [&] {
+        for (size_t k; (k = next_chunk.fetch_add(1, std::memory_order_relaxed)) < chunks;) {
+            fn(k * chunk, std::min(n, (k + 1) * chunk));
         }
+    };
+    auto* pool = detail::thread_pool();
+    if (!pool || chunks <= 1) {
+        work();
+        return;
+    }
+    TaskGroup tg;
+    for (size_t t = std::min(pool->workers_count(), chunks - 1); t > 0; --t) {
+        tg.run(work);
     }
+    work();
+    tg.wait();
+}
 
-    for (;;) {
-        str.var += static_cast<char>(ch);
-        if (str.var.size() > str.max_size) {
-            error(too_long_string[static_cast<int>(lang)]);
-        }
+namespace detail {
 
-        if (!getchar(ch)) {
-            ungetchar(EOF);
-            break;
+// Streaming decompressor of a gzip- or zstd-compressed file
+class Decompressor {
+public:
+    enum class Format { GZIP, ZSTD };
+
+    // Checks the magic bytes at the beginning of the file
+    static std::optional<Format> detect_format(int fd) noexcept;
+
+    // fd is not closed
+    Decompressor(int fd_, Format format_);
+
+    ~Decompressor();
+
+    // Returns the number of bytes written to out, 0 at the end of data. Throws std::runtime_error if
+    // the input is truncated or corrupted, but only after returning all the data before that point.
+    size_t decompress(char* out, size_t out_size);
+
+    Decompressor(const Decompressor&) = delete;
+    Decompressor(Decompressor&&) = delete;
+    Decompressor& operator=(const Decompressor&) = delete;
+    Decompressor& operator=(Decompressor&&) = delete;
+
+private:
+    int fd;
+    Format format;
+
+    size_t read_input(char* in, size_t in_size);
+
+    std::unique_ptr<char[]> in_buff;
+    static constexpr size_t in_buff_size = 1 << 17;
+#ifdef OI_H_ZLIB
+    z_stream zs{};
+#endif
+#ifdef OI_H_ZSTD
+    ZSTD_DStream* zds = nullptr;
+    ZSTD_inBuffer zin{};
+    size_t zstd_frame_remaining = 0; // non-zero iff a frame is only partially decoded
+#endif
+    bool input_eof = false;
+    string error; // thrown by the next decompress()
+};
+
+inline std::optional<Decompressor::Format> Decompressor::detect_format(int fd) noexcept {
+    unsigned char magic[4];
+    if (pread(fd, magic, sizeof(magic), 0) != sizeof(magic)) {
+        return std::nullopt;
+    }
+    if (magic[0] == 0x1f && magic[1] == 0x8b) {
+        return Format::GZIP;
+    }
+    if (magic[0] == 0x28 && magic[1] == 0xb5 && magic[2] == 0x2f && magic[3] == 0xfd) {
+        return Format::ZSTD;
+    }
+    return std::nullopt;
+}
+
+inline Decompressor::Decompressor(int fd_, Format format_)
+: fd{fd_}
+, format{format_}
+, in_buff{std::make_unique<char[]>(in_buff_size)} {
+    switch (format) {
+    case Format::GZIP: {
+#ifdef OI_H_ZLIB
+        // 32: detect the gzip header automatically
+        if (inflateInit2(&zs, 15 + 32) != Z_OK) {
+            bug("inflateInit2() failed");
         }
-        if (isspace(ch)) {
-            ungetchar(ch);
-            break;
+#else
+        bug("Input is gzip-compressed, compile with -DOI_H_ZLIB and link with -lz to read it");
+#endif
+    } break;
+    case Format::ZSTD: {
+#ifdef OI_H_ZSTD
+        zds = ZSTD_createDStream();
+        if (!zds) {
+            bug("ZSTD_createDStream() failed");
         }
+#else
+        bug("Input is zstd-compressed, compile with -DOI_H_ZSTD and link with -lzstd to read it");
+#endif
+    } break;
     }
-    return *this;
 }
 
-inline Scanner& Scanner::operator>>(Char chr) {
-    read_delayed_unread_chars();
-    switch (mode) {
-    case Mode::UserOutput:
-    case Mode::Lax: {
-        *this >> ignore_ws;
-    } break;
-    case Mode::TestInput: break;
+inline Decompressor::~Decompressor() {
+#ifdef OI_H_ZLIB
+    if (format == Format::GZIP) {
+        (void)inflateEnd(&zs);
+    }
+#endif
+#ifdef OI_H_ZSTD
+    if (format == Format::ZSTD) {
+        (void)ZSTD_freeDStream(zds);
     }
+#endif
+}
 
-    int ch = 0;
-    if (!getchar(ch)) {
-        switch (lang) {
-        case Lang::EN: error("Read EOF, expected one of characters: ", chr.variants);
-        case Lang::PL: error("Wczytano EOF, oczekiwano jednego ze znakow: ", chr.variants);
+inline size_t Decompressor::read_input(char* in, size_t in_size) {
+    for (;;) {
+        auto rc = read(fd, in, in_size);
+        if (rc >= 0) {
+            input_eof = (rc == 0);
+            return static_cast<size_t>(rc);
         }
-    }
-    if (strchr(chr.variants, ch) == nullptr) {
-        switch (lang) {
-        case Lang::EN:
-            error("Read ", char_description(ch), ", expected one of characters: ", chr.variants);
-        case Lang::PL:
-            error(
-                "Wczytano ", char_description(ch), ", oczekiwano jednego ze znakow: ", chr.variants
-            );
+        if (errno != EINTR) {
+            throw std::runtime_error{string{"read() failed - "} + strerror(errno)};
         }
     }
-    chr.var = static_cast<char>(ch);
-    return *this;
 }
 
-template <class T>
-inline Scanner& Scanner::operator>>(Num<T> num) {
-    read_delayed_unread_chars();
-    switch (mode) {
-    case Mode::UserOutput:
-    case Mode::Lax: {
-        *this >> ignore_ws;
-    } break;
-    case Mode::TestInput: break;
+inline size_t Decompressor::decompress([[maybe_unused]] char* out, [[maybe_unused]] size_t out_size) {
+    if (!error.empty()) {
+        throw std::runtime_error{error};
     }
-
-    if constexpr (std::is_integral_v<T>) {
-        scan_integer(num.var);
-        if (num.var < num.min || num.var > num.max) {
-            error(integer_value_out_of_range[static_cast<int>(lang)]);
+    size_t len = 0;
+    switch (format) {
+    case Format::GZIP: {
+#ifdef OI_H_ZLIB
+        zs.next_out = reinterpret_cast<Bytef*>(out);
+        zs.avail_out = static_cast<uInt>(std::min<size_t>(out_size, std::numeric_limits<uInt>::max()));
+        size_t avail_out_before = zs.avail_out;
+        while (zs.avail_out > 0) {
+            if (zs.avail_in == 0) {
+                zs.next_in = reinterpret_cast<Bytef*>(in_buff.get());
+                zs.avail_in = static_cast<uInt>(read_input(in_buff.get(), in_buff_size));
+                if (zs.avail_in == 0) {
+                    // total_in is reset by inflateReset() at the end of every gzip member
+                    if (zs.total_in != 0) {
+                        error = "Truncated gzip input";
+                    }
+                    break;
+                }
+            }
+            auto rc = inflate(&zs, Z_NO_FLUSH);
+            if (rc == Z_STREAM_END) {
+                // The file may consist of many gzip members
+                if (inflateReset(&zs) != Z_OK) {
+                    error = "inflateReset() failed";
+                    break;
+                }
+            } else if (rc != Z_OK && rc != Z_BUF_ERROR) {
+                error = string{"Corrupted gzip input: "} + (zs.msg ? zs.msg : "");
+                break;
+            }
         }
-    } else {
-        scan_floating_point(num.var);
-        if (num.var < num.min || num.var > num.max) {
-            error(real_number_value_out_of_range[static_cast<int>(lang)]);
+        len = avail_out_before - zs.avail_out;
+#endif
+    } break;
+    case Format::ZSTD: {
+#ifdef OI_H_ZSTD
+        ZSTD_outBuffer zout{out, out_size, 0};
+        while (zout.pos < zout.size) {
+            if (zin.pos == zin.size) {
+                zin = {in_buff.get(), read_input(in_buff.get(), in_buff_size), 0};
+                if (zin.size == 0) {
+                    if (zstd_frame_remaining != 0) {
+                        error = "Truncated zstd input";
+                    }
+                    break;
+                }
+            }
+            auto rc = ZSTD_decompressStream(zds, &zout, &zin);
+            if (ZSTD_isError(rc)) {
+                error = string{"Corrupted zstd input: "} + ZSTD_getErrorName(rc);
+                break;
+            }
+            zstd_frame_remaining = rc;
         }
+        len = zout.pos;
+#endif
+    } break;
     }
-    return *this;
+    // The end of data is reported only if there was no error
+    if (len == 0 && !error.empty()) {
+        throw std::runtime_error{error};
+    }
+    return len;
 }
 
-inline bool Scanner::getchar(int& ch) noexcept {
-    if (eofed) {
-        return false;
+// Decompresses a file on a helper thread into an anonymous mapping, while the Scanner scans the part
+// already written. The address space for the whole output is reserved up front, so the data never
+// moves and mark() positions stay valid. Until keep_from() is called, the helper stays at most
+// window bytes ahead of the part released by the Scanner, whose pages are given back to the kernel,
+// so a multi-GB input takes a bounded amount of memory.
+class DecompressionThread {
+public:
+    // Takes ownership of fd
+    DecompressionThread(int fd_, Decompressor::Format format);
+    ~DecompressionThread();
+
+    [[nodiscard]] const char* data() const noexcept { return static_cast<const char*>(mapping); }
+
+    // Waits until at least size bytes are written or the output is complete, and returns the end of
+    // the data written so far. Calls bug() if the input is truncated or corrupted before that.
+    const char* wait_for(size_t size);
+
+    // The data before pos is not needed anymore, unless keep_from() was called with an earlier pos
+    void release_before(const char* pos) noexcept;
+
+    // The data from pos on is kept until the end (for rewind())
+    void keep_from(const char* pos) noexcept;
+
+    DecompressionThread(const DecompressionThread&) = delete;
+    DecompressionThread(DecompressionThread&&) = delete;
+    DecompressionThread& operator=(const DecompressionThread&) = delete;
+    DecompressionThread& operator=(DecompressionThread&&) = delete;
+
+private:
+    static constexpr size_t chunk_size = 1 << 20;
+    static constexpr size_t window = 64 << 20;
+    static constexpr size_t max_reserved = size_t{1} << 40;
+
+    int fd;
+    Decompressor decompressor;
+    void* mapping = nullptr;
+    size_t reserved = 0;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::atomic<size_t> written = 0;
+    size_t released = 0; // [0, released) is given back to the kernel
+    size_t kept = std::numeric_limits<size_t>::max(); // [kept, written) is never released
+    size_t wanted = 0; // the Scanner waits for this many bytes
+    bool finished = false;
+    bool stopping = false;
+    string error;
+    std::thread thread;
+
+    void run() noexcept;
+};
+
+inline DecompressionThread::DecompressionThread(int fd_, Decompressor::Format format)
+: fd{fd_}
+, decompressor{fd_, format} {
+    // Address space only: pages are allocated as the helper writes them
+    for (reserved = max_reserved;; reserved /= 2) {
+        mapping = mmap(
+            nullptr, reserved, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0
+        );
+        if (mapping != MAP_FAILED) {
+            break;
+        }
+        if (reserved <= HugePages::huge_page_size) {
+            bug("mmap() failed - ", strerror(errno));
+        }
     }
+    (void)madvise(mapping, reserved, MADV_HUGEPAGE);
+    thread = std::thread{[this] { run(); }};
+}
 
-    if (next_char) {
-        ch = *next_char;
-        next_char = std::nullopt;
-    } else {
-        ch = getc_unlocked(file);
+inline DecompressionThread::~DecompressionThread() {
+    {
+        std::lock_guard lock{mutex};
+        stopping = true;
     }
-    eofed = (ch == EOF);
-    prev_last_char_pos = last_char_pos;
-    last_char_pos = next_char_pos;
-    if (ch == '\n') {
-        ++next_char_pos.line;
-        next_char_pos.pos = 1;
-    } else {
-        ++next_char_pos.pos;
+    cv.notify_all();
+    thread.join();
+    (void)munmap(mapping, reserved);
+    (void)close(fd);
+}
+
+inline const char* DecompressionThread::wait_for(size_t size) {
+    auto available = written.load(std::memory_order_acquire);
+    if (available < size) {
+        std::unique_lock lock{mutex};
+        wanted = size;
+        cv.notify_all();
+        cv.wait(lock, [&] { return written.load(std::memory_order_relaxed) >= size || finished; });
+        available = written.load(std::memory_order_relaxed);
+        if (available < size && !error.empty()) {
+            bug(error);
+        }
     }
-    return !eofed;
+    return data() + available;
 }
 
-inline void Scanner::ungetchar(int ch) noexcept {
-    assert(!next_char && "cannot ungetchar() more than one without getchar()");
-    next_char = ch;
-    next_char_pos = last_char_pos;
-    last_char_pos = prev_last_char_pos;
-    eofed = false;
-}
-
-inline string Scanner::char_description(int ch) {
-    if (std::isgraph(ch)) {
-        return {'\'', static_cast<char>(ch), '\''};
-    }
-
-    if (ch == ' ') {
-        return "' '";
-    }
-    if (ch == '\n') {
-        return "'\\n'";
-    }
-    if (ch == '\r') {
-        return "'\\r'";
-    }
-    if (ch == '\t') {
-        return "'\\t'";
+inline void DecompressionThread::release_before(const char* pos) noexcept {
+    auto offset = std::min(static_cast<size_t>(pos - data()), kept);
+    // The char just before pos may be an ungotten one
+    offset = offset > 0 ? offset - 1 : 0;
+    auto end = offset / HugePages::huge_page_size * HugePages::huge_page_size;
+    if (end <= released) {
+        return;
     }
-    if (ch == '\0') {
-        return "'\\0'";
+    (void)madvise(static_cast<char*>(mapping) + released, end - released, MADV_DONTNEED);
+    {
+        std::lock_guard lock{mutex};
+        released = end;
     }
+    cv.notify_all();
+}
 
-    constexpr char digits[] = "0123456789abcdef";
-    return {'\'', '\\', 'x', digits[ch >> 4], digits[ch & 15], '\''};
+inline void DecompressionThread::keep_from(const char* pos) noexcept {
+    {
+        std::lock_guard lock{mutex};
+        kept = std::min(kept, static_cast<size_t>(pos - data()));
+    }
+    cv.notify_all();
 }
 
-inline void Scanner::read_delayed_unread_chars() {
-    auto do_read_char = [this](const char* char_description_str) {
-        int ch = 0;
-        if (!getchar(ch)) {
-            switch (lang) {
-            case Lang::EN: error("Read EOF, expected ", char_description_str);
-            case Lang::PL: error("Wczytano EOF, oczekiwano ", char_description_str);
-            }
-        }
-        return ch;
-    };
-    auto unexpected_char_error = [this](int ch, const char* expected_char_description_str) {
-        switch (lang) {
-        case Lang::EN:
-            error("Read ", char_description(ch), ", expected ", expected_char_description_str);
-        case Lang::PL:
-            error(
-                "Wczytano ", char_description(ch), ", oczekiwano ", expected_char_description_str
-            );
-        }
-    };
-    for (auto delayed_unread_char : delayed_unread_chars) {
-        switch (delayed_unread_char) {
-        case DelayedUnreadChars::WHITESPACE: {
-            switch (mode) {
-            case Mode::UserOutput:
-            case Mode::Lax: {
-                int ch = do_read_char("' '");
-                if (!isspace(ch) || ch == '\n') {
-                    unexpected_char_error(ch,"' '");
+inline void DecompressionThread::run() noexcept {
+    try {
+        for (;;) {
+            auto size = written.load(std::memory_order_relaxed);
+            {
+                std::unique_lock lock{mutex};
+                cv.wait(lock, [&] {
+                    return stopping || kept != std::numeric_limits<size_t>::max() ||
+                        size - released < window || size < wanted;
+                });
+                if (stopping) {
+                    return;
                 }
-            } break;
-            case Mode::TestInput: std::terminate(); // BUG: should not happen
             }
-        } break;
-        case DelayedUnreadChars::NEWLINE: {
-            switch (mode) {
-            case Mode::UserOutput:
-            case Mode::Lax: {
-                // Read newline ignoring whitespace before it
-                for (;;) {
-                    int ch = do_read_char("'\\n'");
-                    if (ch == '\n') {
-                        break;
-                    }
-                    if (isspace(ch)) {
-                        continue;
-                    }
-                    unexpected_char_error(ch, "'\\n'");
-                }
-            } break;
-            case Mode::TestInput: std::terminate(); // BUG: should not happen
+            if (size == reserved) {
+                throw std::runtime_error{"Decompressed input does not fit in the address space"};
             }
-        } break;
+            // The chunk is not visible to the Scanner until written is updated
+            auto* out = static_cast<char*>(mapping) + size;
+            auto len = decompressor.decompress(out, std::min(chunk_size, reserved - size));
+            std::lock_guard lock{mutex};
+            if (len == 0) {
+                finished = true;
+                cv.notify_all();
+                return;
+            }
+            written.store(size + len, std::memory_order_release);
+            cv.notify_all();
         }
+    } catch (const std::exception& e) {
+        std::lock_guard lock{mutex};
+        error = e.what();
+        finished = true;
+        cv.notify_all();
     }
-    delayed_unread_chars.clear();
 }
 
-template <class T>
-void Scanner::scan_integer(T& val) {
-    static_assert(std::is_integral_v<T>);
-    int ch = 0;
-    if (!getchar(ch)) {
-        error(read_eof_expected_a_number[static_cast<int>(lang)]);
+} // namespace detail
+
+inline Scanner::Scanner(FILE* file_, Mode mode_, Lang lang_)
+: file{file_}
+, mode{mode_}
+, lang{lang_} {
+    register_scanner(this);
+}
+
+inline Scanner::Scanner(const char* file_path, Mode mode_, Lang lang_) : mode{mode_}, lang{lang_} {
+    int file_fd = open(file_path, O_RDONLY | O_CLOEXEC);
+    if (file_fd == -1) {
+        bug("open() failed - ", strerror(errno));
     }
 
-    bool minus = false;
-    if (ch == '-') {
-        if (std::is_unsigned_v<T>) {
-            error(read_minus_expected_a_positive_number[static_cast<int>(lang)]);
+    struct stat st;
+    if (fstat(file_fd, &st) == 0 && S_ISREG(st.st_mode)) {
+        if (auto format = detail::Decompressor::detect_format(file_fd)) {
+            decompressor = std::make_unique<detail::DecompressionThread>(file_fd, *format);
+            in_memory = true;
+            buff_pos = buff_end = decompressor->data();
+            register_scanner(this);
+            return;
         }
-        minus = true;
-        if (!getchar(ch)) {
-            error(read_eof_expected_a_number[static_cast<int>(lang)]);
+
+        mapping_size = static_cast<size_t>(st.st_size);
+        void* mem = mapping_size == 0
+            ? nullptr
+            : mmap(nullptr, mapping_size, PROT_READ, MAP_PRIVATE, file_fd, 0);
+        if (mem != MAP_FAILED) {
+            if (mem) {
+                (void)madvise(mem, mapping_size, MADV_SEQUENTIAL);
+                // Effective only where the kernel supports huge pages for the page cache
+                (void)madvise(mem, mapping_size, MADV_HUGEPAGE);
+            }
+            (void)close(file_fd);
+            mapping = mem;
+            in_memory = true;
+            buff_pos = static_cast<const char*>(mem);
+            buff_end = buff_pos + mapping_size;
+            register_scanner(this);
+            return;
         }
+        mapping_size = 0;
     }
 
-    if (ch < '0' || '9' < ch) {
-        switch (lang) {
-        case Lang::EN: error("Read ", char_description(ch), ", expected a number");
-        case Lang::PL: error("Wczytano ", char_description(ch), ", oczekiwano liczby");
-        }
+    // Not mappable (e.g. a pipe), fall back to stdio
+    file = owned_file = fdopen(file_fd, "r");
+    if (!file) {
+        bug("fdopen() failed - ", strerror(errno));
     }
+    register_scanner(this);
+}
 
-    val = static_cast<T>(minus ? '0' - ch : ch - '0'); // Will not overflow
-    for (;;) {
-        if (!getchar(ch)) {
-            ungetchar(EOF);
-            break;
-        }
-        if (!isdigit(ch)) {
-            ungetchar(ch);
-            break;
-        }
+inline Scanner::Scanner(Memory memory, Mode mode_, Lang lang_)
+: mode{mode_}
+, lang{lang_}
+, buff_pos{memory.data.data()}
+, buff_end{memory.data.data() + memory.data.size()}
+, in_memory{true} {
+    register_scanner(this);
+}
 
-        if (__builtin_mul_overflow(val, 10, &val)) {
-            error(integer_value_out_of_range[static_cast<int>(lang)]);
-        }
-        if (!minus && __builtin_add_overflow(val, ch - '0', &val)) {
-            error(integer_value_out_of_range[static_cast<int>(lang)]);
+inline Scanner::Scanner(int fd_, Mode mode_, Lang lang_, Writer* tied_writer_)
+: fd{fd_}
+, tied_writer{tied_writer_}
+, mode{mode_}
+, lang{lang_}
+, buff{std::make_unique<char[]>(Writer::default_buffer_size)}
+, buff_capacity{Writer::default_buffer_size} {
+    int type;
+    socklen_t type_len = sizeof(type);
+    seqpacket = getsockopt(fd, SOL_SOCKET, SO_TYPE, &type, &type_len) == 0 && type == SOCK_SEQPACKET;
+    register_scanner(this);
+}
+
+inline Scanner::~Scanner() noexcept(false) {
+    // While an exception thrown inside FirstFailure::run() propagates, the rest of the input is left
+    // unchecked, as it would be by a sequential program that has already exited (and a failure
+    // thrown during the unwinding would terminate). Elsewhere the checks exit, so they always run.
+    if (!detail::capturing_failures() || std::uncaught_exceptions() <= detail::capture_uncaught_base()) {
+        try {
+            do_destructor_checks();
+        } catch (...) {
+            release();
+            throw;
         }
-        if (minus && __builtin_sub_overflow(val, ch - '0', &val)) {
-            error(integer_value_out_of_range[static_cast<int>(lang)]);
+    }
+    release();
+}
+
+inline void Scanner::read_rest_into_memory() {
+    if (decompressor) {
+        buff_end = decompressor->wait_for(std::numeric_limits<size_t>::max());
+        return;
+    }
+    size_t capacity = Writer::default_buffer_size;
+    auto data = std::make_unique<char[]>(capacity);
+    size_t size = 0;
+    // An ungotten char stays just before buff_pos, as in a mapped file
+    bool ungotten = next_char && *next_char != EOF;
+    if (ungotten) {
+        data[size++] = static_cast<char>(*next_char);
+    }
+    if (!eofed && !(next_char && *next_char == EOF)) {
+        for (;;) {
+            if (size == capacity) {
+                auto bigger = std::make_unique<char[]>(2 * capacity);
+                std::memcpy(bigger.get(), data.get(), size);
+                data = std::move(bigger);
+                capacity *= 2;
+            }
+            size_t len = fread(data.get() + size, 1, capacity - size, file);
+            if (len == 0) {
+                if (ferror(file)) {
+                    bug("fread() failed");
+                }
+                break;
+            }
+            size += len;
         }
     }
+    buff = std::move(data);
+    buff_capacity = capacity;
+    buff_pos = buff.get() + (ungotten ? 1 : 0);
+    buff_end = buff.get() + size;
+    file = nullptr; // owned_file is still closed by release()
+    in_memory = true;
 }
 
-template <class T>
-void Scanner::scan_floating_point(T& val) {
-    static_assert(std::is_floating_point_v<T>);
-    int ch = 0;
-    if (!getchar(ch)) {
-        error(read_eof_expected_a_number[static_cast<int>(lang)]);
+inline bool Scanner::wait_for_decompressed() noexcept {
+    decompressor->release_before(buff_pos);
+    auto* end = decompressor->wait_for(static_cast<size_t>(buff_end - decompressor->data()) + 1);
+    return std::exchange(buff_end, end) != end;
+}
+
+inline void Scanner::release() noexcept {
+    unregister_scanner(this);
+    decompressor.reset();
+    if (owned_file) {
+        (void)fclose(owned_file);
     }
+    if (mapping) {
+        (void)munmap(mapping, mapping_size);
+    }
+}
 
-    bool minus = false;
-    if (ch == '-') {
-        minus = true;
-        if (!getchar(ch)) {
-            error(read_eof_expected_a_number[static_cast<int>(lang)]);
+inline bool Scanner::flush_ungotten_char() noexcept {
+    if (next_char) {
+        if (*next_char == EOF) {
+            return false;
         }
+        // An ungotten char is always the one just before buff_pos; its position is next_char_pos
+        --buff_pos;
+        next_char = std::nullopt;
     }
+    return !eofed;
+}
 
-    if (ch < '0' || '9' < ch) {
-        switch (lang) {
-        case Lang::EN: error("Read ", char_description(ch), ", expected a number");
-        case Lang::PL: error("Wczytano ", char_description(ch), ", oczekiwano liczby");
-        }
+inline void Scanner::consume_to(const char* target) noexcept {
+    if (target == buff_pos || mode == Mode::Trusted) {
+        buff_pos = target;
+        return;
+    }
+    const char* last = target - 1;
+    auto newlines = std::count(buff_pos, last, '\n');
+    if (newlines == 0) {
+        last_char_pos = {
+            .line = next_char_pos.line,
+            .pos = next_char_pos.pos + static_cast<size_t>(last - buff_pos),
+        };
+    } else {
+        auto* last_newline = static_cast<const char*>(
+            memrchr(buff_pos, '\n', static_cast<size_t>(last - buff_pos))
+        );
+        last_char_pos = {
+            .line = next_char_pos.line + static_cast<size_t>(newlines),
+            .pos = static_cast<size_t>(last - last_newline),
+        };
+    }
+    // prev_last_char_pos matters only right after getchar(), which sets it anyway
+    prev_last_char_pos = last_char_pos;
+    if (*last == '\n') {
+        next_char_pos = {.line = last_char_pos.line + 1, .pos = 1};
+    } else {
+        next_char_pos = {.line = last_char_pos.line, .pos = last_char_pos.pos + 1};
     }
+    buff_pos = target;
+}
 
-    val = (minus ? '0' - ch : ch - '0'); // Will not overflow
-    for (;;) {
-        if (!getchar(ch)) {
-            ungetchar(EOF);
-            return;
-        }
-        if (ch == '.') {
-            break;
-        }
-        if (!isdigit(ch)) {
-            ungetchar(ch);
-            return;
-        }
-        val *= 10;
-        if (!minus) {
-            val += ch - '0';
-        } else {
-            val -= ch - '0';
-        }
-        if (std::isinf(val)) {
-            error(real_number_value_out_of_range[static_cast<int>(lang)]);
-        }
+inline void Scanner::consume_to_in_line(const char* target) noexcept {
+    if (target == buff_pos || mode == Mode::Trusted) {
+        buff_pos = target;
+        return;
     }
+    auto len = static_cast<size_t>(target - buff_pos);
+    last_char_pos = {.line = next_char_pos.line, .pos = next_char_pos.pos + len - 1};
+    prev_last_char_pos = last_char_pos;
+    next_char_pos.pos += len;
+    buff_pos = target;
+}
 
-    T pow10 = 1;
-    T subpoint = 0;
-    for (;;) {
-        if (!getchar(ch)) {
-            ungetchar(EOF);
-            break;
+inline Scanner& Scanner::skip_lines(size_t k) {
+    if (k == 0) {
+        return *this;
+    }
+    auto find_newline = [this] {
+        const char* from = buff_pos;
+        for (;;) {
+            auto* newline = static_cast<const char*>(
+                memchr(from, '\n', static_cast<size_t>(buff_end - from))
+            );
+            if (newline || !decompressor) {
+                return newline;
+            }
+            from = buff_end;
+            if (!wait_for_decompressed()) {
+                return newline;
+            }
         }
-        if (!isdigit(ch)) {
-            ungetchar(ch);
-            break;
+    };
+    if (in_memory) {
+        read_delayed_unread_chars();
+        if (flush_ungotten_char()) {
+            for (; k > 1; --k) {
+                auto* newline = find_newline();
+                if (!newline) {
+                    break;
+                }
+                consume_to(newline + 1);
+            }
+            if (k == 1) {
+                auto* newline = find_newline();
+                if (newline) {
+                    consume_to(newline);
+                    return *this >> nl;
+                }
+            }
         }
-        pow10 *= 0.1;
-        subpoint += pow10 * (ch - '0');
     }
-    if (!minus) {
-        val += subpoint;
-    } else {
-        val -= subpoint;
+    // Not in memory or the input ends before the k-th newline, so errors are reported exactly as usual
+    string ignored;
+    for (; k > 0; --k) {
+        *this >> Line{ignored, std::numeric_limits<size_t>::max()} >> nl;
     }
-    if (std::isinf(val)) {
-        error(real_number_value_out_of_range[static_cast<int>(lang)]);
+    return *this;
+}
+
+inline void Scanner::check_in_memory(const char* func) const {
+    if (!in_memory) {
+        bug("Scanner::", func, "() requires the input to be in memory (a regular file or Memory{})");
     }
 }
 
-inline void Scanner::do_destructor_checks() {
+inline Scanner::Mark Scanner::mark() const {
+    check_in_memory("mark");
+    if (decompressor) {
+        decompressor->keep_from(buff_pos);
+    }
+    Mark m;
+    m.buff_pos = buff_pos;
+    m.next_char_pos = next_char_pos;
+    m.last_char_pos = last_char_pos;
+    m.prev_last_char_pos = prev_last_char_pos;
+    m.eofed = eofed;
+    m.next_char = next_char;
+    m.delayed_unread_chars = delayed_unread_chars;
+    return m;
+}
+
+inline void Scanner::rewind(const Mark& m) {
+    check_in_memory("rewind");
+    buff_pos = m.buff_pos;
+    next_char_pos = m.next_char_pos;
+    last_char_pos = m.last_char_pos;
+    prev_last_char_pos = m.prev_last_char_pos;
+    eofed = m.eofed;
+    next_char = m.next_char;
+    delayed_unread_chars = m.delayed_unread_chars;
+}
+
+inline std::string_view Scanner::peek(size_t n) const {
+    check_in_memory("peek");
+    if (eofed || (next_char && *next_char == EOF)) {
+        return {};
+    }
+    // An ungotten char is always the one just before buff_pos
+    const char* beg = next_char ? buff_pos - 1 : buff_pos;
+    const char* end = buff_end;
+    if (decompressor) {
+        auto offset = static_cast<size_t>(beg - decompressor->data());
+        end = decompressor->wait_for(offset + std::min(n, std::numeric_limits<size_t>::max() - offset));
+    }
+    return {beg, std::min(n, static_cast<size_t>(end - beg))};
+}
+
+template <class... Msg>
+[[noreturn]] void do_error(Scanner::Mode mode, Msg&&... msg) {
     switch (mode) {
-    case Mode::UserOutput:
-    case Mode::TestInput: {
-        *this >> eof;
-    } break;
-    case Mode::Lax: break;
+    case Scanner::Mode::UserOutput: checker_verdict.exit_wrong(std::forward<Msg>(msg)...);
+    case Scanner::Mode::Lax: {
+        if (detail::capturing_failures()) {
+            std::stringstream ss;
+            (ss << "Lax scanner: " << ... << std::forward<Msg>(msg));
+            throw detail::CapturedFailure{detail::FailureKind::LaxScanner, std::move(ss).str()};
+        }
+        detail::exit_with_error_msg(4, "Lax scanner: ", std::forward<Msg>(msg)...);
     }
+    case Scanner::Mode::Trusted: bug("Trusted scanner: ", std::forward<Msg>(msg)...);
+    case Scanner::Mode::TestInput:
+        (inwer_verdict.exit_wrong() << ... << std::forward<Msg>(msg));
+    }
+    __builtin_unreachable();
 }
 
-inline Random::Random(uint_fast64_t seed) : generator{seed} {}
+template <class... Msg>
+[[noreturn]] void Scanner::error(Msg&&... msg) {
+    error_at(last_char_pos, std::forward<Msg>(msg)...);
+}
 
-template <class T> requires std::is_arithmetic_v<T>
-T Random::operator()(T min, T max) {
-    oi_assert(min <= max);
-    constexpr auto generator_range_len = decltype(generator)::max() - decltype(generator)::min();
-    if constexpr (std::is_floating_point_v<T>) {
-        auto val = generator() - decltype(generator)::min(); // in range [0, generator_range_len]
-        T scaled_val = static_cast<T>(val) / static_cast<T>(generator_range_len); // in range [0, 1]
-        return scaled_val * (max - min) + min;
-    } else if constexpr (std::is_unsigned_v<T>) {
-        auto range_len = static_cast<uint_fast64_t>(max) - static_cast<uint_fast64_t>(min) + 1;
-        if (range_len == 0) { // max range
-            return static_cast<T>(generator());
-        }
-        auto limit = generator_range_len - generator_range_len % range_len;
-        for (;;) {
-            auto val =
-                generator() - decltype(generator)::min(); // in range [0, generator_range_len]
-            // We want val to be in range [0, generator_range_len - generator_range_len % range_len
-            // - 1]
-            // <=> val < generator_range_len - generator_range_len % range_len
-            if (val >= limit) {
-                continue;
-            }
-            return static_cast<T>(val % range_len) + min;
-        }
-    } else {
-        using UT = std::make_unsigned_t<T>;
-        // Shift [min, max] to [umin, umax], where umin >= 0
-        UT umin = static_cast<UT>(min) - static_cast<UT>(std::numeric_limits<T>::min());
-        UT umax = static_cast<UT>(max) - static_cast<UT>(std::numeric_limits<T>::min());
-        UT val = this->operator()<UT>(umin, umax) + static_cast<UT>(std::numeric_limits<T>::min());
-        return static_cast<T>(val);
+template <class... Msg>
+[[noreturn]] void Scanner::error_at(Pos pos, Msg&&... msg) {
+    if (mode == Mode::Trusted) {
+        do_error(mode, std::forward<Msg>(msg)...); // positions are not tracked
     }
-}
-
-template <class RandomAccessIterator>
-void Random::shuffle(RandomAccessIterator begin, RandomAccessIterator end) {
-    for (auto i = end - begin; i > 1;) {
-        --i;
-        std::swap(begin[i], begin[this->operator()<decltype(i)>(0, i)]);
+    switch (lang) {
+    case Lang::EN:
+        do_error(mode, "Line ", pos.line, ", position ", pos.pos, ": ", std::forward<Msg>(msg)...);
+    case Lang::PL:
+        do_error(mode, "Wiersz ", pos.line, ", pozycja ", pos.pos, ": ", std::forward<Msg>(msg)...);
     }
+    __builtin_unreachable();
 }
 
-} // namespace oi
-
-namespace oi::detail {
-
-inline std::vector<void (*)()>& get_checker_test_fns() {
-    static std::vector<void (*)()> test_fns;
-    return test_fns;
-}
-
-} // namespace oi::detail
-
-int the_only_real_true_main(int, char**);
-
-namespace oi::detail {
-
-inline void checker_test(
-    const string& test_name,
-    TestInput test_input,
-    TestOutput test_output,
-    UserOutput user_output,
-    CheckerOutput checker_output
-) {
-    auto terminate_with_error = [test_name](auto&&... msg) {
-        ::oi::detail::exit_with_error_msg(
-            5, "Checker test ", test_name, " failed: ", std::forward<decltype(msg)>(msg)...
-        );
-    };
+constexpr const char* read_eof_expected_a_string[] = {
+    "Read EOF, expected a string",
+    "Wczytano EOF, oczekiwano napisu",
+};
+constexpr const char* too_long_string[] = {
+    "Too long string",
+    "Zbyt dlugi napis",
+};
+constexpr const char* too_long_line[] = {
+    "Too long line",
+    "Zbyt dlugi wiersz",
+};
+constexpr const char* read_eof_expected_a_number[] = {
+    "Read EOF, expected a number",
+    "Wczytano EOF, oczekiwano liczby",
+};
+constexpr const char* read_minus_expected_a_positive_number[] = {
+    "Read '-', expected a non-negative number",
+    "Wczytano '-', oczekiwano nieujemnej liczby",
+};
+constexpr const char* integer_value_out_of_range[] = {
+    "Integer value out of range",
+    "Liczba calkowita spoza zakresu",
+};
+constexpr const char* real_number_value_out_of_range[] = {
+    "Real number value out of range",
+    "Liczba rzeczywista spoza zakresu",
+};
 
-    auto create_fd = [&terminate_with_error] {
-        // Using tmpfile() to be POSIX compliant, so that it works on MacOS.
-        auto* f = tmpfile();
-        if (!f) {
-            terminate_with_error("tmpfile() - ", strerror(errno));
+inline Scanner& Scanner::operator>>(const char& c) {
+    switch (mode) {
+    case Mode::UserOutput:
+    case Mode::Lax: {
+        if (isspace(c)) {
+            if (c == '\n') {
+                delayed_unread_chars.emplace_back(DelayedUnreadChars::NEWLINE);
+            } else {
+                delayed_unread_chars.emplace_back(DelayedUnreadChars::WHITESPACE);
+            }
+            return *this;
         }
-        int fd = dup(fileno(f));
-        if (fclose(f)) {
-            terminate_with_error("flose() - ", strerror(errno));
+    } break;
+    case Mode::TestInput: break;
+    case Mode::Trusted: {
+        if (c == '\n') {
+            int ch = 0;
+            do {
+                ch = getchar_trusted();
+            } while (ch != '\n' && ch != EOF);
+            if (ch == EOF) {
+                ungetchar_trusted(EOF);
+            }
+            return *this;
         }
-        return fd;
-    };
-
-    auto create_fd_with_contents = [&terminate_with_error, &create_fd](const string& contents) {
-        auto fd = create_fd();
-        if (pwrite(fd, contents.data(), contents.size(), 0) !=
-            static_cast<ssize_t>(contents.size()))
-        {
-            terminate_with_error("pwrite() - ", strerror(errno));
+        if (isspace(c)) {
+            int ch = getchar_trusted();
+            if (ch == '\n' || !isspace(ch)) {
+                ungetchar_trusted(ch);
+            }
+            return *this;
         }
-        return fd;
-    };
-
-    int in_fd = create_fd_with_contents(test_input.str);
-    int out_fd = create_fd_with_contents(test_output.str);
-    int user_out_fd = create_fd_with_contents(user_output.str);
+    } break;
+    }
 
-    int checker_out_fd = create_fd();
+    read_delayed_unread_chars();
+    switch (mode) {
+    case Mode::UserOutput:
+    case Mode::Lax: {
+        *this >> ignore_ws;
+    } break;
+    case Mode::TestInput: break;
+    case Mode::Trusted: {
+        skip_ws_trusted();
+    } break;
+    }
 
-    int pid = fork();
-    if (pid == -1) {
-        terminate_with_error("fork() - ", strerror(errno));
+    int ch = 0;
+    if (!getchar(ch)) {
+        switch (lang) {
+        case Lang::EN: error("Read EOF, expected ", char_description(c));
+        case Lang::PL: error("Wczytano EOF, oczekiwano ", char_description(c));
+        }
     }
-    if (pid == 0) {
-        (void)freopen("/dev/null", "r", stdin);
-        if (dup2(checker_out_fd, STDOUT_FILENO) != STDOUT_FILENO) {
-            terminate_with_error("dup2() - ", strerror(errno));
+    if (ch != c) {
+        switch (lang) {
+        case Lang::EN: error("Read ", char_description(ch), ", expected ", char_description(c));
+        case Lang::PL:
+            error("Wczytano ", char_description(ch), ", oczekiwano ", char_description(c));
         }
+    }
+    return *this;
+}
 
-        char prog_name[] = "";
-        auto test_input_path = string{"/dev/fd/"} + std::to_string(in_fd);
-        auto test_output_path = string{"/dev/fd/"} + std::to_string(out_fd);
-        auto user_output_path = string{"/dev/fd/"} + std::to_string(user_out_fd);
-
-        char* argv[] = {
-            prog_name,
-            test_input_path.data(),
-            user_output_path.data(),
-            test_output_path.data(),
-            nullptr,
-        };
-        exit(the_only_real_true_main(4, argv));
+inline Scanner& Scanner::operator>>(EofType /*unused*/) {
+    int ch = 0;
+    switch (mode) {
+    case Mode::UserOutput:
+    case Mode::Lax: {
+        // Ignore delayed chars
+        delayed_unread_chars.clear();
+        // Ignore whitespace including newline
+        for (;;) {
+            if (!getchar(ch)) {
+                return *this;
+            }
+            if (!isspace(ch)) {
+                ungetchar(ch);
+                break;
+            }
+        }
+    } break;
+    case Mode::TestInput: break;
+    case Mode::Trusted: {
+        skip_ws_trusted();
+    } break;
     }
-    (void)close(user_out_fd);
-    (void)close(out_fd);
-    (void)close(in_fd);
 
-    int status;
-    if (waitpid(pid, &status, 0) != pid) {
-        terminate_with_error("waitpid() - ", strerror(errno));
+    if (getchar(ch)) {
+        switch (lang) {
+        case Lang::EN: error("Read ", char_description(ch), ", expected EOF");
+        case Lang::PL: error("Wczytano ", char_description(ch), ", oczekiwano EOF");
+        }
     }
+    return *this;
+}
 
-    std::string captured_output;
-    std::array<char, 4096> buff;
-    for (off_t offset = 0;;) {
-        auto rc = pread(checker_out_fd, buff.data(), buff.size(), offset);
-        if (rc > 0) {
-            offset += rc;
-            captured_output.append(buff.data(), static_cast<size_t>(rc));
-            continue;
+inline Scanner& Scanner::operator>>(NlType /*unused*/) {
+    return *this >> '\n';
+}
+
+inline Scanner& Scanner::operator>>(IgnoreWsType /*unused*/) {
+    read_delayed_unread_chars();
+    int ch = 0;
+    for (;;) {
+        if (!getchar(ch)) {
+            ungetchar(EOF);
+            break;
         }
-        if (rc == 0) {
+        if (ch == '\n' || !isspace(ch)) {
+            ungetchar(ch);
             break;
         }
-        terminate_with_error("pread() - ", strerror(errno));
     }
-    (void)close(checker_out_fd);
+    return *this;
+}
 
-    if (!WIFEXITED(status)) {
-        terminate_with_error("checker program crashed with output:\n", captured_output);
-    }
+inline Scanner& Scanner::operator>>(Line line) {
+    read_delayed_unread_chars();
+    line.var.clear();
+    bool check = (mode != Mode::Trusted);
+    int ch = 0;
+    for (;;) {
+        // Whatever is buffered (all of the input if in memory) is searched for the newline at once
+        if (!file && !next_char && buff_pos != buff_end) {
+            auto* newline = static_cast<const char*>(
+                memchr(buff_pos, '\n', static_cast<size_t>(buff_end - buff_pos))
+            );
+            const char* end = newline ? newline : buff_end;
+            auto len = static_cast<size_t>(end - buff_pos);
+            if (check && len > line.max_size - line.var.size()) {
+                consume_to_in_line(buff_pos + (line.max_size - line.var.size()) + 1);
+                error(too_long_line[static_cast<int>(lang)]);
+            }
+            line.var.append(buff_pos, len);
+            consume_to_in_line(end);
+            if (newline) {
+                break;
+            }
+            continue;
+        }
 
-    int exit_code = WEXITSTATUS(status);
-    if (exit_code != 0) {
-        terminate_with_error(
-            "checker program exited with ", exit_code, " with output:\n", captured_output
-        );
-    }
-    if (captured_output != checker_output.str) {
-        terminate_with_error(
-            "checker program exited with 0 with output:\n",
-            captured_output,
-            "\nexpected it to exit with 0 and output:\n",
-            checker_output.str
-        );
+        if (!getchar(ch)) {
+            ungetchar(EOF);
+            break;
+        }
+        if (ch == '\n') {
+            ungetchar(ch);
+            break;
+        }
+        if (check && line.var.size() == line.max_size) {
+            error(too_long_line[static_cast<int>(lang)]);
+        }
+        line.var += static_cast<char>(ch);
     }
+    return *this;
 }
 
-inline void checker_test(const string &test_name, const string& data) {
-    constexpr std::string_view test_in_str = "@test_in\n";
-    constexpr std::string_view test_out_str = "@test_out\n";
-    constexpr std::string_view user_str = "@user\n";
-    constexpr std::string_view checker_str = "@checker\n";
-    auto find_beg_of = [&data](std::string_view delim, size_t start_pos) -> size_t {
-        auto delim_pos = data.find(delim, start_pos);
-        if (delim_pos == string::npos) {
-            oi::bug("Could not find ", delim, " in the test string");
+inline Scanner& Scanner::operator>>(Str str) {
+    read_delayed_unread_chars();
+    switch (mode) {
+    case Mode::UserOutput:
+    case Mode::Lax: {
+        *this >> ignore_ws;
+    } break;
+    case Mode::TestInput: break;
+    case Mode::Trusted: {
+        skip_ws_trusted();
+        str.var.clear();
+        int ch = 0;
+        while ((ch = getchar_trusted()) != EOF && !isspace(ch)) {
+            str.var += static_cast<char>(ch);
         }
-        return delim_pos + delim.size();
-    };
+        ungetchar_trusted(ch);
+        if (str.var.empty()) {
+            error(read_eof_expected_a_string[static_cast<int>(lang)]);
+        }
+        return *this;
+    }
+    }
 
-    auto test_in_beg = find_beg_of(test_in_str, 0);
-    auto test_out_beg = find_beg_of(test_out_str, test_in_beg);
-    auto user_beg = find_beg_of(user_str, test_out_beg);
-    auto checker_beg = find_beg_of(checker_str, user_beg);
-    checker_test(
-        test_name,
-        TestInput{string{
-            data.begin() + static_cast<ssize_t>(test_in_beg),
-            data.begin() + static_cast<ssize_t>(test_out_beg - test_out_str.size())
-        }},
-        TestOutput{string{
-            data.begin() + static_cast<ssize_t>(test_out_beg),
-            data.begin() + static_cast<ssize_t>(user_beg - user_str.size())
-        }},
-        UserOutput{string{
-            data.begin() + static_cast<ssize_t>(user_beg),
-            data.begin() + static_cast<ssize_t>(checker_beg - checker_str.size())
-        }},
-        CheckerOutput{data.substr(checker_beg)}
-    );
-}
+    str.var.clear();
+    int ch = 0;
+    if (!getchar(ch)) {
+        error(read_eof_expected_a_string[static_cast<int>(lang)]);
+    }
+    if (isspace(ch)) {
+        switch (lang) {
+        case Lang::EN: error("Read ", char_description(ch), ", expected a string");
+        case Lang::PL: error("Wczytano ", char_description(ch), ", oczekiwano napisu");
+        }
+    }
 
-inline bool we_are_running_on_sio2() {
-    auto user_str = getenv("USER");
-    return user_str != nullptr && std::string_view{user_str} == "oioioiworker";
+    for (;;) {
+        str.var += static_cast<char>(ch);
+        if (str.var.size() > str.max_size) {
+            error(too_long_string[static_cast<int>(lang)]);
+        }
+
+        if (!getchar(ch)) {
+            ungetchar(EOF);
+            break;
+        }
+        if (isspace(ch)) {
+            ungetchar(ch);
+            break;
+        }
+    }
+    return *this;
 }
 
-} // namespace oi::detail
+namespace detail {
 
-#define main(...)                                                                              \
-    the_only_real_true_main(__VA_ARGS__);                                                      \
-    /* Before checker_test(), the_only_real_true_main() is declared as: */                     \
-    /* int the_only_real_true_main(int, char**); */                                            \
-    /* it overloads the_only_real_true_main() in case __VA_ARGS__ is empty, */                 \
-    /* hence the workaround */                                                                 \
-    int only_for_type_deduction_main(__VA_ARGS__);                                             \
-                                                                                               \
-    int main(int argc, char** argv) {                                                          \
-        auto filename = std::string_view{__FILE__};                                            \
-        /* Remove the extension */                                                             \
-        while (!filename.empty() && filename.back() != '.') {                                  \
-            filename.remove_suffix(1);                                                         \
-        }                                                                                      \
-        if (filename.ends_with("chk.")) {                                                      \
-            ::oi::detail::change_error_ostream_to_cout();                                      \
-        }                                                                                      \
-                                                                                               \
-        if (!::oi::detail::we_are_running_on_sio2() &&                                         \
-            !oi::detail::get_checker_test_fns().empty())                                       \
-        {                                                                                      \
-            std::cerr << "Running " << oi::detail::get_checker_test_fns().size()               \
-                      << " checker tests...\n";                                                \
-            for (auto checker_test_fn : ::oi::detail::get_checker_test_fns()) {                \
-                checker_test_fn();                                                             \
-            }                                                                                  \
-            std::cerr << "All tests passed.\n";                                                \
-        }                                                                                      \
-                                                                                               \
-        return [&](auto main_func) {                                                           \
-            /* We need main_func in the branches to be template-dependent, hence the lambda */ \
-            if constexpr (std::is_convertible_v<decltype(main_func), int (*)()>) {             \
-                return main_func();                                                            \
-            } else {                                                                           \
-                return main_func(argc, argv);                                                  \
-            }                                                                                  \
-        }(static_cast<decltype(&only_for_type_deduction_main)>(&the_only_real_true_main));     \
-    }                                                                                          \
-    int the_only_real_true_main(__VA_ARGS__)
+// Returns the index of the first char of [str, str + n) that is not allowed, or n
+inline size_t
+first_not_allowed(const char* str, size_t n, const std::array<bool, 256>& allowed, std::string_view alphabet) {
+    size_t i = 0;
+#ifdef __SSE2__
+    if (alphabet.size() <= 8) {
+        for (; i + 16 <= n; i += 16) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i));
+            __m128i ok = _mm_setzero_si128();
+            for (char c : alphabet) {
+                ok = _mm_or_si128(ok, _mm_cmpeq_epi8(v, _mm_set1_epi8(c)));
+            }
+            auto bad = ~static_cast<unsigned>(_mm_movemask_epi8(ok)) & 0xffff;
+            if (bad) {
+                return i + static_cast<size_t>(__builtin_ctz(bad));
+            }
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        if (!allowed[static_cast<unsigned char>(str[i])]) {
+            return i;
+        }
+    }
+    return n;
+}
 
-///////////////// FORBIDDING MACROS /////////////////
-#define cin                                                         \
-    cin;                                                            \
-    static_assert(false, "Don't use cin, use oi::Scanner instead"); \
-    ::std::cin
-#define cout cout; static_assert(false, "Don't use cout, use oi::checker_verdict or oi::inwer_verdict instead or oi::bug()"); ::std::cout
-#define fstream                                                         \
-    fstream;                                                            \
-    static_assert(false, "Don't use fstream, use oi::Scanner instead"); \
-    ::std::fstream
-#define ifstream                                                         \
-    ifstream;                                                            \
-    static_assert(false, "Don't use ifstream, use oi::Scanner instead"); \
-    ::std::ifstream
-#define scanf(...) static_assert(false, "Don't use scanf(), use oi::Scanner instead")
-#define fopen(...) static_assert(false, "Don't use fopen(), use oi::Scanner instead")
-#define printf(...) static_assert(false, "Don't use printf(), use oi::checker_verdict or oi::inwer_verdict or oi::bug() instead")
-#define puts(...) \
-    static_assert(false, "Don't use puts(), use oi::checker_verdict or oi::inwer_verdict instead")
-#define exit(...) static_assert(false, "Don't use exit(), use oi::checker_verdict or oi::inwer_verdict instead")
-#define _exit(...) \
-    static_assert(false, "Don't use _exit(), use oi::checker_verdict or oi::inwer_verdict instead")
-#define _Exit(...) \
-    static_assert(false, "Don't use _Exit(), use oi::checker_verdict or oi::inwer_verdict instead")
-#define rand(...) static_assert(false, "Don't use rand(), use oi::Random")::std::rand
-#define mt19337 \
-    mt19337;    \
-    static_assert(false, "Don't use mt19337, use oi::Random")::std::mt19337
-#define mt19337_64 \
-    mt19337_64;    \
-    static_assert(false, "Don't use mt19337_64, use oi::Random")::std::mt19337_64
-#undef assert
-#define assert(...) static_assert(false, "Don't use assert, use oi_assert()")
+} // namespace detail
 
+inline Scanner& Scanner::operator>>(Grid grid) {
+    std::string_view alphabet = grid.alphabet;
+    std::array<bool, 256> allowed{};
+    for (char c : alphabet) {
+        allowed[static_cast<unsigned char>(c)] = true;
+    }
+    bool check = (mode != Mode::Trusted);
+    auto not_allowed_error = [&](int ch) {
+        if (ch == EOF) {
+            switch (lang) {
+            case Lang::EN: error("Read EOF, expected one of characters: ", grid.alphabet);
+            case Lang::PL: error("Wczytano EOF, oczekiwano jednego ze znakow: ", grid.alphabet);
+            }
+        }
+        switch (lang) {
+        case Lang::EN:
+            error("Read ", char_description(ch), ", expected one of characters: ", grid.alphabet);
+        case Lang::PL:
+            error("Wczytano ", char_description(ch), ", oczekiwano jednego ze znakow: ", grid.alphabet);
+        }
+    };
 
-////////////////////////////////////////////////////////////////////////////////////////////////////
-//////////////////////////////////////////// oi.h tests ////////////////////////////////////////////
-////////////////////////////////////////////////////////////////////////////////////////////////////
+    grid.var.resize(grid.rows * grid.cols);
+    for (size_t r = 0; r < grid.rows; ++r) {
+        if (r > 0) {
+            *this >> nl;
+        }
+        read_delayed_unread_chars();
+        char* row = grid.var.data() + r * grid.cols;
+        size_t c = 0;
+        if (in_memory && flush_ungotten_char()) {
+            c = std::min(grid.cols, static_cast<size_t>(buff_end - buff_pos));
+            memcpy(row, buff_pos, c);
+            size_t bad = check ? detail::first_not_allowed(row, c, allowed, alphabet) : c;
+            if (bad < c) {
+                consume_to(buff_pos + bad + 1);
+                not_allowed_error(static_cast<unsigned char>(row[bad]));
+            }
+            consume_to(buff_pos + c);
+        }
+        // Not in memory or the input ends within the row
+        for (; c < grid.cols; ++c) {
+            int ch = 0;
+            if (!getchar(ch) || (check && !allowed[static_cast<unsigned char>(ch)])) {
+                not_allowed_error(ch);
+            }
+            row[c] = static_cast<char>(ch);
+        }
+    }
+    return *this;
+}
 
-#ifdef OI_H_TESTS
+namespace detail {
 
-#include <array>
-#include <cerrno>
-#include <climits>
-#include <cstdint>
-#include <cstdio>
-#include <cstdlib>
-#include <cstring>
-#include <exception>
-#include <limits>
-#include <list>
-#include <map>
-#include <random>
-#include <set>
-#include <string_view>
-#include <sys/mman.h>
-#include <sys/syscall.h>
-#include <sys/wait.h>
-#include <type_traits>
-#include <unistd.h>
-#include <variant>
-#include <vector>
+struct ByteViolation {
+    size_t index; // of the first violating byte, or n if there is none
+    size_t newlines; // before index
+};
 
-std::vector<void (*)()>& get_test_fns() {
-    static std::vector<void (*)()> test_fns;
-    return test_fns;
+inline ByteViolation first_byte_violation(const char* str, size_t n, const BytePolicy& policy) noexcept {
+    auto is_bad = [&policy](unsigned char ch) {
+        if (ch < 32) {
+            return !(ch == '\n' || (ch == '\t' && policy.allow_tab) || (ch == '\r' && policy.allow_cr));
+        }
+        return ch == 127 || (ch >= 128 && !policy.allow_non_ascii);
+    };
+    auto is_trailing_ws = [&policy](char ch, char next) {
+        return (ch == ' ' || (ch == '\t' && policy.allow_tab)) && next == '\n';
+    };
+
+    size_t i = 0;
+    size_t newlines = 0;
+#ifdef __SSE2__
+    // Bytes below 32 and above 127 are exactly the ones that are negative or less than 32 as
+    // signed chars. The shifted load needs one byte of lookahead, hence i + 17.
+    for (; i + 17 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i));
+        __m128i nl = _mm_cmpeq_epi8(v, _mm_set1_epi8('\n'));
+        __m128i bad = _mm_cmplt_epi8(v, _mm_set1_epi8(32));
+        if (policy.allow_non_ascii) {
+            bad = _mm_andnot_si128(_mm_cmplt_epi8(v, _mm_setzero_si128()), bad);
+        }
+        bad = _mm_or_si128(_mm_andnot_si128(nl, bad), _mm_cmpeq_epi8(v, _mm_set1_epi8(127)));
+        __m128i ws = _mm_cmpeq_epi8(v, _mm_set1_epi8(' '));
+        if (policy.allow_tab) {
+            __m128i tab = _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'));
+            bad = _mm_andnot_si128(tab, bad);
+            ws = _mm_or_si128(ws, tab);
+        }
+        if (policy.allow_cr) {
+            bad = _mm_andnot_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\r')), bad);
+        }
+        if (!policy.allow_trailing_whitespace) {
+            __m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i + 1));
+            bad = _mm_or_si128(bad, _mm_and_si128(ws, _mm_cmpeq_epi8(next, _mm_set1_epi8('\n'))));
+        }
+        auto nl_mask = static_cast<unsigned>(_mm_movemask_epi8(nl));
+        auto bad_mask = static_cast<unsigned>(_mm_movemask_epi8(bad));
+        if (bad_mask) {
+            auto j = static_cast<unsigned>(__builtin_ctz(bad_mask));
+            newlines += static_cast<size_t>(__builtin_popcount(nl_mask & ((1U << j) - 1)));
+            return {.index = i + j, .newlines = newlines};
+        }
+        newlines += static_cast<size_t>(__builtin_popcount(nl_mask));
+    }
+#endif
+    for (; i < n; ++i) {
+        char next = i + 1 < n ? str[i + 1] : '\n'; // whitespace at EOF is trailing too
+        if (is_bad(static_cast<unsigned char>(str[i])) ||
+            (!policy.allow_trailing_whitespace && is_trailing_ws(str[i], next)))
+        {
+            return {.index = i, .newlines = newlines};
+        }
+        newlines += str[i] == '\n';
+    }
+    return {.index = n, .newlines = newlines};
 }
 
-struct Exits { int code; string msg; };
+} // namespace detail
 
-struct Crashes {};
+inline void validate_bytes(Scanner& scanner, const BytePolicy& policy) {
+    if (scanner.file || scanner.decompressor) {
+        scanner.read_rest_into_memory();
+    }
+    if (!scanner.in_memory) {
+        bug("validate_bytes() does not support a Scanner reading from an fd");
+    }
+    // The unread input, starting with the ungotten char (if any) that is at next_char_pos
+    const char* beg = scanner.next_char ? scanner.buff_pos - 1 : scanner.buff_pos;
+    size_t n = scanner.eofed || (scanner.next_char && *scanner.next_char == EOF)
+        ? 0
+        : static_cast<size_t>(scanner.buff_end - beg);
+    auto [index, newlines] = detail::first_byte_violation(beg, n, policy);
+
+    auto lang = static_cast<int>(scanner.get_lang());
+    auto move_to = [&](size_t i, size_t newlines_before) {
+        if (newlines_before == 0) {
+            scanner.last_char_pos = {
+                .line = scanner.next_char_pos.line,
+                .pos = scanner.next_char_pos.pos + i,
+            };
+        } else {
+            auto* last_newline = static_cast<const char*>(memrchr(beg, '\n', i));
+            scanner.last_char_pos = {
+                .line = scanner.next_char_pos.line + newlines_before,
+                .pos = static_cast<size_t>(beg + i - last_newline),
+            };
+        }
+    };
+    if (index < n) {
+        auto is_blank = [&](char c) { return c == ' ' || (c == '\t' && policy.allow_tab); };
+        if (is_blank(beg[index])) {
+            // Reported at the first blank of the run; the ones before the last are not violations
+            size_t first = index;
+            while (first > 0 && is_blank(beg[first - 1])) {
+                --first;
+            }
+            move_to(first, newlines);
+            constexpr const char* trailing_whitespace[] = {
+                "Whitespace at the end of the line",
+                "Bialy znak na koncu wiersza",
+            };
+            scanner.error(trailing_whitespace[lang]);
+        }
+        move_to(index, newlines);
+        constexpr const char* forbidden_character[] = {"Forbidden character ", "Niedozwolony znak "};
+        scanner.error(forbidden_character[lang], Scanner::char_description(static_cast<unsigned char>(beg[index])));
+    }
+    if (policy.require_final_newline && (n == 0 || beg[n - 1] != '\n')) {
+        if (n > 0) {
+            move_to(n - 1, newlines);
+        }
+        constexpr const char* no_final_newline[] = {
+            "No newline at the end of the input",
+            "Brak znaku nowej linii na koncu wejscia",
+        };
+        scanner.error(no_final_newline[lang]);
+    }
+}
+
+inline Scanner& Scanner::operator>>(Char chr) {
+    read_delayed_unread_chars();
+    switch (mode) {
+    case Mode::UserOutput:
+    case Mode::Lax: {
+        *this >> ignore_ws;
+    } break;
+    case Mode::TestInput: break;
+    case Mode::Trusted: {
+        skip_ws_trusted();
+        int ch = getchar_trusted();
+        if (ch == EOF) {
+            switch (lang) {
+            case Lang::EN: error("Read EOF, expected one of characters: ", chr.variants);
+            case Lang::PL: error("Wczytano EOF, oczekiwano jednego ze znakow: ", chr.variants);
+            }
+        }
+        chr.var = static_cast<char>(ch);
+        return *this;
+    }
+    }
+
+    int ch = 0;
+    if (!getchar(ch)) {
+        switch (lang) {
+        case Lang::EN: error("Read EOF, expected one of characters: ", chr.variants);
+        case Lang::PL: error("Wczytano EOF, oczekiwano jednego ze znakow: ", chr.variants);
+        }
+    }
+    if (strchr(chr.variants, ch) == nullptr) {
+        switch (lang) {
+        case Lang::EN:
+            error("Read ", char_description(ch), ", expected one of characters: ", chr.variants);
+        case Lang::PL:
+            error(
+                "Wczytano ", char_description(ch), ", oczekiwano jednego ze znakow: ", chr.variants
+            );
+        }
+    }
+    chr.var = static_cast<char>(ch);
+    return *this;
+}
+
+template <class T>
+inline Scanner& Scanner::operator>>(Num<T> num) {
+    read_delayed_unread_chars();
+    switch (mode) {
+    case Mode::UserOutput:
+    case Mode::Lax: {
+        *this >> ignore_ws;
+    } break;
+    case Mode::TestInput: break;
+    case Mode::Trusted: {
+        skip_ws_trusted();
+        if constexpr (std::is_integral_v<T>) {
+            scan_integer_trusted(num.var);
+            if (num.sum) {
+                num.sum->add(num.var);
+            }
+        } else {
+            scan_floating_point(num.var);
+        }
+        return *this;
+    }
+    }
+
+    if constexpr (std::is_integral_v<T>) {
+        scan_integer(num.var);
+        if (num.var < num.min || num.var > num.max) {
+            error(integer_value_out_of_range[static_cast<int>(lang)]);
+        }
+        if (num.sum) {
+            num.sum->add(num.var);
+        }
+    } else {
+        scan_floating_point(num.var);
+        if (num.var < num.min || num.var > num.max) {
+            error(real_number_value_out_of_range[static_cast<int>(lang)]);
+        }
+    }
+    return *this;
+}
+
+template <class T, T Min, T Max>
+inline Scanner& Scanner::operator>>(CNum<T, Min, Max> num) {
+    constexpr auto magnitude = [](T x) { return x < 0 ? 0 - static_cast<uint64_t>(x) : static_cast<uint64_t>(x); };
+    constexpr uint64_t max_magnitude = std::max(magnitude(Min), magnitude(Max));
+    if constexpr (max_magnitude >= 1'000'000'000'000'000'000ULL) {
+        // Numbers with up to 18 digits fit in int64_t, so that out-of-range ones are not missed
+        return *this >> Num{num.var, Min, Max};
+    } else {
+        constexpr int max_digits = [] {
+            int digits = 1;
+            for (auto x = max_magnitude; x >= 10; x /= 10) {
+                ++digits;
+            }
+            return digits;
+        }();
+
+        read_delayed_unread_chars();
+        switch (mode) {
+        case Mode::UserOutput:
+        case Mode::Lax: {
+            *this >> ignore_ws;
+        } break;
+        case Mode::TestInput: break;
+        case Mode::Trusted: {
+            skip_ws_trusted();
+            scan_integer_trusted(num.var);
+            return *this;
+        }
+        }
+
+        int ch = 0;
+        if (!getchar(ch)) {
+            error(read_eof_expected_a_number[static_cast<int>(lang)]);
+        }
+        bool minus = false;
+        if (ch == '-') {
+            if (std::is_unsigned_v<T>) {
+                error(read_minus_expected_a_positive_number[static_cast<int>(lang)]);
+            }
+            minus = true;
+            if (!getchar(ch)) {
+                error(read_eof_expected_a_number[static_cast<int>(lang)]);
+            }
+        }
+        if (ch < '0' || '9' < ch) {
+            switch (lang) {
+            case Lang::EN: error("Read ", char_description(ch), ", expected a number");
+            case Lang::PL: error("Wczytano ", char_description(ch), ", oczekiwano liczby");
+            }
+        }
+
+        uint64_t val = static_cast<uint64_t>(ch - '0');
+        int significant_digits = (val != 0);
+        if (in_memory && !next_char) {
+            // The digits are contiguous in memory, so only the end of the number needs positions
+            const char* p = buff_pos;
+            for (; p != buff_end && static_cast<unsigned char>(*p - '0') < 10; ++p) {
+                val = val * 10 + static_cast<uint64_t>(*p - '0');
+                significant_digits += (val != 0);
+                if (significant_digits > max_digits) {
+                    consume_to_in_line(p + 1);
+                    error(integer_value_out_of_range[static_cast<int>(lang)]);
+                }
+            }
+            consume_to_in_line(p);
+        }
+        for (;;) {
+            if (!getchar(ch)) {
+                ungetchar(EOF);
+                break;
+            }
+            if (!isdigit(ch)) {
+                ungetchar(ch);
+                break;
+            }
+            val = val * 10 + static_cast<uint64_t>(ch - '0');
+            significant_digits += (val != 0);
+            if (significant_digits > max_digits) {
+                error(integer_value_out_of_range[static_cast<int>(lang)]);
+            }
+        }
+        if (minus) {
+            val = 0 - val;
+        }
+        if (val - static_cast<uint64_t>(Min) > static_cast<uint64_t>(Max) - static_cast<uint64_t>(Min)) {
+            error(integer_value_out_of_range[static_cast<int>(lang)]);
+        }
+        num.var = static_cast<T>(val);
+        return *this;
+    }
+}
+
+constexpr const char* sum_of[] = {
+    "sum of ",
+    "suma ",
+};
+constexpr const char* exceeds[] = {
+    " exceeds ",
+    " przekracza ",
+};
+
+inline void Constraint::end_test_case(Scanner& scanner) {
+    ++test_cases;
+    if (exceeded()) {
+        int lang = static_cast<int>(scanner.get_lang());
+        scanner.error(test_case_prefix[lang], test_cases, ": ", sum_of[lang], name, exceeds[lang], max);
+    }
+}
+
+inline bool Scanner::getchar(int& ch) noexcept {
+    if (eofed) {
+        return false;
+    }
+
+    if (next_char) {
+        ch = *next_char;
+        next_char = std::nullopt;
+    } else if (buff_pos != buff_end) {
+        ch = static_cast<unsigned char>(*buff_pos++);
+    } else {
+        ch = underflow();
+    }
+    eofed = (ch == EOF);
+    prev_last_char_pos = last_char_pos;
+    last_char_pos = next_char_pos;
+    if (ch == '\n') {
+        ++next_char_pos.line;
+        next_char_pos.pos = 1;
+    } else {
+        ++next_char_pos.pos;
+    }
+    return !eofed;
+}
+
+inline int Scanner::underflow() noexcept {
+    if (file) {
+        return getc_unlocked(file);
+    }
+    if (in_memory) {
+        if (!decompressor || !wait_for_decompressed()) {
+            return EOF;
+        }
+        return static_cast<unsigned char>(*buff_pos++);
+    }
+
+    if (tied_writer) {
+        tied_writer->flush();
+    }
+    for (;;) {
+        if (seqpacket) {
+            // read() would silently drop the part of a message that does not fit in the buffer
+            auto len = recv(fd, nullptr, 0, MSG_PEEK | MSG_TRUNC);
+            if (len < 0 && errno == EINTR) {
+                continue;
+            }
+            if (len > 0 && static_cast<size_t>(len) > buff_capacity) {
+                buff_capacity = static_cast<size_t>(len);
+                buff = std::make_unique<char[]>(buff_capacity);
+            }
+        }
+        auto rc = read(fd, buff.get(), buff_capacity);
+        if (rc > 0) {
+            if (tied_writer) {
+                tied_writer->on_reply();
+            }
+            buff_pos = buff.get();
+            buff_end = buff_pos + rc;
+            return static_cast<unsigned char>(*buff_pos++);
+        }
+        if (rc == 0) {
+            return EOF;
+        }
+        if (errno != EINTR) {
+            bug("read() failed - ", strerror(errno));
+        }
+    }
+}
+
+inline int Scanner::getchar_trusted() noexcept {
+    if (buff_pos != buff_end && !next_char) {
+        return static_cast<unsigned char>(*buff_pos++);
+    }
+    if (eofed) {
+        return EOF;
+    }
+    int ch = 0;
+    if (next_char) {
+        ch = *next_char;
+        next_char = std::nullopt;
+    } else {
+        ch = underflow();
+    }
+    eofed = (ch == EOF);
+    return ch;
+}
+
+inline void Scanner::ungetchar_trusted(int ch) noexcept {
+    next_char = ch;
+    eofed = false;
+}
+
+inline void Scanner::skip_ws_trusted() noexcept {
+    int ch = 0;
+    do {
+        ch = getchar_trusted();
+    } while (ch != EOF && isspace(ch));
+    ungetchar_trusted(ch);
+}
+
+inline void Scanner::ungetchar(int ch) noexcept {
+    assert(!next_char && "cannot ungetchar() more than one without getchar()");
+    next_char = ch;
+    next_char_pos = last_char_pos;
+    last_char_pos = prev_last_char_pos;
+    eofed = false;
+}
+
+inline string Scanner::char_description(int ch) {
+    if (std::isgraph(ch)) {
+        return {'\'', static_cast<char>(ch), '\''};
+    }
+
+    if (ch == ' ') {
+        return "' '";
+    }
+    if (ch == '\n') {
+        return "'\\n'";
+    }
+    if (ch == '\r') {
+        return "'\\r'";
+    }
+    if (ch == '\t') {
+        return "'\\t'";
+    }
+    if (ch == '\0') {
+        return "'\\0'";
+    }
+
+    constexpr char digits[] = "0123456789abcdef";
+    return {'\'', '\\', 'x', digits[ch >> 4], digits[ch & 15], '\''};
+}
+
+inline void Scanner::read_delayed_unread_chars() {
+    auto do_read_char = [this](const char* char_description_str) {
+        int ch = 0;
+        if (!getchar(ch)) {
+            switch (lang) {
+            case Lang::EN: error("Read EOF, expected ", char_description_str);
+            case Lang::PL: error("Wczytano EOF, oczekiwano ", char_description_str);
+            }
+        }
+        return ch;
+    };
+    auto unexpected_char_error = [this](int ch, const char* expected_char_description_str) {
+        switch (lang) {
+        case Lang::EN:
+            error("Read ", char_description(ch), ", expected ", expected_char_description_str);
+        case Lang::PL:
+            error(
+                "Wczytano ", char_description(ch), ", oczekiwano ", expected_char_description_str
+            );
+        }
+    };
+    for (auto delayed_unread_char : delayed_unread_chars) {
+        switch (delayed_unread_char) {
+        case DelayedUnreadChars::WHITESPACE: {
+            switch (mode) {
+            case Mode::UserOutput:
+            case Mode::Lax: {
+                int ch = do_read_char("' '");
+                if (!isspace(ch) || ch == '\n') {
+                    unexpected_char_error(ch,"' '");
+                }
+            } break;
+            case Mode::TestInput:
+            case Mode::Trusted: std::terminate(); // BUG: should not happen
+            }
+        } break;
+        case DelayedUnreadChars::NEWLINE: {
+            switch (mode) {
+            case Mode::UserOutput:
+            case Mode::Lax: {
+                // Read newline ignoring whitespace before it
+                for (;;) {
+                    int ch = do_read_char("'\\n'");
+                    if (ch == '\n') {
+                        break;
+                    }
+                    if (isspace(ch)) {
+                        continue;
+                    }
+                    unexpected_char_error(ch, "'\\n'");
+                }
+            } break;
+            case Mode::TestInput:
+            case Mode::Trusted: std::terminate(); // BUG: should not happen
+            }
+        } break;
+        }
+    }
+    delayed_unread_chars.clear();
+}
+
+template <class T>
+void Scanner::scan_integer(T& val) {
+    static_assert(std::is_integral_v<T>);
+    int ch = 0;
+    if (!getchar(ch)) {
+        error(read_eof_expected_a_number[static_cast<int>(lang)]);
+    }
+
+    bool minus = false;
+    if (ch == '-') {
+        if (std::is_unsigned_v<T>) {
+            error(read_minus_expected_a_positive_number[static_cast<int>(lang)]);
+        }
+        minus = true;
+        if (!getchar(ch)) {
+            error(read_eof_expected_a_number[static_cast<int>(lang)]);
+        }
+    }
+
+    if (ch < '0' || '9' < ch) {
+        switch (lang) {
+        case Lang::EN: error("Read ", char_description(ch), ", expected a number");
+        case Lang::PL: error("Wczytano ", char_description(ch), ", oczekiwano liczby");
+        }
+    }
+
+    val = static_cast<T>(minus ? '0' - ch : ch - '0'); // Will not overflow
+    for (;;) {
+        if (!getchar(ch)) {
+            ungetchar(EOF);
+            break;
+        }
+        if (!isdigit(ch)) {
+            ungetchar(ch);
+            break;
+        }
+
+        if (__builtin_mul_overflow(val, 10, &val)) {
+            error(integer_value_out_of_range[static_cast<int>(lang)]);
+        }
+        if (!minus && __builtin_add_overflow(val, ch - '0', &val)) {
+            error(integer_value_out_of_range[static_cast<int>(lang)]);
+        }
+        if (minus && __builtin_sub_overflow(val, ch - '0', &val)) {
+            error(integer_value_out_of_range[static_cast<int>(lang)]);
+        }
+    }
+}
+
+template <class T>
+void Scanner::scan_integer_trusted(T& val) {
+    static_assert(std::is_integral_v<T>);
+    int ch = getchar_trusted();
+    bool minus = (ch == '-');
+    if (minus) {
+        ch = getchar_trusted();
+    }
+    if (ch == EOF) {
+        error(read_eof_expected_a_number[static_cast<int>(lang)]);
+    }
+    if (ch < '0' || '9' < ch) {
+        switch (lang) {
+        case Lang::EN: error("Read ", char_description(ch), ", expected a number");
+        case Lang::PL: error("Wczytano ", char_description(ch), ", oczekiwano liczby");
+        }
+    }
+    // Wraps around instead of checking for overflow
+    using U = std::make_unsigned_t<T>;
+    U res = static_cast<U>(ch - '0');
+    while ((ch = getchar_trusted()) >= '0' && ch <= '9') {
+        res = static_cast<U>(res * 10 + static_cast<U>(ch - '0'));
+    }
+    ungetchar_trusted(ch);
+    val = static_cast<T>(minus ? static_cast<U>(0 - res) : res);
+}
+
+template <class T>
+void Scanner::scan_floating_point(T& val) {
+    static_assert(std::is_floating_point_v<T>);
+    int ch = 0;
+    if (!getchar(ch)) {
+        error(read_eof_expected_a_number[static_cast<int>(lang)]);
+    }
+
+    bool minus = false;
+    if (ch == '-') {
+        minus = true;
+        if (!getchar(ch)) {
+            error(read_eof_expected_a_number[static_cast<int>(lang)]);
+        }
+    }
+
+    if (ch < '0' || '9' < ch) {
+        switch (lang) {
+        case Lang::EN: error("Read ", char_description(ch), ", expected a number");
+        case Lang::PL: error("Wczytano ", char_description(ch), ", oczekiwano liczby");
+        }
+    }
+
+    val = (minus ? '0' - ch : ch - '0'); // Will not overflow
+    for (;;) {
+        if (!getchar(ch)) {
+            ungetchar(EOF);
+            return;
+        }
+        if (ch == '.') {
+            break;
+        }
+        if (!isdigit(ch)) {
+            ungetchar(ch);
+            return;
+        }
+        val *= 10;
+        if (!minus) {
+            val += ch - '0';
+        } else {
+            val -= ch - '0';
+        }
+        if (std::isinf(val)) {
+            error(real_number_value_out_of_range[static_cast<int>(lang)]);
+        }
+    }
+
+    T pow10 = 1;
+    T subpoint = 0;
+    for (;;) {
+        if (!getchar(ch)) {
+            ungetchar(EOF);
+            break;
+        }
+        if (!isdigit(ch)) {
+            ungetchar(ch);
+            break;
+        }
+        pow10 *= 0.1;
+        subpoint += pow10 * (ch - '0');
+    }
+    if (!minus) {
+        val += subpoint;
+    } else {
+        val -= subpoint;
+    }
+    if (std::isinf(val)) {
+        error(real_number_value_out_of_range[static_cast<int>(lang)]);
+    }
+}
+
+inline void Scanner::do_destructor_checks() {
+    switch (mode) {
+    case Mode::UserOutput:
+    case Mode::TestInput: {
+        *this >> eof;
+    } break;
+    case Mode::Lax:
+    case Mode::Trusted: break;
+    }
+}
+
+constexpr const char* loop_not_allowed[] = {
+    "Loops are not allowed",
+    "Petle sa niedozwolone",
+};
+
+inline Graph read_graph(Scanner& scanner, int n, int m, const GraphOptions& options) {
+    oi_assert(n >= 0 && m >= 0);
+    if (options.with_attribute) {
+        oi_assert(options.attribute_min <= options.attribute_max);
+    }
+    Graph g;
+    g.n = n;
+    g.m = m;
+    g.directed = options.directed;
+    g.edge_from.resize(static_cast<size_t>(m));
+    g.edge_to.resize(static_cast<size_t>(m));
+    if (options.with_attribute) {
+        g.edge_attribute.resize(static_cast<size_t>(m));
+    }
+
+    // Where every edge ends, to report a multi-edge found after all of them are read
+    vector<Scanner::Pos> edge_end;
+    if (!options.allow_multi_edges) {
+        edge_end.resize(static_cast<size_t>(m));
+    }
+
+    // First pass: read edges and count arcs leaving every vertex (at offset[v + 2])
+    g.offset.assign(static_cast<size_t>(n) + 3, 0);
+    size_t arcs = 0;
+    for (size_t e = 0; e < static_cast<size_t>(m); ++e) {
+        int& a = g.edge_from[e];
+        int& b = g.edge_to[e];
+        scanner >> Num{a, 1, n} >> ' ' >> Num{b, 1, n};
+        if (a == b && !options.allow_loops) {
+            scanner.error(loop_not_allowed[static_cast<int>(scanner.get_lang())]);
+        }
+        if (options.with_attribute) {
+            scanner >> ' ' >> Num{g.edge_attribute[e], options.attribute_min, options.attribute_max};
+        }
+        if (!options.allow_multi_edges) {
+            edge_end[e] = scanner.last_pos();
+        }
+        scanner >> nl;
+
+        ++g.offset[static_cast<size_t>(a) + 2];
+        ++arcs;
+        if (!options.directed && a != b) {
+            ++g.offset[static_cast<size_t>(b) + 2];
+            ++arcs;
+        }
+    }
+    for (size_t v = 1; v < g.offset.size(); ++v) {
+        g.offset[v] += g.offset[v - 1];
+    }
+
+    // Second pass: place arcs; offset[v + 1] moves from the beginning to the end of v's arcs
+    g.arc_to.resize(arcs);
+    g.arc_edge.resize(arcs);
+    auto place = [&g](int from, int to, int e) {
+        auto pos = static_cast<size_t>(g.offset[static_cast<size_t>(from) + 1]++);
+        g.arc_to[pos] = to;
+        g.arc_edge[pos] = e;
+    };
+    for (int e = 0; e < m; ++e) {
+        int a = g.edge_from[static_cast<size_t>(e)];
+        int b = g.edge_to[static_cast<size_t>(e)];
+        place(a, b, e);
+        if (!options.directed && a != b) {
+            place(b, a, e);
+        }
+    }
+    g.offset.pop_back();
+
+    if (!options.allow_multi_edges) {
+        // last_edge[u] = the edge by which u was last seen as a neighbour of the current vertex
+        vector<int> seen_from(static_cast<size_t>(n) + 1, 0);
+        vector<int> last_edge(static_cast<size_t>(n) + 1);
+        for (int v = 1; v <= n; ++v) {
+            auto neighbours = g.neighbours(v);
+            auto edges = g.incident_edges(v);
+            for (size_t i = 0; i < neighbours.size(); ++i) {
+                auto u = static_cast<size_t>(neighbours[i]);
+                if (seen_from[u] == v) {
+                    auto [e1, e2] = std::minmax(last_edge[u], edges[i]);
+                    auto pos = edge_end[static_cast<size_t>(e2)];
+                    switch (scanner.get_lang()) {
+                    case Lang::EN:
+                        scanner.error_at(pos, "Edges ", e1 + 1, " and ", e2 + 1, " connect the same vertices");
+                    case Lang::PL:
+                        scanner.error_at(pos, "Krawedzie ", e1 + 1, " i ", e2 + 1, " lacza te same wierzcholki");
+                    }
+                }
+                seen_from[u] = v;
+                last_edge[u] = edges[i];
+            }
+        }
+    }
+    return g;
+}
+
+namespace cert {
+
+inline void EpochSet::reset(size_t n) {
+    if (++epoch == 0) {
+        std::fill(stamp.begin(), stamp.end(), 0);
+        epoch = 1;
+    }
+    if (stamp.size() < n) {
+        stamp.resize(n, 0);
+    }
+}
+
+inline bool EpochSet::insert(size_t x) noexcept {
+    if (stamp[x] == epoch) {
+        return false;
+    }
+    stamp[x] = epoch;
+    return true;
+}
+
+inline void Dsu::reset(size_t n) {
+    if (++epoch == 0) {
+        std::fill(stamp.begin(), stamp.end(), 0);
+        epoch = 1;
+    }
+    if (stamp.size() < n) {
+        stamp.resize(n, 0);
+        parent.resize(n);
+        size.resize(n);
+    }
+    sets = n;
+}
+
+inline void Dsu::touch(size_t x) noexcept {
+    if (stamp[x] != epoch) {
+        stamp[x] = epoch;
+        parent[x] = static_cast<uint32_t>(x);
+        size[x] = 1;
+    }
+}
+
+inline size_t Dsu::find(size_t x) noexcept {
+    touch(x);
+    size_t root = x;
+    while (parent[root] != root) {
+        root = parent[root];
+    }
+    while (parent[x] != root) {
+        auto next = parent[x];
+        parent[x] = static_cast<uint32_t>(root);
+        x = next;
+    }
+    return root;
+}
+
+inline bool Dsu::unite(size_t a, size_t b) noexcept {
+    a = find(a);
+    b = find(b);
+    if (a == b) {
+        return false;
+    }
+    if (size[a] < size[b]) {
+        std::swap(a, b);
+    }
+    parent[b] = static_cast<uint32_t>(a);
+    size[a] += size[b];
+    --sets;
+    return true;
+}
+
+template <class... Msg>
+string Validator::concat(Msg&&... msg) {
+    std::stringstream ss;
+    (ss << ... << std::forward<Msg>(msg));
+    return std::move(ss).str();
+}
+
+inline std::optional<string> Validator::permutation(std::span<const int> p) {
+    if (p.empty()) {
+        return std::nullopt;
+    }
+    return distinct(p, 1, static_cast<int>(p.size()));
+}
+
+inline std::optional<string> Validator::distinct(std::span<const int> vals, int min, int max) {
+    oi_assert(min <= max);
+    seen.reset(static_cast<size_t>(static_cast<int64_t>(max) - min + 1));
+    for (int x : vals) {
+        if (x < min || x > max) {
+            switch (lang) {
+            case Lang::EN: return concat("Value ", x, " is out of range [", min, ", ", max, "]");
+            case Lang::PL: return concat("Wartosc ", x, " spoza zakresu [", min, ", ", max, "]");
+            }
+        }
+        if (!seen.insert(static_cast<size_t>(static_cast<int64_t>(x) - min))) {
+            switch (lang) {
+            case Lang::EN: return concat("Value ", x, " occurs more than once");
+            case Lang::PL: return concat("Wartosc ", x, " wystepuje wiecej niz raz");
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+inline std::optional<string>
+Validator::distinct_vertices(const Graph& g, std::span<const int> vertices) {
+    seen.reset(static_cast<size_t>(g.n) + 1);
+    for (int v : vertices) {
+        if (v < 1 || v > g.n) {
+            switch (lang) {
+            case Lang::EN: return concat("Vertex ", v, " does not exist");
+            case Lang::PL: return concat("Wierzcholek ", v, " nie istnieje");
+            }
+        }
+        if (!seen.insert(static_cast<size_t>(v))) {
+            switch (lang) {
+            case Lang::EN: return concat("Vertex ", v, " occurs more than once");
+            case Lang::PL: return concat("Wierzcholek ", v, " wystepuje wiecej niz raz");
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+inline std::optional<string> Validator::distinct_edges(const Graph& g, std::span<const int> edges) {
+    seen.reset(static_cast<size_t>(g.m) + 1);
+    for (int e : edges) {
+        if (e < 1 || e > g.m) {
+            switch (lang) {
+            case Lang::EN: return concat("Edge ", e, " does not exist");
+            case Lang::PL: return concat("Krawedz ", e, " nie istnieje");
+            }
+        }
+        if (!seen.insert(static_cast<size_t>(e))) {
+            switch (lang) {
+            case Lang::EN: return concat("Edge ", e, " occurs more than once");
+            case Lang::PL: return concat("Krawedz ", e, " wystepuje wiecej niz raz");
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+inline std::optional<string> Validator::edge_exists(const Graph& g, int from, int to) const {
+    for (int v : g.neighbours(from)) {
+        if (v == to) {
+            return std::nullopt;
+        }
+    }
+    switch (lang) {
+    case Lang::EN: return concat("There is no edge from ", from, " to ", to);
+    case Lang::PL: return concat("Nie ma krawedzi z ", from, " do ", to);
+    }
+    __builtin_unreachable();
+}
+
+inline std::optional<string> Validator::path(const Graph& g, std::span<const int> vertices) {
+    if (auto err = distinct_vertices(g, vertices)) {
+        return err;
+    }
+    // Vertices are distinct, so every adjacency list is scanned at most once: O(n + m)
+    for (size_t i = 1; i < vertices.size(); ++i) {
+        if (auto err = edge_exists(g, vertices[i - 1], vertices[i])) {
+            return err;
+        }
+    }
+    return std::nullopt;
+}
+
+inline std::optional<string> Validator::cycle(const Graph& g, std::span<const int> vertices) {
+    if (vertices.empty() || (!g.directed && vertices.size() < 3)) {
+        switch (lang) {
+        case Lang::EN: return "Cycle is too short";
+        case Lang::PL: return "Cykl jest zbyt krotki";
+        }
+    }
+    if (auto err = path(g, vertices)) {
+        return err;
+    }
+    return edge_exists(g, vertices.back(), vertices.front());
+}
+
+inline std::optional<string> Validator::spanning_tree(const Graph& g, std::span<const int> edges) {
+    if (g.n > 0 && edges.size() != static_cast<size_t>(g.n - 1)) {
+        switch (lang) {
+        case Lang::EN: return concat("Expected ", g.n - 1, " edges, got ", edges.size());
+        case Lang::PL: return concat("Oczekiwano ", g.n - 1, " krawedzi, wczytano ", edges.size());
+        }
+    }
+    if (auto err = distinct_edges(g, edges)) {
+        return err;
+    }
+    dsu.reset(static_cast<size_t>(g.n) + 1);
+    for (int e : edges) {
+        if (auto err = unite_edge(g, e)) {
+            return err;
+        }
+    }
+    // n - 1 edges without a cycle always connect all n vertices
+    return std::nullopt;
+}
+
+inline std::optional<string> Validator::acyclic(const Graph& g) {
+    oi_assert(!g.directed);
+    dsu.reset(static_cast<size_t>(g.n) + 1);
+    for (int e = 1; e <= g.m; ++e) {
+        if (auto err = unite_edge(g, e)) {
+            return err;
+        }
+    }
+    return std::nullopt;
+}
+
+inline std::optional<string> Validator::unite_edge(const Graph& g, int e) {
+    auto a = static_cast<size_t>(g.edge_from[static_cast<size_t>(e - 1)]);
+    auto b = static_cast<size_t>(g.edge_to[static_cast<size_t>(e - 1)]);
+    if (dsu.unite(a, b)) {
+        return std::nullopt;
+    }
+    switch (lang) {
+    case Lang::EN: return concat("Edge ", e, " closes a cycle");
+    case Lang::PL: return concat("Krawedz ", e, " zamyka cykl");
+    }
+    __builtin_unreachable();
+}
+
+inline std::optional<string> Validator::matching(const Graph& g, std::span<const int> edges) {
+    if (auto err = distinct_edges(g, edges)) {
+        return err;
+    }
+    seen.reset(static_cast<size_t>(g.n) + 1);
+    for (int e : edges) {
+        for (int v : {g.edge_from[static_cast<size_t>(e - 1)], g.edge_to[static_cast<size_t>(e - 1)]}) {
+            if (!seen.insert(static_cast<size_t>(v))) {
+                switch (lang) {
+                case Lang::EN: return concat("Vertex ", v, " is matched more than once");
+                case Lang::PL: return concat("Wierzcholek ", v, " jest skojarzony wiecej niz raz");
+                }
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+inline std::optional<string> Validator::connected(const Graph& g) {
+    dsu.reset(static_cast<size_t>(g.n) + 1);
+    for (size_t e = 0; e < static_cast<size_t>(g.m); ++e) {
+        dsu.unite(static_cast<size_t>(g.edge_from[e]), static_cast<size_t>(g.edge_to[e]));
+    }
+    // Vertex 0 does not exist and stays a singleton
+    if (g.n > 0 && dsu.sets_count() > 2) {
+        for (int v = 2; v <= g.n; ++v) {
+            if (dsu.find(static_cast<size_t>(v)) != dsu.find(1)) {
+                switch (lang) {
+                case Lang::EN:
+                    return concat("Graph is not connected: vertex ", v, " is not reachable from vertex 1");
+                case Lang::PL:
+                    return concat("Graf nie jest spojny: wierzcholek ", v, " jest nieosiagalny z wierzcholka 1");
+                }
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+} // namespace cert
+
+namespace detail {
+
+struct GraphScratch {
+    vector<int> count;
+    vector<int> order, tmp;
+    // Indexed by Lang
+    std::array<cert::Validator, 2> validators{cert::Validator{Lang::EN}, cert::Validator{Lang::PL}};
+};
+
+inline GraphScratch& graph_scratch() {
+    thread_local GraphScratch s;
+    return s;
+}
+
+inline void exit_wrong_if(const std::optional<string>& error) {
+    if (error) {
+        inwer_verdict.exit_wrong() << *error;
+    }
+}
+
+} // namespace detail
+
+namespace graph_checks {
+
+inline void no_loops(const Graph& g, Lang lang) {
+    for (size_t e = 0; e < static_cast<size_t>(g.m); ++e) {
+        if (g.edge_from[e] == g.edge_to[e]) {
+            switch (lang) {
+            case Lang::EN: inwer_verdict.exit_wrong() << "Edge " << e + 1 << " is a loop"; break;
+            case Lang::PL: inwer_verdict.exit_wrong() << "Krawedz " << e + 1 << " jest petla"; break;
+            }
+        }
+    }
+}
+
+inline void no_multi_edges(const Graph& g, Lang lang) {
+    auto& s = detail::graph_scratch();
+    auto m = static_cast<size_t>(g.m);
+    auto lo = [&g](int e) {
+        auto a = g.edge_from[static_cast<size_t>(e)];
+        auto b = g.edge_to[static_cast<size_t>(e)];
+        return g.directed ? a : std::min(a, b);
+    };
+    auto hi = [&g](int e) {
+        auto a = g.edge_from[static_cast<size_t>(e)];
+        auto b = g.edge_to[static_cast<size_t>(e)];
+        return g.directed ? b : std::max(a, b);
+    };
+    // Stable counting sort of the edges in from by key into to
+    auto counting_sort = [&s, &g](const vector<int>& from, vector<int>& to, auto key) {
+        s.count.assign(static_cast<size_t>(g.n) + 2, 0);
+        for (int e : from) {
+            ++s.count[static_cast<size_t>(key(e))];
+        }
+        int sum = 0;
+        for (int& c : s.count) {
+            sum += std::exchange(c, sum);
+        }
+        for (int e : from) {
+            to[static_cast<size_t>(s.count[static_cast<size_t>(key(e))]++)] = e;
+        }
+    };
+    // LSD radix sort by (lo, hi); equal edges end up adjacent, in the input order
+    s.tmp.resize(m);
+    s.order.resize(m);
+    for (size_t e = 0; e < m; ++e) {
+        s.tmp[e] = static_cast<int>(e);
+    }
+    counting_sort(s.tmp, s.order, hi);
+    counting_sort(s.order, s.tmp, lo);
+
+    // Report the pair whose later edge comes first in the input, i.e. the first two edges of the
+    // group of equal edges with the smallest second edge
+    int e1 = -1, e2 = g.m;
+    size_t group_begin = 0;
+    for (size_t i = 1; i < m; ++i) {
+        int a = s.tmp[i - 1], b = s.tmp[i];
+        if (lo(a) != lo(b) || hi(a) != hi(b)) {
+            group_begin = i;
+        } else if (i == group_begin + 1 && b < e2) {
+            e1 = a;
+            e2 = b;
+        }
+    }
+    if (e1 != -1) {
+        switch (lang) {
+        case Lang::EN:
+            inwer_verdict.exit_wrong() << "Edges " << e1 + 1 << " and " << e2 + 1 << " connect the same vertices";
+            break;
+        case Lang::PL:
+            inwer_verdict.exit_wrong() << "Krawedzie " << e1 + 1 << " i " << e2 + 1 << " lacza te same wierzcholki";
+            break;
+        }
+    }
+}
+
+inline void connected(const Graph& g, Lang lang) {
+    detail::exit_wrong_if(detail::graph_scratch().validators[static_cast<size_t>(lang)].connected(g));
+}
+
+inline void tree(const Graph& g, Lang lang) {
+    oi_assert(!g.directed);
+    if (g.n > 0 && g.m != g.n - 1) {
+        switch (lang) {
+        case Lang::EN:
+            inwer_verdict.exit_wrong() << "A tree on " << g.n << " vertices has " << g.n - 1 << " edges, not " << g.m;
+            break;
+        case Lang::PL:
+            inwer_verdict.exit_wrong() << "Drzewo na " << g.n << " wierzcholkach ma " << g.n - 1 << " krawedzi, a nie " << g.m;
+            break;
+        }
+    }
+    // With n - 1 edges, a graph is a tree iff it is acyclic
+    detail::exit_wrong_if(detail::graph_scratch().validators[static_cast<size_t>(lang)].acyclic(g));
+}
+
+inline void dag(const Graph& g, Lang lang) {
+    oi_assert(g.directed);
+    // Kahn's algorithm: order is the queue of vertices without remaining incoming arcs
+    auto& s = detail::graph_scratch();
+    s.count.assign(static_cast<size_t>(g.n) + 1, 0);
+    for (int to : g.edge_to) {
+        ++s.count[static_cast<size_t>(to)];
+    }
+    s.order.clear();
+    for (int v = 1; v <= g.n; ++v) {
+        if (s.count[static_cast<size_t>(v)] == 0) {
+            s.order.emplace_back(v);
+        }
+    }
+    for (size_t i = 0; i < s.order.size(); ++i) {
+        for (int u : g.neighbours(s.order[i])) {
+            if (--s.count[static_cast<size_t>(u)] == 0) {
+                s.order.emplace_back(u);
+            }
+        }
+    }
+    if (s.order.size() < static_cast<size_t>(g.n)) {
+        switch (lang) {
+        case Lang::EN: inwer_verdict.exit_wrong() << "Graph has a cycle"; break;
+        case Lang::PL: inwer_verdict.exit_wrong() << "Graf ma cykl"; break;
+        }
+    }
+}
+
+} // namespace graph_checks
+
+// Indexed by SequenceOrder, then by Lang
+constexpr const char* order_violation[][2] = {
+    {"", ""},
+    {" is smaller than the previous one", " jest mniejszy od poprzedniego"},
+    {" is not greater than the previous one", " nie jest wiekszy od poprzedniego"},
+    {" is greater than the previous one", " jest wiekszy od poprzedniego"},
+    {" is not smaller than the previous one", " nie jest mniejszy od poprzedniego"},
+};
+
+template <class T>
+vector<T> read_sequence(Scanner& scanner, size_t n, T min, std::type_identity_t<T> max,
+                        const SequenceOptions& options) {
+    static_assert(std::is_integral_v<T>, "read_sequence() reads integers");
+    oi_assert(min <= max);
+    auto lang = scanner.get_lang();
+    vector<T> res(n);
+
+    bool check_distinct = options.distinct && options.order != SequenceOrder::Increasing &&
+                          options.order != SequenceOrder::Decreasing;
+    // Value x is stamped at x - min. The set is reused between calls, so that reading many short
+    // sequences costs O(n) each, not O(max - min).
+    thread_local cert::EpochSet seen;
+    std::unordered_set<T> seen_hashed;
+    auto range = static_cast<uint64_t>(max) - static_cast<uint64_t>(min);
+    bool bounded = range < std::max<uint64_t>(uint64_t{1} << 20, uint64_t{4} * n);
+    if (check_distinct) {
+        if (bounded) {
+            seen.reset(static_cast<size_t>(range) + 1);
+        } else {
+            seen_hashed.reserve(n);
+        }
+    }
+
+    // With non-negative numbers the running sum only grows, so it is checked after every number.
+    // Otherwise only the total is checked. The sum of n 64-bit numbers fits in 128 bits.
+    __extension__ using int128 = __int128;
+    int128 sum = 0;
+    auto sum_exceeded = [&] { return sum > *options.max_sum; };
+    auto sum_error = [&](size_t count) {
+        switch (lang) {
+        case Lang::EN: scanner.error("Sum of the first ", count, " elements exceeds ", *options.max_sum);
+        case Lang::PL: scanner.error("Suma pierwszych ", count, " elementow przekracza ", *options.max_sum);
+        }
+        __builtin_unreachable();
+    };
+
+    for (size_t i = 0; i < n; ++i) {
+        if (i > 0) {
+            scanner >> ' ';
+        }
+        T x;
+        scanner >> Num{x, min, max};
+        res[i] = x;
+
+        if (i > 0) {
+            T prev = res[i - 1];
+            bool ok = true;
+            switch (options.order) {
+            case SequenceOrder::Any: break;
+            case SequenceOrder::NonDecreasing: ok = prev <= x; break;
+            case SequenceOrder::Increasing: ok = prev < x; break;
+            case SequenceOrder::NonIncreasing: ok = prev >= x; break;
+            case SequenceOrder::Decreasing: ok = prev > x; break;
+            }
+            if (!ok) {
+                scanner.error("Element ", i + 1, order_violation[static_cast<int>(options.order)][static_cast<int>(lang)]);
+            }
+        }
+
+        if (check_distinct) {
+            bool inserted = bounded ? seen.insert(static_cast<size_t>(static_cast<uint64_t>(x) - static_cast<uint64_t>(min)))
+                                    : seen_hashed.insert(x).second;
+            if (!inserted) {
+                switch (lang) {
+                case Lang::EN: scanner.error("Element ", i + 1, " repeats value ", x);
+                case Lang::PL: scanner.error("Element ", i + 1, " powtarza wartosc ", x);
+                }
+            }
+        }
+
+        if (options.max_sum) {
+            sum += x;
+            if (std::cmp_greater_equal(min, 0) && sum_exceeded()) {
+                sum_error(i + 1);
+            }
+        }
+    }
+    if (options.max_sum && sum_exceeded()) {
+        sum_error(n);
+    }
+    return res;
+}
+
+inline HugePages::HugePages(size_t bytes) {
+    if (bytes == 0) {
+        return;
+    }
+    len = (bytes + huge_page_size - 1) / huge_page_size * huge_page_size;
+    // Map one huge page more and trim, so that the memory is aligned to the huge page size
+    auto map_len = len + huge_page_size;
+    void* raw = mmap(nullptr, map_len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) {
+        bug("mmap() failed - ", strerror(errno));
+    }
+    auto raw_addr = reinterpret_cast<uintptr_t>(raw);
+    auto addr = (raw_addr + huge_page_size - 1) / huge_page_size * huge_page_size;
+    if (addr != raw_addr) {
+        (void)munmap(raw, addr - raw_addr);
+    }
+    if (auto tail = raw_addr + map_len - (addr + len); tail > 0) {
+        (void)munmap(reinterpret_cast<void*>(addr + len), tail);
+    }
+    mem = reinterpret_cast<char*>(addr);
+    // Fails if transparent huge pages are not supported, then regular pages are used
+    (void)madvise(mem, len, MADV_HUGEPAGE);
+}
+
+inline HugePages::~HugePages() {
+    if (mem) {
+        (void)munmap(mem, len);
+    }
+}
+
+inline HugePages::HugePages(HugePages&& other) noexcept
+: mem{std::exchange(other.mem, nullptr)}
+, len{std::exchange(other.len, 0)} {}
+
+inline HugePages& HugePages::operator=(HugePages&& other) noexcept {
+    if (this != &other) {
+        if (mem) {
+            (void)munmap(mem, len);
+        }
+        mem = std::exchange(other.mem, nullptr);
+        len = std::exchange(other.len, 0);
+    }
+    return *this;
+}
+
+inline void* HugePageArena::allocate(size_t bytes, size_t alignment) {
+    for (; current_chunk < chunks.size(); ++current_chunk, used = 0) {
+        auto& chunk = chunks[current_chunk];
+        auto beg = (used + alignment - 1) / alignment * alignment;
+        if (beg + bytes <= chunk.size()) {
+            used = beg + bytes;
+            return chunk.data() + beg;
+        }
+    }
+    // Chunks are aligned to the huge page size, so any sane alignment is satisfied at offset 0
+    chunks.emplace_back(std::max(chunk_size, bytes));
+    current_chunk = chunks.size() - 1;
+    used = bytes;
+    return chunks.back().data();
+}
+
+inline void LatencyStats::record(uint64_t ns) noexcept {
+    ++count;
+    total_ns += ns;
+    min_ns = std::min(min_ns, ns);
+    max_ns = std::max(max_ns, ns);
+}
+
+inline double LatencyStats::mean_ns() const noexcept {
+    return count == 0 ? 0 : static_cast<double>(total_ns) / static_cast<double>(count);
+}
+
+inline Writer::Writer(int fd_, size_t buffer_size)
+: fd{fd_}
+, buff{std::make_unique<char[]>(buffer_size)}
+, buff_capacity{buffer_size} {
+    oi_assert(buffer_size >= max_number_len);
+}
+
+inline Writer::Writer(const char* file_path, size_t buffer_size)
+: Writer{
+      [file_path] {
+          int file_fd = open(file_path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+          if (file_fd == -1) {
+              bug("open() failed - ", strerror(errno));
+          }
+          return file_fd;
+      }(),
+      buffer_size
+  } {
+    owns_fd = true;
+}
+
+inline Writer::~Writer() {
+    flush();
+    if (owns_fd) {
+        (void)close(fd);
+    }
+}
+
+inline char* Writer::reserve(size_t len) {
+    if (buff_capacity - buff_size < len) {
+        flush();
+    }
+    return buff.get() + buff_size;
+}
+
+inline Writer& Writer::operator<<(char c) {
+    *reserve(1) = c;
+    ++buff_size;
+    return *this;
+}
+
+inline Writer& Writer::operator<<(std::string_view str) {
+    if (str.size() > buff_capacity) {
+        flush();
+        write_all(str.data(), str.size());
+        return *this;
+    }
+    std::memcpy(reserve(str.size()), str.data(), str.size());
+    buff_size += str.size();
+    return *this;
+}
+
+template <class T> requires std::is_arithmetic_v<T> && (!std::is_same_v<T, bool>)
+Writer& Writer::operator<<(T val) {
+    char* beg = reserve(max_number_len);
+    auto [end, ec] = std::to_chars(beg, beg + max_number_len, val);
+    oi_assert(ec == std::errc{});
+    buff_size += static_cast<size_t>(end - beg);
+    return *this;
+}
+
+inline void Writer::write_all(const char* data, size_t len) {
+    while (len > 0) {
+        auto rc = write(fd, data, len);
+        if (rc == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            bug("write() failed - ", strerror(errno));
+        }
+        data += rc;
+        len -= static_cast<size_t>(rc);
+    }
+}
+
+inline void Writer::write_all(std::span<iovec> iov, off_t* offset) {
+    while (!iov.empty()) {
+        int count = static_cast<int>(std::min<size_t>(iov.size(), IOV_MAX));
+        auto rc = offset ? pwritev(fd, iov.data(), count, *offset) : writev(fd, iov.data(), count);
+        if (rc == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            bug(offset ? "pwritev() failed - " : "writev() failed - ", strerror(errno));
+        }
+        if (offset) {
+            *offset += rc;
+        }
+        // Skip what has been written, the last iovec possibly partially
+        auto written = static_cast<size_t>(rc);
+        while (!iov.empty() && written >= iov.front().iov_len) {
+            written -= iov.front().iov_len;
+            iov = iov.subspan(1);
+        }
+        if (written > 0) {
+            iov.front().iov_base = static_cast<char*>(iov.front().iov_base) + written;
+            iov.front().iov_len -= written;
+        }
+    }
+}
+
+inline char* Writer::Chunk::reserve(size_t len) {
+    if (buff_capacity - buff_size < len) {
+        size_t new_capacity = std::max({buff_capacity * 2, buff_size + len, size_t{4096}});
+        auto new_buff = std::make_unique<char[]>(new_capacity);
+        std::memcpy(new_buff.get(), buff.get(), buff_size);
+        buff = std::move(new_buff);
+        buff_capacity = new_capacity;
+    }
+    return buff.get() + buff_size;
+}
+
+inline Writer::Chunk& Writer::Chunk::operator<<(char c) {
+    *reserve(1) = c;
+    ++buff_size;
+    return *this;
+}
+
+inline Writer::Chunk& Writer::Chunk::operator<<(std::string_view str) {
+    std::memcpy(reserve(str.size()), str.data(), str.size());
+    buff_size += str.size();
+    return *this;
+}
+
+template <class T> requires std::is_arithmetic_v<T> && (!std::is_same_v<T, bool>)
+Writer::Chunk& Writer::Chunk::operator<<(T val) {
+    char* beg = reserve(max_number_len);
+    auto [end, ec] = std::to_chars(beg, beg + max_number_len, val);
+    oi_assert(ec == std::errc{});
+    buff_size += static_cast<size_t>(end - beg);
+    return *this;
+}
+
+template <class Fn>
+void Writer::write_parallel(size_t n, size_t chunk_size, Fn&& fn) {
+    oi_assert(chunk_size > 0);
+    flush();
+    size_t chunks = n / chunk_size + (n % chunk_size != 0);
+    if (chunks == 0) {
+        return;
+    }
+    // pwritev() ignores the offset on O_APPEND files, so they are written like pipes
+    std::optional<off_t> offset;
+    struct stat st;
+    int flags = fcntl(fd, F_GETFL);
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && flags != -1 && !(flags & O_APPEND)) {
+        if (off_t pos = lseek(fd, 0, SEEK_CUR); pos != -1) {
+            offset = pos;
+        }
+    }
+
+    // Chunks are formatted in batches: the next one while the previous one is being written
+    size_t batch = 4 * static_cast<size_t>(available_threads());
+    size_t batches = chunks / batch + (chunks % batch != 0);
+    std::array<std::vector<Chunk>, 2> buffers{std::vector<Chunk>(batch), std::vector<Chunk>(batch)};
+    auto batch_len = [&](size_t b) { return std::min(batch, chunks - b * batch); };
+    auto format_batch = [&](size_t b) {
+        auto& out = buffers[b % 2];
+        parallel_for(batch_len(b), 1, [&](size_t i, size_t /*unused*/) {
+            size_t k = b * batch + i;
+            out[i].buff_size = 0;
+            fn(out[i], k * chunk_size, std::min(n, (k + 1) * chunk_size));
+        });
+    };
+    std::vector<iovec> iov;
+    format_batch(0);
+    for (size_t b = 0; b < batches; ++b) {
+        TaskGroup tg;
+        if (b + 1 < batches) {
+            tg.run([&, b] { format_batch(b + 1); });
+        }
+        iov.clear();
+        for (auto& chunk : std::span{buffers[b % 2]}.first(batch_len(b))) {
+            if (chunk.buff_size > 0) {
+                iov.push_back({.iov_base = chunk.buff.get(), .iov_len = chunk.buff_size});
+            }
+        }
+        write_all(iov, offset ? &*offset : nullptr);
+        tg.wait();
+    }
+    if (offset && lseek(fd, *offset, SEEK_SET) == -1) {
+        bug("lseek() failed - ", strerror(errno));
+    }
+}
+
+inline void Writer::flush() {
+    if (buff_size == 0) {
+        return;
+    }
+    write_all(buff.get(), buff_size);
+    buff_size = 0;
+    awaiting_reply_since = std::chrono::steady_clock::now();
+}
+
+inline void Writer::on_reply() noexcept {
+    if (awaiting_reply_since) {
+        auto elapsed = std::chrono::steady_clock::now() - *awaiting_reply_since;
+        round_trips.record(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()
+        ));
+        awaiting_reply_since = std::nullopt;
+    }
+}
+
+inline bool tune_interactive_fd(int fd, int buffer_size) noexcept {
+    struct stat st;
+    if (fstat(fd, &st)) {
+        return false;
+    }
+    if (S_ISFIFO(st.st_mode)) {
+        return fcntl(fd, F_SETPIPE_SZ, buffer_size) >= buffer_size;
+    }
+    if (S_ISSOCK(st.st_mode)) {
+        return setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &buffer_size, sizeof(buffer_size)) == 0 &&
+            setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &buffer_size, sizeof(buffer_size)) == 0;
+    }
+    return false;
+}
+
+inline Random::Random(uint_fast64_t seed) : generator{seed} {}
+
+template <class T> requires std::is_arithmetic_v<T>
+T Random::operator()(T min, T max) {
+    oi_assert(min <= max);
+    constexpr auto generator_range_len = decltype(generator)::max() - decltype(generator)::min();
+    if constexpr (std::is_floating_point_v<T>) {
+        auto val = generator() - decltype(generator)::min(); // in range [0, generator_range_len]
+        T scaled_val = static_cast<T>(val) / static_cast<T>(generator_range_len); // in range [0, 1]
+        return scaled_val * (max - min) + min;
+    } else if constexpr (std::is_unsigned_v<T>) {
+        auto range_len = static_cast<uint_fast64_t>(max) - static_cast<uint_fast64_t>(min) + 1;
+        if (range_len == 0) { // max range
+            return static_cast<T>(generator());
+        }
+        auto limit = generator_range_len - generator_range_len % range_len;
+        for (;;) {
+            auto val =
+                generator() - decltype(generator)::min(); // in range [0, generator_range_len]
+            // We want val to be in range [0, generator_range_len - generator_range_len % range_len
+            // - 1]
+            // <=> val < generator_range_len - generator_range_len % range_len
+            if (val >= limit) {
+                continue;
+            }
+            return static_cast<T>(val % range_len) + min;
+        }
+    } else {
+        using UT = std::make_unsigned_t<T>;
+        // Shift [min, max] to [umin, umax], where umin >= 0
+        UT umin = static_cast<UT>(min) - static_cast<UT>(std::numeric_limits<T>::min());
+        UT umax = static_cast<UT>(max) - static_cast<UT>(std::numeric_limits<T>::min());
+        UT val = this->operator()<UT>(umin, umax) + static_cast<UT>(std::numeric_limits<T>::min());
+        return static_cast<T>(val);
+    }
+}
+
+template <class Weights>
+Random::Discrete::Discrete(const Weights& weights) {
+    size_t n = std::size(weights);
+    oi_assert(n > 0 && n <= std::numeric_limits<uint32_t>::max());
+    double sum = 0;
+    for (auto w : weights) {
+        oi_assert(std::isfinite(static_cast<double>(w)) && static_cast<double>(w) >= 0, "weight: ", w);
+        sum += static_cast<double>(w);
+    }
+    oi_assert(sum > 0 && std::isfinite(sum));
+
+    // Vose: a column is filled with a small item (scaled probability < 1) topped up by a large one
+    columns.resize(n);
+    vector<double> scaled(n);
+    vector<uint32_t> small, large;
+    size_t i = 0;
+    for (auto w : weights) {
+        scaled[i] = static_cast<double>(w) * static_cast<double>(n) / sum;
+        (scaled[i] < 1 ? small : large).emplace_back(static_cast<uint32_t>(i));
+        ++i;
+    }
+    constexpr double two_to_64 = 18446744073709551616.0;
+    while (!small.empty() && !large.empty()) {
+        auto s = small.back();
+        auto l = large.back();
+        small.pop_back();
+        columns[s] = {.threshold = static_cast<uint64_t>(scaled[s] * two_to_64), .alias = l};
+        scaled[l] -= 1 - scaled[s];
+        if (scaled[l] < 1) {
+            large.pop_back();
+            small.emplace_back(l);
+        }
+    }
+    // What is left has probability 1 up to rounding errors
+    for (auto* rest : {&small, &large}) {
+        for (auto x : *rest) {
+            columns[x] = {.threshold = std::numeric_limits<uint64_t>::max(), .alias = x};
+        }
+    }
+}
+
+inline size_t Random::operator()(const Discrete& dist) {
+    // The high half of r * n is the column and the low half is a coin uniform in [0, 2^64) for it
+    __extension__ using uint128 = unsigned __int128;
+    auto prod = static_cast<uint128>(generator()) * dist.columns.size();
+    auto column = static_cast<size_t>(prod >> 64);
+    const auto& col = dist.columns[column];
+    return static_cast<uint64_t>(prod) < col.threshold ? column : col.alias;
+}
+
+template <class T> requires std::is_integral_v<T>
+void Random::fill(std::span<T> out, const Discrete& dist) {
+    oi_assert(dist.size() - 1 <= static_cast<uint64_t>(std::numeric_limits<T>::max()));
+    for (auto& x : out) {
+        x = static_cast<T>(this->operator()(dist));
+    }
+}
+
+template <class T, class Alphabet>
+void Random::sequence(std::span<T> out, const Alphabet& alphabet) {
+    uint64_t k = std::size(alphabet);
+    oi_assert(k > 0);
+    auto symbol = [&alphabet](uint64_t i) { return static_cast<T>(alphabet[static_cast<size_t>(i)]); };
+    size_t n = out.size();
+    size_t i = 0;
+    if (k == 1) {
+        std::fill(out.begin(), out.end(), symbol(0));
+    } else if ((k & (k - 1)) == 0) {
+        auto bits = std::countr_zero(k);
+        int per_draw = 64 / bits;
+        while (i < n) {
+            uint64_t r = generator();
+            for (int j = 0; j < per_draw && i < n; ++j, r >>= bits) {
+                out[i++] = symbol(r & (k - 1));
+            }
+        }
+    } else {
+        // A draw r gives the m digits of r * k^m / 2^64 in base k, unless the remainder is below
+        // threshold = 2^64 mod k^m
+        __extension__ using uint128 = unsigned __int128;
+        int m = 1;
+        uint64_t power = k;
+        while (power <= (uint64_t{1} << 56) / k) {
+            power *= k;
+            ++m;
+        }
+        uint64_t threshold = (0 - power) % power;
+        std::array<uint64_t, 56> digits;
+        while (i < n) {
+            uint64_t x;
+            do {
+                x = generator();
+                for (int j = 0; j < m; ++j) {
+                    auto prod = static_cast<uint128>(x) * k;
+                    digits[static_cast<size_t>(j)] = static_cast<uint64_t>(prod >> 64);
+                    x = static_cast<uint64_t>(prod);
+                }
+            } while (x < threshold);
+            for (int j = 0; j < m && i < n; ++j) {
+                out[i++] = symbol(digits[static_cast<size_t>(j)]);
+            }
+        }
+    }
+}
+
+template <class RandomAccessIterator>
+void Random::shuffle(RandomAccessIterator begin, RandomAccessIterator end) {
+    for (auto i = end - begin; i > 1;) {
+        --i;
+        std::swap(begin[i], begin[this->operator()<decltype(i)>(0, i)]);
+    }
+}
+
+namespace detail {
+
+// Bijective mixing of the bits (the finalizer of splitmix64)
+constexpr uint64_t mix64(uint64_t x) noexcept {
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+    return x ^ (x >> 31);
+}
+
+// Fast generator for substreams (Steele, Lea and Flood's SplitMix64), about 1 ns per number
+struct SplitMix64 {
+    using result_type = uint64_t;
+    uint64_t state;
+
+    static constexpr uint64_t min() noexcept { return 0; }
+    static constexpr uint64_t max() noexcept { return std::numeric_limits<uint64_t>::max(); }
+
+    uint64_t operator()() noexcept { return mix64(state += 0x9e3779b97f4a7c15); }
+};
+
+// Returns a number uniform in [0, n), n > 0, by Lemire's multiply-shift method with rejection,
+// which is unbiased and divides only for the rare draws that may need to be rejected
+template <class Generator>
+uint64_t uniform_below(Generator& gen, uint64_t n) {
+    static_assert(Generator::min() == 0 && Generator::max() == std::numeric_limits<uint64_t>::max());
+    __extension__ using uint128 = unsigned __int128;
+    auto prod = static_cast<uint128>(gen()) * n;
+    if (static_cast<uint64_t>(prod) < n) {
+        auto threshold = (0 - n) % n;
+        while (static_cast<uint64_t>(prod) < threshold) {
+            prod = static_cast<uint128>(gen()) * n;
+        }
+    }
+    return static_cast<uint64_t>(prod >> 64);
+}
+
+template <class RandomAccessIterator, class Generator>
+void fisher_yates(RandomAccessIterator begin, size_t n, Generator& gen) {
+    for (size_t i = n; i > 1; --i) {
+        std::iter_swap(begin + static_cast<ptrdiff_t>(i - 1), begin + static_cast<ptrdiff_t>(uniform_below(gen, i)));
+    }
+}
+
+} // namespace detail
+
+template <class RandomAccessIterator>
+void Random::parallel_shuffle(RandomAccessIterator begin, RandomAccessIterator end) {
+    using T = typename std::iterator_traits<RandomAccessIterator>::value_type;
+    auto n = static_cast<size_t>(end - begin);
+    auto seed = generator();
+    auto substream = [seed](uint64_t stream) { return detail::SplitMix64{detail::mix64(seed + detail::mix64(stream))}; };
+    // Everything below depends only on n, not on the number of threads
+    constexpr size_t block_size = size_t{1} << 16;
+    constexpr size_t max_blocks = 1024, max_chunks = 256;
+    size_t blocks = std::min(max_blocks, (n + block_size - 1) / block_size);
+    if (blocks <= 1) {
+        auto gen = substream(0);
+        detail::fisher_yates(begin, n, gen);
+        return;
+    }
+    size_t chunks = std::min(max_chunks, (n + block_size - 1) / block_size);
+    size_t chunk_size = (n + chunks - 1) / chunks;
+
+    // Chunk c draws the blocks of its elements from substream 1 + c, twice: to count them and to
+    // scatter them. offset[c * blocks + b] is where the next element of chunk c goes in block b.
+    auto for_each_draw = [&](size_t from, size_t to, auto&& fn) {
+        auto gen = substream(1 + from / chunk_size);
+        for (size_t i = from; i < to; ++i) {
+            fn(i, static_cast<size_t>(detail::uniform_below(gen, blocks)));
+        }
+    };
+    vector<size_t> offset(chunks * blocks, 0);
+    parallel_for(n, chunk_size, [&](size_t from, size_t to) {
+        size_t* chunk_offset = offset.data() + from / chunk_size * blocks;
+        for_each_draw(from, to, [chunk_offset](size_t /*unused*/, size_t b) { ++chunk_offset[b]; });
+    });
+    vector<size_t> block_begin(blocks + 1);
+    size_t sum = 0;
+    for (size_t b = 0; b < blocks; ++b) {
+        block_begin[b] = sum;
+        for (size_t c = 0; c < chunks; ++c) {
+            sum += std::exchange(offset[c * blocks + b], sum);
+        }
+    }
+    block_begin[blocks] = n;
+
+    vector<T> tmp(n);
+    parallel_for(n, chunk_size, [&](size_t from, size_t to) {
+        size_t* chunk_offset = offset.data() + from / chunk_size * blocks;
+        for_each_draw(from, to, [&](size_t i, size_t b) {
+            tmp[chunk_offset[b]++] = std::move(begin[static_cast<ptrdiff_t>(i)]);
+        });
+    });
+    // Block b is shuffled with substream 1 + chunks + b
+    parallel_for(blocks, 1, [&](size_t b, size_t /*unused*/) {
+        auto gen = substream(1 + chunks + b);
+        detail::fisher_yates(tmp.begin() + static_cast<ptrdiff_t>(block_begin[b]), block_begin[b + 1] - block_begin[b], gen);
+        std::move(
+            tmp.begin() + static_cast<ptrdiff_t>(block_begin[b]),
+            tmp.begin() + static_cast<ptrdiff_t>(block_begin[b + 1]),
+            begin + static_cast<ptrdiff_t>(block_begin[b])
+        );
+    });
+}
+
+} // namespace oi
+
+namespace oi::detail {
+
+inline std::vector<void (*)()>& get_checker_test_fns() {
+    static std::vector<void (*)()> test_fns;
+    return test_fns;
+}
+
+} // namespace oi::detail
+
+int the_only_real_true_main(int, char**);
+
+namespace oi::detail {
+
+inline void checker_test(
+    const string& test_name,
+    TestInput test_input,
+    TestOutput test_output,
+    UserOutput user_output,
+    CheckerOutput checker_output
+) {
+    auto terminate_with_error = [test_name](auto&&... msg) {
+        ::oi::detail::exit_with_error_msg(
+            5, "Checker test ", test_name, " failed: ", std::forward<decltype(msg)>(msg)...
+        );
+    };
+
+    auto create_fd = [&terminate_with_error] {
+        // Using tmpfile() to be POSIX compliant, so that it works on MacOS.
+        auto* f = tmpfile();
+        if (!f) {
+            terminate_with_error("tmpfile() - ", strerror(errno));
+        }
+        int fd = dup(fileno(f));
+        if (fclose(f)) {
+            terminate_with_error("flose() - ", strerror(errno));
+        }
+        return fd;
+    };
+
+    auto create_fd_with_contents = [&terminate_with_error, &create_fd](const string& contents) {
+        auto fd = create_fd();
+        if (pwrite(fd, contents.data(), contents.size(), 0) !=
+            static_cast<ssize_t>(contents.size()))
+        {
+            terminate_with_error("pwrite() - ", strerror(errno));
+        }
+        return fd;
+    };
+
+    int in_fd = create_fd_with_contents(test_input.str);
+    int out_fd = create_fd_with_contents(test_output.str);
+    int user_out_fd = create_fd_with_contents(user_output.str);
+
+    int checker_out_fd = create_fd();
+
+    int pid = fork();
+    if (pid == -1) {
+        terminate_with_error("fork() - ", strerror(errno));
+    }
+    if (pid == 0) {
+        (void)freopen("/dev/null", "r", stdin);
+        if (dup2(checker_out_fd, STDOUT_FILENO) != STDOUT_FILENO) {
+            terminate_with_error("dup2() - ", strerror(errno));
+        }
+
+        char prog_name[] = "";
+        auto test_input_path = string{"/dev/fd/"} + std::to_string(in_fd);
+        auto test_output_path = string{"/dev/fd/"} + std::to_string(out_fd);
+        auto user_output_path = string{"/dev/fd/"} + std::to_string(user_out_fd);
+
+        char* argv[] = {
+            prog_name,
+            test_input_path.data(),
+            user_output_path.data(),
+            test_output_path.data(),
+            nullptr,
+        };
+        exit(the_only_real_true_main(4, argv));
+    }
+    (void)close(user_out_fd);
+    (void)close(out_fd);
+    (void)close(in_fd);
+
+    int status;
+    if (waitpid(pid, &status, 0) != pid) {
+        terminate_with_error("waitpid() - ", strerror(errno));
+    }
+
+    std::string captured_output;
+    std::array<char, 4096> buff;
+    for (off_t offset = 0;;) {
+        auto rc = pread(checker_out_fd, buff.data(), buff.size(), offset);
+        if (rc > 0) {
+            offset += rc;
+            captured_output.append(buff.data(), static_cast<size_t>(rc));
+            continue;
+        }
+        if (rc == 0) {
+            break;
+        }
+        terminate_with_error("pread() - ", strerror(errno));
+    }
+    (void)close(checker_out_fd);
+
+    if (!WIFEXITED(status)) {
+        terminate_with_error("checker program crashed with output:\n", captured_output);
+    }
+
+    int exit_code = WEXITSTATUS(status);
+    if (exit_code != 0) {
+        terminate_with_error(
+            "checker program exited with ", exit_code, " with output:\n", captured_output
+        );
+    }
+    if (captured_output != checker_output.str) {
+        terminate_with_error(
+            "checker program exited with 0 with output:\n",
+            captured_output,
+            "\nexpected it to exit with 0 and output:\n",
+            checker_output.str
+        );
+    }
+}
+
+inline void checker_test(const string &test_name, const string& data) {
+    constexpr std::string_view test_in_str = "@test_in\n";
+    constexpr std::string_view test_out_str = "@test_out\n";
+    constexpr std::string_view user_str = "@user\n";
+    constexpr std::string_view checker_str = "@checker\n";
+    auto find_beg_of = [&data](std::string_view delim, size_t start_pos) -> size_t {
+        auto delim_pos = data.find(delim, start_pos);
+        if (delim_pos == string::npos) {
+            oi::bug("Could not find ", delim, " in the test string");
+        }
+        return delim_pos + delim.size();
+    };
+
+    auto test_in_beg = find_beg_of(test_in_str, 0);
+    auto test_out_beg = find_beg_of(test_out_str, test_in_beg);
+    auto user_beg = find_beg_of(user_str, test_out_beg);
+    auto checker_beg = find_beg_of(checker_str, user_beg);
+    checker_test(
+        test_name,
+        TestInput{string{
+            data.begin() + static_cast<ssize_t>(test_in_beg),
+            data.begin() + static_cast<ssize_t>(test_out_beg - test_out_str.size())
+        }},
+        TestOutput{string{
+            data.begin() + static_cast<ssize_t>(test_out_beg),
+            data.begin() + static_cast<ssize_t>(user_beg - user_str.size())
+        }},
+        UserOutput{string{
+            data.begin() + static_cast<ssize_t>(user_beg),
+            data.begin() + static_cast<ssize_t>(checker_beg - checker_str.size())
+        }},
+        CheckerOutput{data.substr(checker_beg)}
+    );
+}
+
+inline bool we_are_running_on_sio2() {
+    auto user_str = getenv("USER");
+    return user_str != nullptr && std::string_view{user_str} == "oioioiworker";
+}
+
+} // namespace oi::detail
+
+#define main(...)                                                                              \
+    the_only_real_true_main(__VA_ARGS__);                                                      \
+    /* Before checker_test(), the_only_real_true_main() is declared as: */                     \
+    /* int the_only_real_true_main(int, char**); */                                            \
+    /* it overloads the_only_real_true_main() in case __VA_ARGS__ is empty, */                 \
+    /* hence the workaround */                                                                 \
+    int only_for_type_deduction_main(__VA_ARGS__);                                             \
+                                                                                               \
+    int main(int argc, char** argv) {                                                          \
+        auto filename = std::string_view{__FILE__};                                            \
+        /* Remove the extension */                                                             \
+        while (!filename.empty() && filename.back() != '.') {                                  \
+            filename.remove_suffix(1);                                                         \
+        }                                                                                      \
+        if (filename.ends_with("chk.")) {                                                      \
+            ::oi::detail::change_error_ostream_to_cout();                                      \
+        }                                                                                      \
+                                                                                               \
+        if (!::oi::detail::we_are_running_on_sio2() &&                                         \
+            !oi::detail::get_checker_test_fns().empty())                                       \
+        {                                                                                      \
+            std::cerr << "Running " << oi::detail::get_checker_test_fns().size()               \
+                      << " checker tests...\n";                                                \
+            for (auto checker_test_fn : ::oi::detail::get_checker_test_fns()) {                \
+                checker_test_fn();                                                             \
+            }                                                                                  \
+            std::cerr << "All tests passed.\n";                                                \
+        }                                                                                      \
+                                                                                               \
+        return [&](auto main_func) {                                                           \
+            /* We need main_func in the branches to be template-dependent, hence the lambda */ \
+            if constexpr (std::is_convertible_v<decltype(main_func), int (*)()>) {             \
+                return main_func();                                                            \
+            } else {                                                                           \
+                return main_func(argc, argv);                                                  \
+            }                                                                                  \
+        }(static_cast<decltype(&only_for_type_deduction_main)>(&the_only_real_true_main));     \
+    }                                                                                          \
+    int the_only_real_true_main(__VA_ARGS__)
+
+///////////////// FORBIDDING MACROS /////////////////
+#define cin                                                         \
+    cin;                                                            \
+    static_assert(false, "Don't use cin, use oi::Scanner instead"); \
+    ::std::cin
+#define cout cout; static_assert(false, "Don't use cout, use oi::checker_verdict or oi::inwer_verdict instead or oi::bug()"); ::std::cout
+#define fstream                                                         \
+    fstream;                                                            \
+    static_assert(false, "Don't use fstream, use oi::Scanner instead"); \
+    ::std::fstream
+#define ifstream                                                         \
+    ifstream;                                                            \
+    static_assert(false, "Don't use ifstream, use oi::Scanner instead"); \
+    ::std::ifstream
+#define scanf(...) static_assert(false, "Don't use scanf(), use oi::Scanner instead")
+#define fopen(...) static_assert(false, "Don't use fopen(), use oi::Scanner instead")
+#define printf(...) static_assert(false, "Don't use printf(), use oi::checker_verdict or oi::inwer_verdict or oi::bug() instead")
+#define puts(...) \
+    static_assert(false, "Don't use puts(), use oi::checker_verdict or oi::inwer_verdict instead")
+#define exit(...) static_assert(false, "Don't use exit(), use oi::checker_verdict or oi::inwer_verdict instead")
+#define _exit(...) \
+    static_assert(false, "Don't use _exit(), use oi::checker_verdict or oi::inwer_verdict instead")
+#define _Exit(...) \
+    static_assert(false, "Don't use _Exit(), use oi::checker_verdict or oi::inwer_verdict instead")
+#define rand(...) static_assert(false, "Don't use rand(), use oi::Random")::std::rand
+#define mt19337 \
+    mt19337;    \
+    static_assert(false, "Don't use mt19337, use oi::Random")::std::mt19337
+#define mt19337_64 \
+    mt19337_64;    \
+    static_assert(false, "Don't use mt19337_64, use oi::Random")::std::mt19337_64
+#undef assert
+#define assert(...) static_assert(false, "Don't use assert, use oi_assert()")
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////// oi.h tests ////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifdef OI_H_TESTS
+
+#include <array>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <list>
+#include <map>
+#include <numeric>
+#include <random>
+#include <ranges>
+#include <set>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <type_traits>
+#include <unordered_set>
+#include <unistd.h>
+#include <variant>
+#include <vector>
+
+std::vector<void (*)()>& get_test_fns() {
+    static std::vector<void (*)()> test_fns;
+    return test_fns;
+}
+
+struct Exits { int code; string msg; };
+
+struct Crashes {};
 
 #define TEST(test_name_, test_in_, ...) DO_TEST(__COUNTER__, test_name_, test_in_, __VA_ARGS__)
 #define DO_TEST(counter, test_name_, test_in_, ...)                                                \
@@ -1412,2639 +4960,4059 @@ struct Crashes {};
     }                                                                                              \
     void CONCAT(test_body, counter)()
 
-TEST("checker_verdict.exit_ok()", "", Exits{0, "OK\n\n100\n"}) {
+TEST("checker_verdict.exit_ok()", "", Exits{0, "OK\n\n100\n"}) {
+    oi::checker_verdict.exit_ok();
+}
+
+TEST("checker_verdict.exit_ok_with_score(score)", "", Exits{0, "OK\n\n42\n"}) {
+    oi::checker_verdict.exit_ok_with_score(42);
+}
+
+TEST("checker_verdict.exit_ok_with_score(score, msg)", "", Exits{0, "OK\na3\n42\n"}) {
+    oi::checker_verdict.exit_ok_with_score(42, "a", 3);
+}
+
+TEST("checker_verdict.exit_ok_with_score(101)", "", Crashes{}) {
+    oi::checker_verdict.exit_ok_with_score(101);
+}
+
+TEST("checker_verdict.exit_ok_with_score(101, msg)", "", Crashes{}) {
+    oi::checker_verdict.exit_ok_with_score(101, "a", 3);
+}
+
+TEST("checker_verdict.exit_ok_with_score(-1)", "", Crashes{}) {
+    oi::checker_verdict.exit_ok_with_score(-1);
+}
+
+TEST("checker_verdict.exit_ok_with_score(-1, msg)", "", Crashes{}) {
+    oi::checker_verdict.exit_ok_with_score(-1, "a", 3);
+}
+
+TEST("checker_verdict.exit_wrong()", "", Exits{0, "WRONG\n\n0\n"}) {
+    oi::checker_verdict.exit_wrong();
+}
+
+TEST("checker_verdict.exit_wrong(args)", "", Exits{0, "WRONG\n1abc42\n0\n"}) {
+    oi::checker_verdict.exit_wrong(1, "abc", 42);
+}
+
+TEST("checker_verdict.set_partial_score() + ok()", "", Exits{0, "OK\n\n100\n"}) {
+    oi::checker_verdict.set_partial_score(42, "x y z ", 8);
+    oi::checker_verdict.exit_ok();
+}
+
+TEST("checker_verdict.set_partial_score(-1)", "", Crashes{}) {
+    oi::checker_verdict.set_partial_score(-1, "x y z ", 8);
+}
+
+TEST("checker_verdict.set_partial_score(101)", "", Crashes{}) {
+    oi::checker_verdict.set_partial_score(101, "x y z ", 8);
+}
+
+TEST("checker_verdict.set_partial_score(100)", "", Crashes{}) {
+    oi::checker_verdict.set_partial_score(100, "x y z ", 8);
+}
+
+TEST("checker_verdict.set_partial_score() + exit_wrong()", "", Exits{0, "OK\nx y z 8; 1abc42\n42\n"}) {
+    oi::checker_verdict.set_partial_score(42, "x y z ", 8);
+    oi::checker_verdict.exit_wrong(1, "abc", 42);
+}
+
+TEST("checker_verdict.set_partial_score() x2 + exit_wrong()", "", Exits{0, "OK\na b c 88; 1abc42\n23\n"}) {
+    oi::checker_verdict.set_partial_score(42, "x y z ", 8);
+    oi::checker_verdict.set_partial_score(23, "a b c", ' ', 88);
+    oi::checker_verdict.exit_wrong(1, "abc", 42);
+}
+
+TEST("inwer_verdict.exit_ok()", "", Exits{0, ""}) {
+    oi::inwer_verdict.exit_ok();
+}
+
+TEST("inwer_verdict.exit_ok()", "", Exits{0, "a b c\n"}) {
+    oi::inwer_verdict.exit_ok() << 'a' << " b c";
+}
+
+TEST("inwer_verdict.exit_wrong()", "", Exits{1, ""}) {
+    oi::inwer_verdict.exit_wrong();
+}
+
+TEST("inwer_verdict.exit_wrong()", "", Exits{1, "a b c\n"}) {
+    oi::inwer_verdict.exit_wrong() << 'a' << " b c";
+}
+
+TEST("bug(msg)", "", Exits{2, "BUG: 2 + 2 = 4\n"}) {
+    oi::bug("2 + 2 = ", 4);
+}
+
+TEST("oi_assert(true)", "", Exits{0, ""}) {
+    oi_assert(true);
+    oi::inwer_verdict.exit_ok();
+}
+
+TEST("oi_assert(true, msg)", "", Exits{0, ""}) {
+    oi_assert(true, "2 + 2 = ", 4);
+    oi::inwer_verdict.exit_ok();
+}
+
+TEST("oi_assert(false)", "", Exits{3, "oi.h:5058: void test_body22(): Assertion `2 + 2 != 4` failed.\n"}) {
+    oi_assert(2 + 2 != 4);
+}
+
+TEST("oi_assert(false, msg)", "", Exits{3, "oi.h:5062: void test_body23(): Assertion `2 + 2 != 4` failed: 2 + 2 = 4\n"}) {
+    oi_assert(2 + 2 != 4, "2 + 2 = ", 4);
+}
+
+TEST("Scanner(UserOutput, EN)::error()", "", Exits{0, "WRONG\nLine 1, position 1: 42abc\n0\n"}) {
+    oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN}.error(42, "abc");
+}
+
+TEST("Scanner(UserOutput, PL)::error()", "", Exits{0, "WRONG\nWiersz 1, pozycja 1: 42abc\n0\n"}) {
+    oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL}.error(42, "abc");
+}
+
+TEST("Scanner(TestInput, EN)::error()", "", Exits{1, "Line 1, position 1: 42abc\n"}) {
+    oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN}.error(42, "abc");
+}
+
+TEST("Scanner(TestInput, PL)::error()", "", Exits{1, "Wiersz 1, pozycja 1: 42abc\n"}) {
+    oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL}.error(42, "abc");
+}
+
+TEST("Scanner(Lax, EN)::error()", "", Exits{4, "Lax scanner: Line 1, position 1: 42abc\n"}) {
+    oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN}.error(42, "abc");
+}
+
+TEST("Scanner(Lax, PL)::error()", "", Exits{4, "Lax scanner: Wiersz 1, pozycja 1: 42abc\n"}) {
+    oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL}.error(42, "abc");
+}
+
+TEST("Scanner(UserOutput, EN)::operator>>(const char&)", "", Exits{0, "WRONG\nLine 1, position 1: Read EOF, expected 'x'\n0\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    s >> 'x';
+}
+
+TEST("Scanner(UserOutput, PL)::operator>>(const char&)", "", Exits{0, "WRONG\nWiersz 1, pozycja 1: Wczytano EOF, oczekiwano 'x'\n0\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
+    s >> 'x';
+}
+
+TEST("Scanner(TestInput, EN)::operator>>(const char&)", "", Exits{1, "Line 1, position 1: Read EOF, expected 'x'\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    s >> 'x';
+}
+
+TEST("Scanner(TestInput, PL)::operator>>(const char&)", "", Exits{1, "Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano 'x'\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    s >> 'x';
+}
+
+TEST("Scanner(Lax, EN)::operator>>(const char&)", "", Exits{4, "Lax scanner: Line 1, position 1: Read EOF, expected 'x'\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
+    s >> 'x';
+}
+
+TEST("Scanner(Lax, PL)::operator>>(const char&)", "", Exits{4, "Lax scanner: Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano 'x'\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
+    s >> 'x';
+}
+
+TEST("Scanner(UserOutput, EN)::operator>>(const char&)", "x", Exits{0, "WRONG\nLine 1, position 2: Read EOF, expected 'x'\n0\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    s >> 'x';
+    s >> 'x';
+}
+
+TEST("Scanner(UserOutput, PL)::operator>>(const char&)", "x", Exits{0, "WRONG\nWiersz 1, pozycja 2: Wczytano EOF, oczekiwano 'x'\n0\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
+    s >> 'x';
+    s >> 'x';
+}
+
+TEST("Scanner(TestInput, EN)::operator>>(const char&)", "x", Exits{1, "Line 1, position 2: Read EOF, expected 'x'\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    s >> 'x';
+    s >> 'x';
+}
+
+TEST("Scanner(TestInput, PL)::operator>>(const char&)", "x", Exits{1, "Wiersz 1, pozycja 2: Wczytano EOF, oczekiwano 'x'\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    s >> 'x';
+    s >> 'x';
+}
+
+TEST("Scanner(Lax, EN)::operator>>(const char&)", "x", Exits{4, "Lax scanner: Line 1, position 2: Read EOF, expected 'x'\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
+    s >> 'x';
+    s >> 'x';
+}
+
+TEST("Scanner(Lax, PL)::operator>>(const char&)", "x", Exits{4, "Lax scanner: Wiersz 1, pozycja 2: Wczytano EOF, oczekiwano 'x'\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
+    s >> 'x';
+    s >> 'x';
+}
+
+TEST("Scanner(UserOutput, EN)::operator>>(const char&)", "a", Exits{0, "WRONG\nLine 1, position 1: Read 'a', expected 'b'\n0\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    s >> 'b';
+}
+
+TEST("Scanner(UserOutput, PL)::operator>>(const char&)", "a", Exits{0, "WRONG\nWiersz 1, pozycja 1: Wczytano 'a', oczekiwano 'b'\n0\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
+    s >> 'b';
+}
+
+TEST("Scanner(TestInput, EN)::operator>>(const char&)", "a", Exits{1, "Line 1, position 1: Read 'a', expected 'b'\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    s >> 'b';
+}
+
+TEST("Scanner(TestInput, PL)::operator>>(const char&)", "a", Exits{1, "Wiersz 1, pozycja 1: Wczytano 'a', oczekiwano 'b'\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    s >> 'b';
+}
+
+TEST("Scanner(Lax, EN)::operator>>(const char&)", "a", Exits{4, "Lax scanner: Line 1, position 1: Read 'a', expected 'b'\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
+    s >> 'b';
+}
+
+TEST("Scanner(Lax, PL)::operator>>(const char&)", "a", Exits{4, "Lax scanner: Wiersz 1, pozycja 1: Wczytano 'a', oczekiwano 'b'\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
+    s >> 'b';
+}
+
+TEST("Scanner(UserOutput, EN)::operator>>(const char&) ignores white space", " a", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    s >> 'a';
+    oi::checker_verdict.exit_ok();
+}
+
+TEST("Scanner(UserOutput, PL)::operator>>(const char&) ignores white space", " a", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
+    s >> 'a';
+    oi::checker_verdict.exit_ok();
+}
+
+TEST("Scanner(TestInput, EN)::operator>>(const char&) does not ignore white space", " a", Exits{1, "Line 1, position 1: Read ' ', expected 'a'\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    s >> 'a';
+}
+
+TEST("Scanner(TestInput, PL)::operator>>(const char&) does not ignore white space", " a", Exits{1, "Wiersz 1, pozycja 1: Wczytano ' ', oczekiwano 'a'\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    s >> 'a';
+}
+
+TEST("Scanner(Lax, EN)::operator>>(const char&) ignores white space", " a", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
+    s >> 'a';
+    oi::checker_verdict.exit_ok();
+}
+
+TEST("Scanner(Lax, PL)::operator>>(const char&) ignores white space", " a", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
+    s >> 'a';
+    oi::checker_verdict.exit_ok();
+}
+
+TEST("Scanner(UserOutput)::operator>>(eof)", "", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    s >> oi::eof >> oi::eof >> oi::eof;
+    oi::checker_verdict.exit_ok();
+}
+
+TEST("Scanner(TestInput)::operator>>(eof)", "", Exits{0, ""}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    s >> oi::eof >> oi::eof >> oi::eof;
+    oi::inwer_verdict.exit_ok();
+}
+
+TEST("Scanner(Lax)::operator>>(eof)", "", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
+    s >> oi::eof >> oi::eof >> oi::eof;
+    oi::checker_verdict.exit_ok();
+}
+
+TEST("Scanner(UserOutput)::operator>>(eof)", "  \n  ", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    s >> oi::eof;
+    oi::checker_verdict.exit_ok();
+}
+
+TEST("Scanner(TestInput, EN)::operator>>(eof)", " ", Exits{1, "Line 1, position 1: Read ' ', expected EOF\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    s >> oi::eof;
+}
+
+TEST("Scanner(TestInput, PL)::operator>>(eof)", " ", Exits{1, "Wiersz 1, pozycja 1: Wczytano ' ', oczekiwano EOF\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    s >> oi::eof;
+}
+
+TEST("Scanner(TestInput, EN)::operator>>(eof)", "\n", Exits{1, "Line 1, position 1: Read '\\n', expected EOF\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    s >> oi::eof;
+}
+
+TEST("Scanner(TestInput, PL)::operator>>(eof)", "\n", Exits{1, "Wiersz 1, pozycja 1: Wczytano '\\n', oczekiwano EOF\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    s >> oi::eof;
+}
+
+TEST("Scanner(Lax)::operator>>(eof)", "  \n  ", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
+    s >> oi::eof;
+    oi::checker_verdict.exit_ok();
+}
+
+TEST("Scanner(UserOutput, EN)::operator>>(eof)", "  \n  a", Exits{0, "WRONG\nLine 2, position 3: Read 'a', expected EOF\n0\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    s >> oi::eof;
+}
+
+TEST("Scanner(UserOutput, PL)::operator>>(eof)", "  \n  a", Exits{0, "WRONG\nWiersz 2, pozycja 3: Wczytano 'a', oczekiwano EOF\n0\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
+    s >> oi::eof;
+}
+
+TEST("Scanner(TestInput, EN)::operator>>(eof)", "a", Exits{1, "Line 1, position 1: Read 'a', expected EOF\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    s >> oi::eof;
+}
+
+TEST("Scanner(TestInput, PL)::operator>>(eof)", "a", Exits{1, "Wiersz 1, pozycja 1: Wczytano 'a', oczekiwano EOF\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    s >> oi::eof;
+}
+
+TEST("Scanner(Lax, EN)::operator>>(eof)", "  \n  a", Exits{4, "Lax scanner: Line 2, position 3: Read 'a', expected EOF\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
+    s >> oi::eof;
+}
+
+TEST("Scanner(Lax, PL)::operator>>(eof)", "  \n  a", Exits{4, "Lax scanner: Wiersz 2, pozycja 3: Wczytano 'a', oczekiwano EOF\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
+    s >> oi::eof;
+}
+
+TEST("Scanner(UserOutput)::operator>>(whitespace) and eof", "", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    s >> ' ' >> '\t' >> '\n' >> oi::nl >> ' ' >> '\t' >> '\n' >> oi::nl;
+    s >> oi::eof;
+    oi::checker_verdict.exit_ok();
+}
+
+TEST("Scanner(UserOutput)::operator>>(whitespace) and eof", "  \n  ", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    s >> ' ' >> '\t' >> '\n' >> oi::nl >> ' ' >> '\t' >> '\n' >> oi::nl;
+    s >> oi::eof;
+    oi::checker_verdict.exit_ok();
+}
+
+TEST("Scanner(TestInput, EN)::operator>>(whitespace) and eof", "", Exits{1, "Line 1, position 1: Read EOF, expected ' '\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    s >> ' ';
+    s >> oi::eof;
+}
+
+TEST("Scanner(TestInput, PL)::operator>>(whitespace) and eof", "", Exits{1, "Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano ' '\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    s >> ' ';
+    s >> oi::eof;
+}
+
+TEST("Scanner(TestInput, EN)::operator>>(whitespace) and eof", "", Exits{1, "Line 1, position 1: Read EOF, expected '\\n'\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    s >> '\n';
+    s >> oi::eof;
+}
+
+TEST("Scanner(TestInput, PL)::operator>>(whitespace) and eof", "", Exits{1, "Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano '\\n'\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    s >> '\n';
+    s >> oi::eof;
+}
+
+TEST("Scanner(TestInput, EN)::operator>>(whitespace) and eof", "", Exits{1, "Line 1, position 1: Read EOF, expected '\\t'\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    s >> '\t';
+    s >> oi::eof;
+}
+
+TEST("Scanner(TestInput, PL)::operator>>(whitespace) and eof", "", Exits{1, "Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano '\\t'\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    s >> '\t';
+    s >> oi::eof;
+}
+
+TEST("Scanner(TestInput, EN)::operator>>(whitespace) and eof", "", Exits{1, "Line 1, position 1: Read EOF, expected '\\n'\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    s >> oi::nl;
+    s >> oi::eof;
+}
+
+TEST("Scanner(TestInput, PL)::operator>>(whitespace) and eof", "", Exits{1, "Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano '\\n'\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    s >> oi::nl;
+    s >> oi::eof;
+}
+
+TEST("Scanner(Lax)::operator>>(whitespace) and eof", "", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
+    s >> ' ' >> '\t' >> '\n' >> oi::nl >> ' ' >> '\t' >> '\n' >> oi::nl;
+    s >> oi::eof;
+    oi::checker_verdict.exit_ok();
+}
+
+TEST("Scanner(Lax)::operator>>(whitespace) and eof", "  \n  ", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
+    s >> ' ' >> '\t' >> '\n' >> oi::nl >> ' ' >> '\t' >> '\n' >> oi::nl;
+    s >> oi::eof;
+    oi::checker_verdict.exit_ok();
+}
+
+TEST("Scanner(UserOutput)::operator>>(whitespace) and destructor", "", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    s >> ' ' >> '\t' >> '\n' >> oi::nl >> ' ' >> '\t' >> '\n' >> oi::nl;
+    oi::checker_verdict.exit_ok();
+}
+
+TEST("Scanner(UserOutput)::operator>>(whitespace) and destructor", "  \n  ", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    s >> ' ' >> '\t' >> '\n' >> oi::nl >> ' ' >> '\t' >> '\n' >> oi::nl;
+    oi::checker_verdict.exit_ok();
+}
+
+TEST("Scanner(TestInput, EN)::operator>>(whitespace) and destructor", "", Exits{1, "Line 1, position 1: Read EOF, expected ' '\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    s >> ' ';
+}
+
+TEST("Scanner(TestInput, PL)::operator>>(whitespace) and destructor", "", Exits{1, "Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano ' '\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    s >> ' ';
+}
+
+TEST("Scanner(TestInput, EN)::operator>>(whitespace) and destructor", "", Exits{1, "Line 1, position 1: Read EOF, expected '\\n'\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    s >> '\n';
+}
+
+TEST("Scanner(TestInput, PL)::operator>>(whitespace) and destructor", "", Exits{1, "Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano '\\n'\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    s >> '\n';
+}
+
+TEST("Scanner(TestInput, EN)::operator>>(whitespace) and destructor", "", Exits{1, "Line 1, position 1: Read EOF, expected '\\t'\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    s >> '\t';
+}
+
+TEST("Scanner(TestInput, PL)::operator>>(whitespace) and destructor", "", Exits{1, "Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano '\\t'\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    s >> '\t';
+}
+
+TEST("Scanner(TestInput, EN)::operator>>(whitespace) and destructor", "", Exits{1, "Line 1, position 1: Read EOF, expected '\\n'\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    s >> oi::nl;
+}
+
+TEST("Scanner(TestInput, PL)::operator>>(whitespace) and destructor", "", Exits{1, "Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano '\\n'\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    s >> oi::nl;
+}
+
+TEST("Scanner(Lax)::operator>>(whitespace) and destructor do nothing", "", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
+    s >> ' ' >> '\t' >> '\n' >> oi::nl >> ' ' >> '\t' >> '\n' >> oi::nl;
     oi::checker_verdict.exit_ok();
 }
 
-TEST("checker_verdict.exit_ok_with_score(score)", "", Exits{0, "OK\n\n42\n"}) {
-    oi::checker_verdict.exit_ok_with_score(42);
+TEST("Scanner(Lax, EN)::operator>>(whitespace) and destructor do nothing", "", Exits{4, "Lax scanner: Line 1, position 1: Read EOF, expected ' '\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
+    s >> ' ' >> '\t' >> '\n' >> oi::nl >> ' ' >> '\t' >> '\n' >> oi::nl >> 'a';
 }
 
-TEST("checker_verdict.exit_ok_with_score(score, msg)", "", Exits{0, "OK\na3\n42\n"}) {
-    oi::checker_verdict.exit_ok_with_score(42, "a", 3);
+TEST("Scanner(Lax, PL)::operator>>(whitespace) and destructor do nothing", "", Exits{4, "Lax scanner: Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano ' '\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
+    s >> ' ' >> '\t' >> '\n' >> oi::nl >> ' ' >> '\t' >> '\n' >> oi::nl >> 'a';
 }
 
-TEST("checker_verdict.exit_ok_with_score(101)", "", Crashes{}) {
-    oi::checker_verdict.exit_ok_with_score(101);
+TEST("Scanner(Lax)::operator>>(whitespace) and destructor do nothing", "  \n  ", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
+    s >> ' ' >> '\t' >> '\n' >> oi::nl >> ' ' >> '\t' >> '\n' >> oi::nl;
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("checker_verdict.exit_ok_with_score(101, msg)", "", Crashes{}) {
-    oi::checker_verdict.exit_ok_with_score(101, "a", 3);
+TEST("Scanner(Lax, EN)::operator>>(whitespace) and destructor do nothing", "  \n   ", Exits{4, "Lax scanner: Line 2, position 4: Read EOF, expected '\\n'\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
+    s >> ' ' >> '\t' >> '\n' >> oi::nl >> ' ' >> '\t' >> '\n' >> oi::nl >> 'a';
 }
 
-TEST("checker_verdict.exit_ok_with_score(-1)", "", Crashes{}) {
-    oi::checker_verdict.exit_ok_with_score(-1);
+TEST("Scanner(Lax, PL)::operator>>(whitespace) and destructor do nothing", "  \n   ", Exits{4, "Lax scanner: Wiersz 2, pozycja 4: Wczytano EOF, oczekiwano '\\n'\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
+    s >> ' ' >> '\t' >> '\n' >> oi::nl >> ' ' >> '\t' >> '\n' >> oi::nl >> 'a';
 }
 
-TEST("checker_verdict.exit_ok_with_score(-1, msg)", "", Crashes{}) {
-    oi::checker_verdict.exit_ok_with_score(-1, "a", 3);
+TEST("Scanner(UserOutput)::operator>>(whitespace) whitespace kind does not matter", " \t\fx", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    s >> '\t' >> ' ' >> ' ' >> 'x';
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("checker_verdict.exit_wrong()", "", Exits{0, "WRONG\n\n0\n"}) {
-    oi::checker_verdict.exit_wrong();
+TEST("Scanner(TestInput, EN)::operator>>(whitespace) whitespace kind does matter", " ", Exits{1, "Line 1, position 1: Read ' ', expected '\\t'\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    s >> '\t';
 }
 
-TEST("checker_verdict.exit_wrong(args)", "", Exits{0, "WRONG\n1abc42\n0\n"}) {
-    oi::checker_verdict.exit_wrong(1, "abc", 42);
+TEST("Scanner(TestInput, PL)::operator>>(whitespace) whitespace kind does matter", " ", Exits{1, "Wiersz 1, pozycja 1: Wczytano ' ', oczekiwano '\\t'\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    s >> '\t';
 }
 
-TEST("checker_verdict.set_partial_score() + ok()", "", Exits{0, "OK\n\n100\n"}) {
-    oi::checker_verdict.set_partial_score(42, "x y z ", 8);
+TEST("Scanner(TestInput, EN)::operator>>(whitespace) whitespace kind does matter", "\t", Exits{1, "Line 1, position 1: Read '\\t', expected ' '\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    s >> ' ';
+}
+
+TEST("Scanner(TestInput, PL)::operator>>(whitespace) whitespace kind does matter", "\t", Exits{1, "Wiersz 1, pozycja 1: Wczytano '\\t', oczekiwano ' '\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    s >> ' ';
+}
+
+TEST("Scanner(Lax)::operator>>(whitespace) whitespace kind does not matter", " \t\fx", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
+    s >> '\t' >> ' ' >> ' ' >> 'x';
     oi::checker_verdict.exit_ok();
 }
 
-TEST("checker_verdict.set_partial_score(-1)", "", Crashes{}) {
-    oi::checker_verdict.set_partial_score(-1, "x y z ", 8);
+TEST("Scanner(UserOutput, EN)::operator>>(whitespace) whitespace number matters", "  x\n  x", Exits{0, "WRONG\nLine 2, position 3: Read 'x', expected ' '\n0\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    s >> ' ' >> ' ' >> 'x' >> oi::nl;
+    s >> ' ' >> ' ' >> ' ' >> 'x';
 }
 
-TEST("checker_verdict.set_partial_score(101)", "", Crashes{}) {
-    oi::checker_verdict.set_partial_score(101, "x y z ", 8);
+TEST("Scanner(UserOutput, PL)::operator>>(whitespace) whitespace number matters", "  x\n  x", Exits{0, "WRONG\nWiersz 2, pozycja 3: Wczytano 'x', oczekiwano ' '\n0\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
+    s >> ' ' >> ' ' >> 'x' >> oi::nl;
+    s >> ' ' >> ' ' >> ' ' >> 'x';
 }
 
-TEST("checker_verdict.set_partial_score(100)", "", Crashes{}) {
-    oi::checker_verdict.set_partial_score(100, "x y z ", 8);
+TEST("Scanner(TestInput, EN)::operator>>(whitespace) whitespace number matters - too little", " ", Exits{1, "Line 1, position 2: Read EOF, expected ' '\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    s >> ' ' >> ' ';
 }
 
-TEST("checker_verdict.set_partial_score() + exit_wrong()", "", Exits{0, "OK\nx y z 8; 1abc42\n42\n"}) {
-    oi::checker_verdict.set_partial_score(42, "x y z ", 8);
-    oi::checker_verdict.exit_wrong(1, "abc", 42);
+TEST("Scanner(TestInput, PL)::operator>>(whitespace) whitespace number matters - too little", " ", Exits{1, "Wiersz 1, pozycja 2: Wczytano EOF, oczekiwano ' '\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    s >> ' ' >> ' ';
 }
 
-TEST("checker_verdict.set_partial_score() x2 + exit_wrong()", "", Exits{0, "OK\na b c 88; 1abc42\n23\n"}) {
-    oi::checker_verdict.set_partial_score(42, "x y z ", 8);
-    oi::checker_verdict.set_partial_score(23, "a b c", ' ', 88);
-    oi::checker_verdict.exit_wrong(1, "abc", 42);
+TEST("Scanner(TestInput, EN)::operator>>(whitespace) whitespace number matters - too much", "  a", Exits{1, "Line 1, position 2: Read ' ', expected 'a'\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    s >> ' ' >> 'a';
 }
 
-TEST("inwer_verdict.exit_ok()", "", Exits{0, ""}) {
-    oi::inwer_verdict.exit_ok();
+TEST("Scanner(TestInput, PL)::operator>>(whitespace) whitespace number matters - too much", "  a", Exits{1, "Wiersz 1, pozycja 2: Wczytano ' ', oczekiwano 'a'\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    s >> ' ' >> 'a';
 }
 
-TEST("inwer_verdict.exit_ok()", "", Exits{0, "a b c\n"}) {
-    oi::inwer_verdict.exit_ok() << 'a' << " b c";
+TEST("Scanner(Lax, EN)::operator>>(whitespace) whitespace number matters", "  x\n  x", Exits{4, "Lax scanner: Line 2, position 3: Read 'x', expected ' '\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
+    s >> ' ' >> ' ' >> 'x' >> oi::nl;
+    s >> ' ' >> ' ' >> ' ' >> 'x';
 }
 
-TEST("inwer_verdict.exit_wrong()", "", Exits{1, ""}) {
-    oi::inwer_verdict.exit_wrong();
+TEST("Scanner(Lax, PL)::operator>>(whitespace) whitespace number matters", "  x\n  x", Exits{4, "Lax scanner: Wiersz 2, pozycja 3: Wczytano 'x', oczekiwano ' '\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
+    s >> ' ' >> ' ' >> 'x' >> oi::nl;
+    s >> ' ' >> ' ' >> ' ' >> 'x';
 }
 
-TEST("inwer_verdict.exit_wrong()", "", Exits{1, "a b c\n"}) {
-    oi::inwer_verdict.exit_wrong() << 'a' << " b c";
+TEST("Scanner(UserOutput, EN)::operator>>(nl)", "", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    s >> oi::nl;
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("bug(msg)", "", Exits{2, "BUG: 2 + 2 = 4\n"}) {
-    oi::bug("2 + 2 = ", 4);
+TEST("Scanner(UserOutput, PL)::operator>>(nl)", "", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
+    s >> oi::nl;
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("oi_assert(true)", "", Exits{0, ""}) {
-    oi_assert(true);
-    oi::inwer_verdict.exit_ok();
+TEST("Scanner(TestInput, EN)::operator>>(nl)", "", Exits{1, "Line 1, position 1: Read EOF, expected '\\n'\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    s >> oi::nl;
 }
 
-TEST("oi_assert(true, msg)", "", Exits{0, ""}) {
-    oi_assert(true, "2 + 2 = ", 4);
-    oi::inwer_verdict.exit_ok();
+TEST("Scanner(TestInput, PL)::operator>>(nl)", "", Exits{1, "Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano '\\n'\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    s >> oi::nl;
 }
 
-TEST("oi_assert(false)", "", Exits{3, "oi.h:1510: void test_body22(): Assertion `2 + 2 != 4` failed.\n"}) {
-    oi_assert(2 + 2 != 4);
+TEST("Scanner(Lax, EN)::operator>>(nl)", "", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
+    s >> oi::nl;
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("oi_assert(false, msg)", "", Exits{3, "oi.h:1514: void test_body23(): Assertion `2 + 2 != 4` failed: 2 + 2 = 4\n"}) {
-    oi_assert(2 + 2 != 4, "2 + 2 = ", 4);
+TEST("Scanner(Lax, PL)::operator>>(nl)", "", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
+    s >> oi::nl;
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput, EN)::error()", "", Exits{0, "WRONG\nLine 1, position 1: 42abc\n0\n"}) {
-    oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN}.error(42, "abc");
+TEST("Scanner(Lax, EN)::operator>>(nl)", "", Exits{4, "Lax scanner: Line 1, position 1: Read EOF, expected '\\n'\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
+    s >> oi::nl >> 'x';
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput, PL)::error()", "", Exits{0, "WRONG\nWiersz 1, pozycja 1: 42abc\n0\n"}) {
-    oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL}.error(42, "abc");
+TEST("Scanner(Lax, PL)::operator>>(nl)", "", Exits{4, "Lax scanner: Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano '\\n'\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
+    s >> oi::nl >> 'x';
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput, EN)::error()", "", Exits{1, "Line 1, position 1: 42abc\n"}) {
-    oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN}.error(42, "abc");
+TEST("Scanner(UserOutput)::operator>>(nl)", "\n", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    s >> oi::nl;
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput, PL)::error()", "", Exits{1, "Wiersz 1, pozycja 1: 42abc\n"}) {
-    oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL}.error(42, "abc");
+TEST("Scanner(TestInput)::operator>>(nl)", "\n", Exits{0, ""}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    s >> oi::nl;
+    oi::inwer_verdict.exit_ok();
 }
 
-TEST("Scanner(Lax, EN)::error()", "", Exits{4, "Lax scanner: Line 1, position 1: 42abc\n"}) {
-    oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN}.error(42, "abc");
+TEST("Scanner(Lax)::operator>>(nl)", "\n", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
+    s >> oi::nl;
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(Lax, PL)::error()", "", Exits{4, "Lax scanner: Wiersz 1, pozycja 1: 42abc\n"}) {
-    oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL}.error(42, "abc");
+TEST("Scanner(UserOutput)::operator>>(nl)", "   \n", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    s >> oi::nl;
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput, EN)::operator>>(const char&)", "", Exits{0, "WRONG\nLine 1, position 1: Read EOF, expected 'x'\n0\n"}) {
+TEST("Scanner(TestInput, EN)::operator>>(nl)", "   \n", Exits{1, "Line 1, position 1: Read ' ', expected '\\n'\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    s >> oi::nl;
+}
+
+TEST("Scanner(TestInput, PL)::operator>>(nl)", "   \n", Exits{1, "Wiersz 1, pozycja 1: Wczytano ' ', oczekiwano '\\n'\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    s >> oi::nl;
+}
+
+TEST("Scanner(Lax)::operator>>(nl)", "   \n", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
+    s >> oi::nl;
+    oi::checker_verdict.exit_ok();
+}
+
+TEST("Scanner(UserOutput, EN)::operator>>(nl)", "   a", Exits{0, "WRONG\nLine 1, position 4: Read 'a', expected EOF\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    s >> 'x';
+    s >> oi::nl;
 }
 
-TEST("Scanner(UserOutput, PL)::operator>>(const char&)", "", Exits{0, "WRONG\nWiersz 1, pozycja 1: Wczytano EOF, oczekiwano 'x'\n0\n"}) {
+TEST("Scanner(UserOutput, PL)::operator>>(nl)", "   a", Exits{0, "WRONG\nWiersz 1, pozycja 4: Wczytano 'a', oczekiwano EOF\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    s >> 'x';
+    s >> oi::nl;
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(const char&)", "", Exits{1, "Line 1, position 1: Read EOF, expected 'x'\n"}) {
+TEST("Scanner(TestInput, EN)::operator>>(nl)", "a", Exits{1, "Line 1, position 1: Read 'a', expected '\\n'\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    s >> 'x';
+    s >> oi::nl;
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(const char&)", "", Exits{1, "Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano 'x'\n"}) {
+TEST("Scanner(TestInput, PL)::operator>>(nl)", "a", Exits{1, "Wiersz 1, pozycja 1: Wczytano 'a', oczekiwano '\\n'\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    s >> 'x';
+    s >> oi::nl;
 }
 
-TEST("Scanner(Lax, EN)::operator>>(const char&)", "", Exits{4, "Lax scanner: Line 1, position 1: Read EOF, expected 'x'\n"}) {
+TEST("Scanner(Lax, EN)::operator>>(nl)", "   a", Exits{0, "OK\n\n100\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    s >> 'x';
+    s >> oi::nl;
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(Lax, PL)::operator>>(const char&)", "", Exits{4, "Lax scanner: Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano 'x'\n"}) {
+TEST("Scanner(Lax, PL)::operator>>(nl)", "   a", Exits{0, "OK\n\n100\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    s >> 'x';
+    s >> oi::nl;
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput, EN)::operator>>(const char&)", "x", Exits{0, "WRONG\nLine 1, position 2: Read EOF, expected 'x'\n0\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    s >> 'x';
-    s >> 'x';
+TEST("Scanner(Lax, EN)::operator>>(nl)", "   a", Exits{4, "Lax scanner: Line 1, position 4: Read 'a', expected '\\n'\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
+    s >> oi::nl >> 'b';
 }
 
-TEST("Scanner(UserOutput, PL)::operator>>(const char&)", "x", Exits{0, "WRONG\nWiersz 1, pozycja 2: Wczytano EOF, oczekiwano 'x'\n0\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    s >> 'x';
-    s >> 'x';
+TEST("Scanner(Lax, PL)::operator>>(nl)", "   a", Exits{4, "Lax scanner: Wiersz 1, pozycja 4: Wczytano 'a', oczekiwano '\\n'\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
+    s >> oi::nl >> 'b';
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(const char&)", "x", Exits{1, "Line 1, position 2: Read EOF, expected 'x'\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    s >> 'x';
-    s >> 'x';
+TEST("Scanner(UserOutput)::operator>>(ignore_ws) ignoring before EOF is no-op", "", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    s >> oi::ignore_ws;
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(const char&)", "x", Exits{1, "Wiersz 1, pozycja 2: Wczytano EOF, oczekiwano 'x'\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    s >> 'x';
-    s >> 'x';
+TEST("Scanner(TestInput)::operator>>(ignore_ws) ignoring before EOF is no-op", "", Exits{0, ""}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    s >> oi::ignore_ws;
+    oi::inwer_verdict.exit_ok();
 }
 
-TEST("Scanner(Lax, EN)::operator>>(const char&)", "x", Exits{4, "Lax scanner: Line 1, position 2: Read EOF, expected 'x'\n"}) {
+TEST("Scanner(Lax)::operator>>(ignore_ws) ignoring before EOF is no-op", "", Exits{0, "OK\n\n100\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    s >> 'x';
-    s >> 'x';
-}
-
-TEST("Scanner(Lax, PL)::operator>>(const char&)", "x", Exits{4, "Lax scanner: Wiersz 1, pozycja 2: Wczytano EOF, oczekiwano 'x'\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    s >> 'x';
-    s >> 'x';
+    s >> oi::ignore_ws;
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput, EN)::operator>>(const char&)", "a", Exits{0, "WRONG\nLine 1, position 1: Read 'a', expected 'b'\n0\n"}) {
+TEST("Scanner(UserOutput, EN)::operator>>(ignore_ws) does not ignore newline", "  \na", Exits{0, "WRONG\nLine 1, position 3: Read '\\n', expected 'a'\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    s >> 'b';
+    s >> oi::ignore_ws >> 'a';
 }
 
-TEST("Scanner(UserOutput, PL)::operator>>(const char&)", "a", Exits{0, "WRONG\nWiersz 1, pozycja 1: Wczytano 'a', oczekiwano 'b'\n0\n"}) {
+TEST("Scanner(UserOutput, PL)::operator>>(ignore_ws) does not ignore newline", "  \na", Exits{0, "WRONG\nWiersz 1, pozycja 3: Wczytano '\\n', oczekiwano 'a'\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    s >> 'b';
+    s >> oi::ignore_ws >> 'a';
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(const char&)", "a", Exits{1, "Line 1, position 1: Read 'a', expected 'b'\n"}) {
+TEST("Scanner(TestInput, EN)::operator>>(ignore_ws) does not ignore newline", "  \na", Exits{1, "Line 1, position 3: Read '\\n', expected 'a'\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    s >> 'b';
+    s >> oi::ignore_ws >> 'a';
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(const char&)", "a", Exits{1, "Wiersz 1, pozycja 1: Wczytano 'a', oczekiwano 'b'\n"}) {
+TEST("Scanner(TestInput, PL)::operator>>(ignore_ws) does not ignore newline", "  \na", Exits{1, "Wiersz 1, pozycja 3: Wczytano '\\n', oczekiwano 'a'\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    s >> 'b';
+    s >> oi::ignore_ws >> 'a';
 }
 
-TEST("Scanner(Lax, EN)::operator>>(const char&)", "a", Exits{4, "Lax scanner: Line 1, position 1: Read 'a', expected 'b'\n"}) {
+TEST("Scanner(Lax, EN)::operator>>(ignore_ws) does not ignore newline", "  \na", Exits{4, "Lax scanner: Line 1, position 3: Read '\\n', expected 'a'\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    s >> 'b';
+    s >> oi::ignore_ws >> 'a';
 }
 
-TEST("Scanner(Lax, PL)::operator>>(const char&)", "a", Exits{4, "Lax scanner: Wiersz 1, pozycja 1: Wczytano 'a', oczekiwano 'b'\n"}) {
+TEST("Scanner(Lax, PL)::operator>>(ignore_ws) does not ignore newline", "  \na", Exits{4, "Lax scanner: Wiersz 1, pozycja 3: Wczytano '\\n', oczekiwano 'a'\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    s >> 'b';
+    s >> oi::ignore_ws >> 'a';
 }
 
-TEST("Scanner(UserOutput, EN)::operator>>(const char&) ignores white space", " a", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(UserOutput)::operator>>(ignore_ws) ignoring works", "   aa", Exits{0, "OK\n\n100\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    s >> 'a';
+    s >> oi::ignore_ws >> 'a' >> oi::ignore_ws >> 'a';
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput, PL)::operator>>(const char&) ignores white space", " a", Exits{0, "OK\n\n100\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    s >> 'a';
+TEST("Scanner(TestInput)::operator>>(ignore_ws) ignoring works", "   aa", Exits{0, ""}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    s >> oi::ignore_ws >> 'a' >> oi::ignore_ws >> 'a';
+    oi::inwer_verdict.exit_ok();
+}
+
+TEST("Scanner(Lax)::operator>>(ignore_ws) ignoring works", "   aa", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
+    s >> oi::ignore_ws >> 'a' >> oi::ignore_ws >> 'a';
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(const char&) does not ignore white space", " a", Exits{1, "Line 1, position 1: Read ' ', expected 'a'\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    s >> 'a';
+TEST("Scanner(UserOutput)::operator>>(Line)", "", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    string x;
+    s >> oi::Line{x, 10};
+    if (x != "") { std::terminate(); }
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(const char&) does not ignore white space", " a", Exits{1, "Wiersz 1, pozycja 1: Wczytano ' ', oczekiwano 'a'\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    s >> 'a';
+TEST("Scanner(TestInput)::operator>>(Line)", "", Exits{0, ""}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    string x;
+    s >> oi::Line{x, 10};
+    if (x != "") { std::terminate(); }
+    oi::inwer_verdict.exit_ok();
 }
 
-TEST("Scanner(Lax, EN)::operator>>(const char&) ignores white space", " a", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(Lax)::operator>>(Line)", "", Exits{0, "OK\n\n100\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    s >> 'a';
+    string x;
+    s >> oi::Line{x, 10};
+    if (x != "") { std::terminate(); }
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(Lax, PL)::operator>>(const char&) ignores white space", " a", Exits{0, "OK\n\n100\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    s >> 'a';
+TEST("Scanner(UserOutput)::operator>>(Line)", "\n", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    string x;
+    s >> oi::Line{x, 10} >> '\n';
+    if (x != "") { std::terminate(); }
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput)::operator>>(eof)", "", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(TestInput)::operator>>(Line)", "\n", Exits{0, ""}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    string x;
+    s >> oi::Line{x, 10} >> '\n';
+    if (x != "") { std::terminate(); }
+    oi::inwer_verdict.exit_ok();
+}
+
+TEST("Scanner(Lax)::operator>>(Line)", "\n", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
+    string x;
+    s >> oi::Line{x, 10} >> '\n';
+    if (x != "") { std::terminate(); }
+    oi::checker_verdict.exit_ok();
+}
+
+TEST("Scanner(UserOutput)::operator>>(Line)", " a b c ", Exits{0, "OK\n\n100\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    s >> oi::eof >> oi::eof >> oi::eof;
+    string x;
+    s >> oi::Line{x, 10};
+    if (x != " a b c ") { std::terminate(); }
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput)::operator>>(eof)", "", Exits{0, ""}) {
+TEST("Scanner(TestInput)::operator>>(Line)", " a b c ", Exits{0, ""}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    s >> oi::eof >> oi::eof >> oi::eof;
+    string x;
+    s >> oi::Line{x, 10};
+    if (x != " a b c ") { std::terminate(); }
     oi::inwer_verdict.exit_ok();
 }
 
-TEST("Scanner(Lax)::operator>>(eof)", "", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(Lax)::operator>>(Line)", " a b c ", Exits{0, "OK\n\n100\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    s >> oi::eof >> oi::eof >> oi::eof;
+    string x;
+    s >> oi::Line{x, 10};
+    if (x != " a b c ") { std::terminate(); }
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput)::operator>>(eof)", "  \n  ", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(UserOutput)::operator>>(Line)", " a b c \n", Exits{0, "OK\n\n100\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    s >> oi::eof;
+    string x;
+    s >> oi::Line{x, 10} >> '\n';
+    if (x != " a b c ") { std::terminate(); }
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(eof)", " ", Exits{1, "Line 1, position 1: Read ' ', expected EOF\n"}) {
+TEST("Scanner(TestInput)::operator>>(Line)", " a b c \n", Exits{0, ""}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    s >> oi::eof;
+    string x;
+    s >> oi::Line{x, 10} >> '\n';
+    if (x != " a b c ") { std::terminate(); }
+    oi::inwer_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(eof)", " ", Exits{1, "Wiersz 1, pozycja 1: Wczytano ' ', oczekiwano EOF\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    s >> oi::eof;
+TEST("Scanner(Lax)::operator>>(Line)", " a b c \n", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
+    string x;
+    s >> oi::Line{x, 10} >> '\n';
+    if (x != " a b c ") { std::terminate(); }
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(eof)", "\n", Exits{1, "Line 1, position 1: Read '\\n', expected EOF\n"}) {
+TEST("Scanner(UserOutput, EN)::operator>>(Str)", "", Exits{0, "WRONG\nLine 1, position 1: Read EOF, expected a string\n0\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    string x;
+    s >> oi::Str{x, 10};
+}
+
+TEST("Scanner(UserOutput, PL)::operator>>(Str)", "", Exits{0, "WRONG\nWiersz 1, pozycja 1: Wczytano EOF, oczekiwano napisu\n0\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
+    string x;
+    s >> oi::Str{x, 10};
+}
+
+TEST("Scanner(TestInput, EN)::operator>>(Str)", "", Exits{1, "Line 1, position 1: Read EOF, expected a string\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    s >> oi::eof;
+    string x;
+    s >> oi::Str{x, 10};
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(eof)", "\n", Exits{1, "Wiersz 1, pozycja 1: Wczytano '\\n', oczekiwano EOF\n"}) {
+TEST("Scanner(TestInput, PL)::operator>>(Str)", "", Exits{1, "Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano napisu\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    s >> oi::eof;
+    string x;
+    s >> oi::Str{x, 10};
 }
 
-TEST("Scanner(Lax)::operator>>(eof)", "  \n  ", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(Lax, EN)::operator>>(Str)", "", Exits{4, "Lax scanner: Line 1, position 1: Read EOF, expected a string\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    s >> oi::eof;
-    oi::checker_verdict.exit_ok();
+    string x;
+    s >> oi::Str{x, 10};
 }
 
-TEST("Scanner(UserOutput, EN)::operator>>(eof)", "  \n  a", Exits{0, "WRONG\nLine 2, position 3: Read 'a', expected EOF\n0\n"}) {
+TEST("Scanner(Lax, PL)::operator>>(Str)", "", Exits{4, "Lax scanner: Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano napisu\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
+    string x;
+    s >> oi::Str{x, 10};
+}
+
+TEST("Scanner(UserOutput, EN)::operator>>(Str)", " ", Exits{0, "WRONG\nLine 1, position 2: Read EOF, expected a string\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    s >> oi::eof;
+    string x;
+    s >> oi::Str{x, 10};
 }
 
-TEST("Scanner(UserOutput, PL)::operator>>(eof)", "  \n  a", Exits{0, "WRONG\nWiersz 2, pozycja 3: Wczytano 'a', oczekiwano EOF\n0\n"}) {
+TEST("Scanner(UserOutput, PL)::operator>>(Str)", " ", Exits{0, "WRONG\nWiersz 1, pozycja 2: Wczytano EOF, oczekiwano napisu\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    s >> oi::eof;
+    string x;
+    s >> oi::Str{x, 10};
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(eof)", "a", Exits{1, "Line 1, position 1: Read 'a', expected EOF\n"}) {
+TEST("Scanner(TestInput, EN)::operator>>(Str)", " ", Exits{1, "Line 1, position 1: Read ' ', expected a string\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    s >> oi::eof;
+    string x;
+    s >> oi::Str{x, 10};
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(eof)", "a", Exits{1, "Wiersz 1, pozycja 1: Wczytano 'a', oczekiwano EOF\n"}) {
+TEST("Scanner(TestInput, PL)::operator>>(Str)", " ", Exits{1, "Wiersz 1, pozycja 1: Wczytano ' ', oczekiwano napisu\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    s >> oi::eof;
+    string x;
+    s >> oi::Str{x, 10};
 }
 
-TEST("Scanner(Lax, EN)::operator>>(eof)", "  \n  a", Exits{4, "Lax scanner: Line 2, position 3: Read 'a', expected EOF\n"}) {
+TEST("Scanner(Lax, EN)::operator>>(Str)", " ", Exits{4, "Lax scanner: Line 1, position 2: Read EOF, expected a string\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    s >> oi::eof;
+    string x;
+    s >> oi::Str{x, 10};
 }
 
-TEST("Scanner(Lax, PL)::operator>>(eof)", "  \n  a", Exits{4, "Lax scanner: Wiersz 2, pozycja 3: Wczytano 'a', oczekiwano EOF\n"}) {
+TEST("Scanner(Lax, PL)::operator>>(Str)", " ", Exits{4, "Lax scanner: Wiersz 1, pozycja 2: Wczytano EOF, oczekiwano napisu\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    s >> oi::eof;
+    string x;
+    s >> oi::Str{x, 10};
 }
 
-TEST("Scanner(UserOutput)::operator>>(whitespace) and eof", "", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(UserOutput)::operator>>(Str)", "abc", Exits{0, "OK\n\n100\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    s >> ' ' >> '\t' >> '\n' >> oi::nl >> ' ' >> '\t' >> '\n' >> oi::nl;
-    s >> oi::eof;
+    string x;
+    s >> oi::Str{x, 10};
+    if (x != "abc") { std::terminate(); }
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput)::operator>>(whitespace) and eof", "  \n  ", Exits{0, "OK\n\n100\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    s >> ' ' >> '\t' >> '\n' >> oi::nl >> ' ' >> '\t' >> '\n' >> oi::nl;
-    s >> oi::eof;
-    oi::checker_verdict.exit_ok();
+TEST("Scanner(TestInput)::operator>>(Str)", "abc", Exits{0, ""}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    string x;
+    s >> oi::Str{x, 10};
+    if (x != "abc") { std::terminate(); }
+    oi::inwer_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(whitespace) and eof", "", Exits{1, "Line 1, position 1: Read EOF, expected ' '\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    s >> ' ';
-    s >> oi::eof;
+TEST("Scanner(Lax)::operator>>(Str)", "abc", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
+    string x;
+    s >> oi::Str{x, 10};
+    if (x != "abc") { std::terminate(); }
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(whitespace) and eof", "", Exits{1, "Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano ' '\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    s >> ' ';
-    s >> oi::eof;
+TEST("Scanner(UserOutput)::operator>>(Str)", "abc d", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    string x;
+    s >> oi::Str{x, 10} >> ' ' >> 'd';
+    if (x != "abc") { std::terminate(); }
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(whitespace) and eof", "", Exits{1, "Line 1, position 1: Read EOF, expected '\\n'\n"}) {
+TEST("Scanner(TestInput)::operator>>(Str)", "abc d", Exits{0, ""}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    s >> '\n';
-    s >> oi::eof;
+    string x;
+    s >> oi::Str{x, 10} >> ' ' >> 'd';
+    if (x != "abc") { std::terminate(); }
+    oi::inwer_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(whitespace) and eof", "", Exits{1, "Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano '\\n'\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    s >> '\n';
-    s >> oi::eof;
+TEST("Scanner(Lax)::operator>>(Str)", "abc d", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
+    string x;
+    s >> oi::Str{x, 10} >> ' ' >> 'd';
+    if (x != "abc") { std::terminate(); }
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(whitespace) and eof", "", Exits{1, "Line 1, position 1: Read EOF, expected '\\t'\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    s >> '\t';
-    s >> oi::eof;
+TEST("Scanner(UserOutput, EN)::operator>>(Str)", "abcefg efg", Exits{0, "WRONG\nLine 1, position 6: Too long string\n0\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    string x;
+    s >> oi::Str{x, 5};
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(whitespace) and eof", "", Exits{1, "Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano '\\t'\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    s >> '\t';
-    s >> oi::eof;
+TEST("Scanner(UserOutput, PL)::operator>>(Str)", "abcefg efg", Exits{0, "WRONG\nWiersz 1, pozycja 6: Zbyt dlugi napis\n0\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
+    string x;
+    s >> oi::Str{x, 5};
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(whitespace) and eof", "", Exits{1, "Line 1, position 1: Read EOF, expected '\\n'\n"}) {
+TEST("Scanner(TestInput, EN)::operator>>(Str)", "abcefg efg", Exits{1, "Line 1, position 6: Too long string\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    s >> oi::nl;
-    s >> oi::eof;
+    string x;
+    s >> oi::Str{x, 5};
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(whitespace) and eof", "", Exits{1, "Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano '\\n'\n"}) {
+TEST("Scanner(TestInput, PL)::operator>>(Str)", "abcefg efg", Exits{1, "Wiersz 1, pozycja 6: Zbyt dlugi napis\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    s >> oi::nl;
-    s >> oi::eof;
+    string x;
+    s >> oi::Str{x, 5};
 }
 
-TEST("Scanner(Lax)::operator>>(whitespace) and eof", "", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(Lax, EN)::operator>>(Str)", "abcefg efg", Exits{4, "Lax scanner: Line 1, position 6: Too long string\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    s >> ' ' >> '\t' >> '\n' >> oi::nl >> ' ' >> '\t' >> '\n' >> oi::nl;
-    s >> oi::eof;
-    oi::checker_verdict.exit_ok();
+    string x;
+    s >> oi::Str{x, 5};
 }
 
-TEST("Scanner(Lax)::operator>>(whitespace) and eof", "  \n  ", Exits{0, "OK\n\n100\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    s >> ' ' >> '\t' >> '\n' >> oi::nl >> ' ' >> '\t' >> '\n' >> oi::nl;
-    s >> oi::eof;
-    oi::checker_verdict.exit_ok();
+TEST("Scanner(Lax, PL)::operator>>(Str)", "abcefg efg", Exits{4, "Lax scanner: Wiersz 1, pozycja 6: Zbyt dlugi napis\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
+    string x;
+    s >> oi::Str{x, 5};
 }
 
-TEST("Scanner(UserOutput)::operator>>(whitespace) and destructor", "", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(UserOutput, EN)::operator>>(Str)", " a", Exits{0, "OK\n\n100\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    s >> ' ' >> '\t' >> '\n' >> oi::nl >> ' ' >> '\t' >> '\n' >> oi::nl;
+    string x;
+    s >> oi::Str{x, 5};
+    if (x != "a") { std::terminate(); }
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput)::operator>>(whitespace) and destructor", "  \n  ", Exits{0, "OK\n\n100\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    s >> ' ' >> '\t' >> '\n' >> oi::nl >> ' ' >> '\t' >> '\n' >> oi::nl;
+TEST("Scanner(UserOutput, PL)::operator>>(Str)", " a", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
+    string x;
+    s >> oi::Str{x, 5};
+    if (x != "a") { std::terminate(); }
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(whitespace) and destructor", "", Exits{1, "Line 1, position 1: Read EOF, expected ' '\n"}) {
+TEST("Scanner(TestInput, EN)::operator>>(Str)", " a", Exits{1, "Line 1, position 1: Read ' ', expected a string\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    s >> ' ';
+    string x;
+    s >> oi::Str{x, 5};
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(whitespace) and destructor", "", Exits{1, "Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano ' '\n"}) {
+TEST("Scanner(TestInput, PL)::operator>>(Str)", " a", Exits{1, "Wiersz 1, pozycja 1: Wczytano ' ', oczekiwano napisu\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    s >> ' ';
-}
-
-TEST("Scanner(TestInput, EN)::operator>>(whitespace) and destructor", "", Exits{1, "Line 1, position 1: Read EOF, expected '\\n'\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    s >> '\n';
+    string x;
+    s >> oi::Str{x, 5};
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(whitespace) and destructor", "", Exits{1, "Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano '\\n'\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    s >> '\n';
+TEST("Scanner(Lax, EN)::operator>>(Str)", " a", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
+    string x;
+    s >> oi::Str{x, 5};
+    if (x != "a") { std::terminate(); }
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(whitespace) and destructor", "", Exits{1, "Line 1, position 1: Read EOF, expected '\\t'\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    s >> '\t';
+TEST("Scanner(Lax, PL)::operator>>(Str)", " a", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
+    string x;
+    s >> oi::Str{x, 5};
+    if (x != "a") { std::terminate(); }
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(whitespace) and destructor", "", Exits{1, "Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano '\\t'\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    s >> '\t';
+TEST("Scanner(UserOutput)::operator(Char)", "a1c", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    char c;
+    s >> oi::Char{c, "a1c"};
+    if (c != 'a') { std::terminate(); }
+    s >> oi::Char{c, "a1c"};
+    if (c != '1') { std::terminate(); }
+    s >> oi::Char{c, "a1c"};
+    if (c != 'c') { std::terminate(); }
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(whitespace) and destructor", "", Exits{1, "Line 1, position 1: Read EOF, expected '\\n'\n"}) {
+TEST("Scanner(TestInput)::operator(Char)", "a1c", Exits{0, ""}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    s >> oi::nl;
-}
-
-TEST("Scanner(TestInput, PL)::operator>>(whitespace) and destructor", "", Exits{1, "Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano '\\n'\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    s >> oi::nl;
+    char c;
+    s >> oi::Char{c, "a1c"};
+    if (c != 'a') { std::terminate(); }
+    s >> oi::Char{c, "a1c"};
+    if (c != '1') { std::terminate(); }
+    s >> oi::Char{c, "a1c"};
+    if (c != 'c') { std::terminate(); }
+    oi::inwer_verdict.exit_ok();
 }
 
-TEST("Scanner(Lax)::operator>>(whitespace) and destructor do nothing", "", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(Lax)::operator(Char)", "a1c", Exits{0, "OK\n\n100\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    s >> ' ' >> '\t' >> '\n' >> oi::nl >> ' ' >> '\t' >> '\n' >> oi::nl;
+    char c;
+    s >> oi::Char{c, "a1c"};
+    if (c != 'a') { std::terminate(); }
+    s >> oi::Char{c, "a1c"};
+    if (c != '1') { std::terminate(); }
+    s >> oi::Char{c, "a1c"};
+    if (c != 'c') { std::terminate(); }
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(Lax, EN)::operator>>(whitespace) and destructor do nothing", "", Exits{4, "Lax scanner: Line 1, position 1: Read EOF, expected ' '\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    s >> ' ' >> '\t' >> '\n' >> oi::nl >> ' ' >> '\t' >> '\n' >> oi::nl >> 'a';
+TEST("Scanner(UserOutput, EN)::operator>>(Char)", "", Exits{0, "WRONG\nLine 1, position 1: Read EOF, expected one of characters: abc\n0\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    char c;
+    s >> oi::Char{c, "abc"};
 }
 
-TEST("Scanner(Lax, PL)::operator>>(whitespace) and destructor do nothing", "", Exits{4, "Lax scanner: Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano ' '\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    s >> ' ' >> '\t' >> '\n' >> oi::nl >> ' ' >> '\t' >> '\n' >> oi::nl >> 'a';
+TEST("Scanner(UserOutput, PL)::operator>>(Char)", "", Exits{0, "WRONG\nWiersz 1, pozycja 1: Wczytano EOF, oczekiwano jednego ze znakow: abc\n0\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
+    char c;
+    s >> oi::Char{c, "abc"};
 }
 
-TEST("Scanner(Lax)::operator>>(whitespace) and destructor do nothing", "  \n  ", Exits{0, "OK\n\n100\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    s >> ' ' >> '\t' >> '\n' >> oi::nl >> ' ' >> '\t' >> '\n' >> oi::nl;
-    oi::checker_verdict.exit_ok();
+TEST("Scanner(TestInput, EN)::operator>>(Char)", "", Exits{1, "Line 1, position 1: Read EOF, expected one of characters: abc\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    char c;
+    s >> oi::Char{c, "abc"};
 }
 
-TEST("Scanner(Lax, EN)::operator>>(whitespace) and destructor do nothing", "  \n   ", Exits{4, "Lax scanner: Line 2, position 4: Read EOF, expected '\\n'\n"}) {
+TEST("Scanner(TestInput, PL)::operator>>(Char)", "", Exits{1, "Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano jednego ze znakow: abc\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    char c;
+    s >> oi::Char{c, "abc"};
+}
+
+TEST("Scanner(Lax, EN)::operator>>(Char)", "", Exits{4, "Lax scanner: Line 1, position 1: Read EOF, expected one of characters: abc\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    s >> ' ' >> '\t' >> '\n' >> oi::nl >> ' ' >> '\t' >> '\n' >> oi::nl >> 'a';
+    char c;
+    s >> oi::Char{c, "abc"};
 }
 
-TEST("Scanner(Lax, PL)::operator>>(whitespace) and destructor do nothing", "  \n   ", Exits{4, "Lax scanner: Wiersz 2, pozycja 4: Wczytano EOF, oczekiwano '\\n'\n"}) {
+TEST("Scanner(Lax, PL)::operator>>(Char)", "", Exits{4, "Lax scanner: Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano jednego ze znakow: abc\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    s >> ' ' >> '\t' >> '\n' >> oi::nl >> ' ' >> '\t' >> '\n' >> oi::nl >> 'a';
+    char c;
+    s >> oi::Char{c, "abc"};
 }
 
-TEST("Scanner(UserOutput)::operator>>(whitespace) whitespace kind does not matter", " \t\fx", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(UserOutput, EN)::operator>>(Char)", "A", Exits{0, "WRONG\nLine 1, position 1: Read 'A', expected one of characters: abc\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    s >> '\t' >> ' ' >> ' ' >> 'x';
-    oi::checker_verdict.exit_ok();
-}
-
-TEST("Scanner(TestInput, EN)::operator>>(whitespace) whitespace kind does matter", " ", Exits{1, "Line 1, position 1: Read ' ', expected '\\t'\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    s >> '\t';
+    char c;
+    s >> oi::Char{c, "abc"};
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(whitespace) whitespace kind does matter", " ", Exits{1, "Wiersz 1, pozycja 1: Wczytano ' ', oczekiwano '\\t'\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    s >> '\t';
+TEST("Scanner(UserOutput, PL)::operator>>(Char)", "A", Exits{0, "WRONG\nWiersz 1, pozycja 1: Wczytano 'A', oczekiwano jednego ze znakow: abc\n0\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
+    char c;
+    s >> oi::Char{c, "abc"};
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(whitespace) whitespace kind does matter", "\t", Exits{1, "Line 1, position 1: Read '\\t', expected ' '\n"}) {
+TEST("Scanner(TestInput, EN)::operator>>(Char)", "A", Exits{1, "Line 1, position 1: Read 'A', expected one of characters: abc\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    s >> ' ';
+    char c;
+    s >> oi::Char{c, "abc"};
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(whitespace) whitespace kind does matter", "\t", Exits{1, "Wiersz 1, pozycja 1: Wczytano '\\t', oczekiwano ' '\n"}) {
+TEST("Scanner(TestInput, PL)::operator>>(Char)", "A", Exits{1, "Wiersz 1, pozycja 1: Wczytano 'A', oczekiwano jednego ze znakow: abc\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    s >> ' ';
+    char c;
+    s >> oi::Char{c, "abc"};
 }
 
-TEST("Scanner(Lax)::operator>>(whitespace) whitespace kind does not matter", " \t\fx", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(Lax, EN)::operator>>(Char)", "A", Exits{4, "Lax scanner: Line 1, position 1: Read 'A', expected one of characters: abc\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    s >> '\t' >> ' ' >> ' ' >> 'x';
-    oi::checker_verdict.exit_ok();
-}
-
-TEST("Scanner(UserOutput, EN)::operator>>(whitespace) whitespace number matters", "  x\n  x", Exits{0, "WRONG\nLine 2, position 3: Read 'x', expected ' '\n0\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    s >> ' ' >> ' ' >> 'x' >> oi::nl;
-    s >> ' ' >> ' ' >> ' ' >> 'x';
+    char c;
+    s >> oi::Char{c, "abc"};
 }
 
-TEST("Scanner(UserOutput, PL)::operator>>(whitespace) whitespace number matters", "  x\n  x", Exits{0, "WRONG\nWiersz 2, pozycja 3: Wczytano 'x', oczekiwano ' '\n0\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    s >> ' ' >> ' ' >> 'x' >> oi::nl;
-    s >> ' ' >> ' ' >> ' ' >> 'x';
+TEST("Scanner(Lax, PL)::operator>>(Char)", "A", Exits{4, "Lax scanner: Wiersz 1, pozycja 1: Wczytano 'A', oczekiwano jednego ze znakow: abc\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
+    char c;
+    s >> oi::Char{c, "abc"};
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(whitespace) whitespace number matters - too little", " ", Exits{1, "Line 1, position 2: Read EOF, expected ' '\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    s >> ' ' >> ' ';
+TEST("Scanner(UserOutput, EN)::operator>>(Char)", " a", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    char c;
+    s >> oi::Char{c, "abc"};
+    if (c != 'a') { std::terminate(); }
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(whitespace) whitespace number matters - too little", " ", Exits{1, "Wiersz 1, pozycja 2: Wczytano EOF, oczekiwano ' '\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    s >> ' ' >> ' ';
+TEST("Scanner(UserOutput, PL)::operator>>(Char)", " a", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
+    char c;
+    s >> oi::Char{c, "abc"};
+    if (c != 'a') { std::terminate(); }
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(whitespace) whitespace number matters - too much", "  a", Exits{1, "Line 1, position 2: Read ' ', expected 'a'\n"}) {
+TEST("Scanner(TestInput, EN)::operator>>(Char)", " a", Exits{1, "Line 1, position 1: Read ' ', expected one of characters: abc\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    s >> ' ' >> 'a';
+    char c;
+    s >> oi::Char{c, "abc"};
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(whitespace) whitespace number matters - too much", "  a", Exits{1, "Wiersz 1, pozycja 2: Wczytano ' ', oczekiwano 'a'\n"}) {
+TEST("Scanner(TestInput, PL)::operator>>(Char)", " a", Exits{1, "Wiersz 1, pozycja 1: Wczytano ' ', oczekiwano jednego ze znakow: abc\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    s >> ' ' >> 'a';
+    char c;
+    s >> oi::Char{c, "abc"};
 }
 
-TEST("Scanner(Lax, EN)::operator>>(whitespace) whitespace number matters", "  x\n  x", Exits{4, "Lax scanner: Line 2, position 3: Read 'x', expected ' '\n"}) {
+TEST("Scanner(Lax, EN)::operator>>(Char)", " a", Exits{0, "OK\n\n100\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    s >> ' ' >> ' ' >> 'x' >> oi::nl;
-    s >> ' ' >> ' ' >> ' ' >> 'x';
+    char c;
+    s >> oi::Char{c, "abc"};
+    if (c != 'a') { std::terminate(); }
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(Lax, PL)::operator>>(whitespace) whitespace number matters", "  x\n  x", Exits{4, "Lax scanner: Wiersz 2, pozycja 3: Wczytano 'x', oczekiwano ' '\n"}) {
+TEST("Scanner(Lax, PL)::operator>>(Char)", " a", Exits{0, "OK\n\n100\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    s >> ' ' >> ' ' >> 'x' >> oi::nl;
-    s >> ' ' >> ' ' >> ' ' >> 'x';
+    char c;
+    s >> oi::Char{c, "abc"};
+    if (c != 'a') { std::terminate(); }
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput, EN)::operator>>(nl)", "", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(UserOutput, EN)::operator>>(Num<int>)", "", Exits{0, "WRONG\nLine 1, position 1: Read EOF, expected a number\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    s >> oi::nl;
-    oi::checker_verdict.exit_ok();
+    int32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(UserOutput, PL)::operator>>(nl)", "", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(UserOutput, PL)::operator>>(Num<int>)", "", Exits{0, "WRONG\nWiersz 1, pozycja 1: Wczytano EOF, oczekiwano liczby\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    s >> oi::nl;
-    oi::checker_verdict.exit_ok();
+    int32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(nl)", "", Exits{1, "Line 1, position 1: Read EOF, expected '\\n'\n"}) {
+TEST("Scanner(TestInput, EN)::operator>>(Num<int>)", "", Exits{1, "Line 1, position 1: Read EOF, expected a number\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    s >> oi::nl;
+    int32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(nl)", "", Exits{1, "Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano '\\n'\n"}) {
+TEST("Scanner(TestInput, PL)::operator>>(Num<int>)", "", Exits{1, "Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano liczby\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    s >> oi::nl;
+    int32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(Lax, EN)::operator>>(nl)", "", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(Lax, EN)::operator>>(Num<int>)", "", Exits{4, "Lax scanner: Line 1, position 1: Read EOF, expected a number\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    s >> oi::nl;
-    oi::checker_verdict.exit_ok();
+    int32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(Lax, PL)::operator>>(nl)", "", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(Lax, PL)::operator>>(Num<int>)", "", Exits{4, "Lax scanner: Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano liczby\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    s >> oi::nl;
-    oi::checker_verdict.exit_ok();
+    int32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(Lax, EN)::operator>>(nl)", "", Exits{4, "Lax scanner: Line 1, position 1: Read EOF, expected '\\n'\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    s >> oi::nl >> 'x';
-    oi::checker_verdict.exit_ok();
+TEST("Scanner(UserOutput, EN)::operator>>(Num<int>)", "-", Exits{0, "WRONG\nLine 1, position 2: Read EOF, expected a number\n0\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    int32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(Lax, PL)::operator>>(nl)", "", Exits{4, "Lax scanner: Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano '\\n'\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    s >> oi::nl >> 'x';
-    oi::checker_verdict.exit_ok();
+TEST("Scanner(UserOutput, PL)::operator>>(Num<int>)", "-", Exits{0, "WRONG\nWiersz 1, pozycja 2: Wczytano EOF, oczekiwano liczby\n0\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
+    int32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(UserOutput)::operator>>(nl)", "\n", Exits{0, "OK\n\n100\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    s >> oi::nl;
-    oi::checker_verdict.exit_ok();
+TEST("Scanner(TestInput, EN)::operator>>(Num<int>)", "-", Exits{1, "Line 1, position 2: Read EOF, expected a number\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    int32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(TestInput)::operator>>(nl)", "\n", Exits{0, ""}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    s >> oi::nl;
-    oi::inwer_verdict.exit_ok();
+TEST("Scanner(TestInput, PL)::operator>>(Num<int>)", "-", Exits{1, "Wiersz 1, pozycja 2: Wczytano EOF, oczekiwano liczby\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    int32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(Lax)::operator>>(nl)", "\n", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(Lax, EN)::operator>>(Num<int>)", "-", Exits{4, "Lax scanner: Line 1, position 2: Read EOF, expected a number\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    s >> oi::nl;
-    oi::checker_verdict.exit_ok();
+    int32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(UserOutput)::operator>>(nl)", "   \n", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(Lax, PL)::operator>>(Num<int>)", "-", Exits{4, "Lax scanner: Wiersz 1, pozycja 2: Wczytano EOF, oczekiwano liczby\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
+    int32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+}
+
+TEST("Scanner(UserOutput)::operator>>(Num<int>)", "0\n42\n-1337\n-2147483648\n2147483647", Exits{0, "OK\n\n100\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    s >> oi::nl;
+    int32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    if (x != 0) { std::terminate(); }
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    if (x != 42) { std::terminate(); }
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    if (x != -1337) { std::terminate(); }
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    if (x != -2147483648) { std::terminate(); }
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    if (x != 2147483647) { std::terminate(); }
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(nl)", "   \n", Exits{1, "Line 1, position 1: Read ' ', expected '\\n'\n"}) {
+TEST("Scanner(TestInput)::operator>>(Num<int>)", "0\n42\n-1337\n-2147483648\n2147483647", Exits{0, ""}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    s >> oi::nl;
-}
-
-TEST("Scanner(TestInput, PL)::operator>>(nl)", "   \n", Exits{1, "Wiersz 1, pozycja 1: Wczytano ' ', oczekiwano '\\n'\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    s >> oi::nl;
+    int32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    if (x != 0) { std::terminate(); }
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    if (x != 42) { std::terminate(); }
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    if (x != -1337) { std::terminate(); }
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    if (x != -2147483648) { std::terminate(); }
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    if (x != 2147483647) { std::terminate(); }
+    oi::inwer_verdict.exit_ok();
 }
 
-TEST("Scanner(Lax)::operator>>(nl)", "   \n", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(Lax)::operator>>(Num<int>)", "0\n42\n-1337\n-2147483648\n2147483647", Exits{0, "OK\n\n100\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    s >> oi::nl;
+    int32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    if (x != 0) { std::terminate(); }
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    if (x != 42) { std::terminate(); }
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    if (x != -1337) { std::terminate(); }
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    if (x != -2147483648) { std::terminate(); }
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    if (x != 2147483647) { std::terminate(); }
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput, EN)::operator>>(nl)", "   a", Exits{0, "WRONG\nLine 1, position 4: Read 'a', expected EOF\n0\n"}) {
+TEST("Scanner(UserOutput, EN)::operator>>(Num<int>) multiply by 10 negative overflow", "-21474836480", Exits{0, "WRONG\nLine 1, position 12: Integer value out of range\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    s >> oi::nl;
+    int32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(UserOutput, PL)::operator>>(nl)", "   a", Exits{0, "WRONG\nWiersz 1, pozycja 4: Wczytano 'a', oczekiwano EOF\n0\n"}) {
+TEST("Scanner(UserOutput, PL)::operator>>(Num<int>) multiply by 10 negative overflow", "-21474836480", Exits{0, "WRONG\nWiersz 1, pozycja 12: Liczba calkowita spoza zakresu\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    s >> oi::nl;
+    int32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(nl)", "a", Exits{1, "Line 1, position 1: Read 'a', expected '\\n'\n"}) {
+TEST("Scanner(TestInput, EN)::operator>>(Num<int>) multiply by 10 negative overflow", "-21474836480", Exits{1, "Line 1, position 12: Integer value out of range\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    s >> oi::nl;
+    int32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(nl)", "a", Exits{1, "Wiersz 1, pozycja 1: Wczytano 'a', oczekiwano '\\n'\n"}) {
+TEST("Scanner(TestInput, PL)::operator>>(Num<int>) multiply by 10 negative overflow", "-21474836480", Exits{1, "Wiersz 1, pozycja 12: Liczba calkowita spoza zakresu\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    s >> oi::nl;
-}
-
-TEST("Scanner(Lax, EN)::operator>>(nl)", "   a", Exits{0, "OK\n\n100\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    s >> oi::nl;
-    oi::checker_verdict.exit_ok();
-}
-
-TEST("Scanner(Lax, PL)::operator>>(nl)", "   a", Exits{0, "OK\n\n100\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    s >> oi::nl;
-    oi::checker_verdict.exit_ok();
+    int32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(Lax, EN)::operator>>(nl)", "   a", Exits{4, "Lax scanner: Line 1, position 4: Read 'a', expected '\\n'\n"}) {
+TEST("Scanner(Lax, EN)::operator>>(Num<int>) multiply by 10 negative overflow", "-21474836480", Exits{4, "Lax scanner: Line 1, position 12: Integer value out of range\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    s >> oi::nl >> 'b';
+    int32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(Lax, PL)::operator>>(nl)", "   a", Exits{4, "Lax scanner: Wiersz 1, pozycja 4: Wczytano 'a', oczekiwano '\\n'\n"}) {
+TEST("Scanner(Lax, PL)::operator>>(Num<int>) multiply by 10 negative overflow", "-21474836480", Exits{4, "Lax scanner: Wiersz 1, pozycja 12: Liczba calkowita spoza zakresu\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    s >> oi::nl >> 'b';
-}
-
-TEST("Scanner(UserOutput)::operator>>(ignore_ws) ignoring before EOF is no-op", "", Exits{0, "OK\n\n100\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    s >> oi::ignore_ws;
-    oi::checker_verdict.exit_ok();
-}
-
-TEST("Scanner(TestInput)::operator>>(ignore_ws) ignoring before EOF is no-op", "", Exits{0, ""}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    s >> oi::ignore_ws;
-    oi::inwer_verdict.exit_ok();
-}
-
-TEST("Scanner(Lax)::operator>>(ignore_ws) ignoring before EOF is no-op", "", Exits{0, "OK\n\n100\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    s >> oi::ignore_ws;
-    oi::checker_verdict.exit_ok();
+    int32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(UserOutput, EN)::operator>>(ignore_ws) does not ignore newline", "  \na", Exits{0, "WRONG\nLine 1, position 3: Read '\\n', expected 'a'\n0\n"}) {
+TEST("Scanner(UserOutput, EN)::operator>>(Num<int>) multiply by 10 positive overflow", "21474836470", Exits{0, "WRONG\nLine 1, position 11: Integer value out of range\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    s >> oi::ignore_ws >> 'a';
+    int32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(UserOutput, PL)::operator>>(ignore_ws) does not ignore newline", "  \na", Exits{0, "WRONG\nWiersz 1, pozycja 3: Wczytano '\\n', oczekiwano 'a'\n0\n"}) {
+TEST("Scanner(UserOutput, PL)::operator>>(Num<int>) multiply by 10 positive overflow", "21474836470", Exits{0, "WRONG\nWiersz 1, pozycja 11: Liczba calkowita spoza zakresu\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    s >> oi::ignore_ws >> 'a';
+    int32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(ignore_ws) does not ignore newline", "  \na", Exits{1, "Line 1, position 3: Read '\\n', expected 'a'\n"}) {
+TEST("Scanner(TestInput, EN)::operator>>(Num<int>) multiply by 10 positive overflow", "21474836470", Exits{1, "Line 1, position 11: Integer value out of range\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    s >> oi::ignore_ws >> 'a';
+    int32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(ignore_ws) does not ignore newline", "  \na", Exits{1, "Wiersz 1, pozycja 3: Wczytano '\\n', oczekiwano 'a'\n"}) {
+TEST("Scanner(TestInput, PL)::operator>>(Num<int>) multiply by 10 positive overflow", "21474836470", Exits{1, "Wiersz 1, pozycja 11: Liczba calkowita spoza zakresu\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    s >> oi::ignore_ws >> 'a';
+    int32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(Lax, EN)::operator>>(ignore_ws) does not ignore newline", "  \na", Exits{4, "Lax scanner: Line 1, position 3: Read '\\n', expected 'a'\n"}) {
+TEST("Scanner(Lax, EN)::operator>>(Num<int>) multiply by 10 positive overflow", "21474836470", Exits{4, "Lax scanner: Line 1, position 11: Integer value out of range\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    s >> oi::ignore_ws >> 'a';
+    int32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(Lax, PL)::operator>>(ignore_ws) does not ignore newline", "  \na", Exits{4, "Lax scanner: Wiersz 1, pozycja 3: Wczytano '\\n', oczekiwano 'a'\n"}) {
+TEST("Scanner(Lax, PL)::operator>>(Num<int>) multiply by 10 positive overflow", "21474836470", Exits{4, "Lax scanner: Wiersz 1, pozycja 11: Liczba calkowita spoza zakresu\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    s >> oi::ignore_ws >> 'a';
+    int32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(UserOutput)::operator>>(ignore_ws) ignoring works", "   aa", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(UserOutput, EN)::operator>>(Num<int>) addition positive overflow", "2147483648", Exits{0, "WRONG\nLine 1, position 10: Integer value out of range\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    s >> oi::ignore_ws >> 'a' >> oi::ignore_ws >> 'a';
-    oi::checker_verdict.exit_ok();
+    int32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(TestInput)::operator>>(ignore_ws) ignoring works", "   aa", Exits{0, ""}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    s >> oi::ignore_ws >> 'a' >> oi::ignore_ws >> 'a';
-    oi::inwer_verdict.exit_ok();
+TEST("Scanner(UserOutput, PL)::operator>>(Num<int>) addition positive overflow", "2147483648", Exits{0, "WRONG\nWiersz 1, pozycja 10: Liczba calkowita spoza zakresu\n0\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
+    int32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(Lax)::operator>>(ignore_ws) ignoring works", "   aa", Exits{0, "OK\n\n100\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    s >> oi::ignore_ws >> 'a' >> oi::ignore_ws >> 'a';
-    oi::checker_verdict.exit_ok();
+TEST("Scanner(TestInput, EN)::operator>>(Num<int>) addition positive overflow", "2147483648", Exits{1, "Line 1, position 10: Integer value out of range\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    int32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(UserOutput)::operator>>(Line)", "", Exits{0, "OK\n\n100\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    string x;
-    s >> oi::Line{x, 10};
-    if (x != "") { std::terminate(); }
-    oi::checker_verdict.exit_ok();
+TEST("Scanner(TestInput, PL)::operator>>(Num<int>) addition positive overflow", "2147483648", Exits{1, "Wiersz 1, pozycja 10: Liczba calkowita spoza zakresu\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    int32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(TestInput)::operator>>(Line)", "", Exits{0, ""}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    string x;
-    s >> oi::Line{x, 10};
-    if (x != "") { std::terminate(); }
-    oi::inwer_verdict.exit_ok();
+TEST("Scanner(Lax, EN)::operator>>(Num<int>) addition positive overflow", "2147483648", Exits{4, "Lax scanner: Line 1, position 10: Integer value out of range\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
+    int32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(Lax)::operator>>(Line)", "", Exits{0, "OK\n\n100\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    string x;
-    s >> oi::Line{x, 10};
-    if (x != "") { std::terminate(); }
-    oi::checker_verdict.exit_ok();
+TEST("Scanner(Lax, PL)::operator>>(Num<int>) addition positive overflow", "2147483648", Exits{4, "Lax scanner: Wiersz 1, pozycja 10: Liczba calkowita spoza zakresu\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
+    int32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(UserOutput)::operator>>(Line)", "\n", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(UserOutput, EN)::operator>>(Num<int>) addition negative overflow", "-2147483649", Exits{0, "WRONG\nLine 1, position 11: Integer value out of range\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    string x;
-    s >> oi::Line{x, 10} >> '\n';
-    if (x != "") { std::terminate(); }
-    oi::checker_verdict.exit_ok();
+    int32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(TestInput)::operator>>(Line)", "\n", Exits{0, ""}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    string x;
-    s >> oi::Line{x, 10} >> '\n';
-    if (x != "") { std::terminate(); }
-    oi::inwer_verdict.exit_ok();
+TEST("Scanner(UserOutput, PL)::operator>>(Num<int>) addition negative overflow", "-2147483649", Exits{0, "WRONG\nWiersz 1, pozycja 11: Liczba calkowita spoza zakresu\n0\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
+    int32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(Lax)::operator>>(Line)", "\n", Exits{0, "OK\n\n100\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    string x;
-    s >> oi::Line{x, 10} >> '\n';
-    if (x != "") { std::terminate(); }
-    oi::checker_verdict.exit_ok();
+TEST("Scanner(TestInput, EN)::operator>>(Num<int>) addition negative overflow", "-2147483649", Exits{1, "Line 1, position 11: Integer value out of range\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    int32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(UserOutput)::operator>>(Line)", " a b c ", Exits{0, "OK\n\n100\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    string x;
-    s >> oi::Line{x, 10};
-    if (x != " a b c ") { std::terminate(); }
-    oi::checker_verdict.exit_ok();
+TEST("Scanner(TestInput, PL)::operator>>(Num<int>) addition negative overflow", "-2147483649", Exits{1, "Wiersz 1, pozycja 11: Liczba calkowita spoza zakresu\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    int32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(TestInput)::operator>>(Line)", " a b c ", Exits{0, ""}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    string x;
-    s >> oi::Line{x, 10};
-    if (x != " a b c ") { std::terminate(); }
-    oi::inwer_verdict.exit_ok();
+TEST("Scanner(Lax, EN)::operator>>(Num<int>) addition negative overflow", "-2147483649", Exits{4, "Lax scanner: Line 1, position 11: Integer value out of range\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
+    int32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(Lax)::operator>>(Line)", " a b c ", Exits{0, "OK\n\n100\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    string x;
-    s >> oi::Line{x, 10};
-    if (x != " a b c ") { std::terminate(); }
-    oi::checker_verdict.exit_ok();
+TEST("Scanner(Lax, PL)::operator>>(Num<int>) addition negative overflow", "-2147483649", Exits{4, "Lax scanner: Wiersz 1, pozycja 11: Liczba calkowita spoza zakresu\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
+    int32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(UserOutput)::operator>>(Line)", " a b c \n", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(UserOutput)::operator>>(Num<int>)", "255 256 257", Exits{0, "OK\n\n100\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    string x;
-    s >> oi::Line{x, 10} >> '\n';
-    if (x != " a b c ") { std::terminate(); }
+    int32_t x;
+    s >> oi::Num{x, 255, 257} >> ' ';
+    if (x != 255) { std::terminate(); }
+    s >> oi::Num{x, 255, 257} >> ' ';
+    if (x != 256) { std::terminate(); }
+    s >> oi::Num{x, 255, 257};
+    if (x != 257) { std::terminate(); }
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput)::operator>>(Line)", " a b c \n", Exits{0, ""}) {
+TEST("Scanner(TestInput)::operator>>(Num<int>)", "255 256 257", Exits{0, ""}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    string x;
-    s >> oi::Line{x, 10} >> '\n';
-    if (x != " a b c ") { std::terminate(); }
+    int32_t x;
+    s >> oi::Num{x, 255, 257} >> ' ';
+    if (x != 255) { std::terminate(); }
+    s >> oi::Num{x, 255, 257} >> ' ';
+    if (x != 256) { std::terminate(); }
+    s >> oi::Num{x, 255, 257};
+    if (x != 257) { std::terminate(); }
     oi::inwer_verdict.exit_ok();
 }
 
-TEST("Scanner(Lax)::operator>>(Line)", " a b c \n", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(Lax)::operator>>(Num<int>)", "255 256 257", Exits{0, "OK\n\n100\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    string x;
-    s >> oi::Line{x, 10} >> '\n';
-    if (x != " a b c ") { std::terminate(); }
+    int32_t x;
+    s >> oi::Num{x, 255, 257} >> ' ';
+    if (x != 255) { std::terminate(); }
+    s >> oi::Num{x, 255, 257} >> ' ';
+    if (x != 256) { std::terminate(); }
+    s >> oi::Num{x, 255, 257};
+    if (x != 257) { std::terminate(); }
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput, EN)::operator>>(Str)", "", Exits{0, "WRONG\nLine 1, position 1: Read EOF, expected a string\n0\n"}) {
+TEST("Scanner(UserOutput, EN)::operator>>(Num<int>)", "-8", Exits{0, "WRONG\nLine 1, position 2: Integer value out of range\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    string x;
-    s >> oi::Str{x, 10};
+    int32_t x;
+    s >> oi::Num{x, -7, 7};
 }
 
-TEST("Scanner(UserOutput, PL)::operator>>(Str)", "", Exits{0, "WRONG\nWiersz 1, pozycja 1: Wczytano EOF, oczekiwano napisu\n0\n"}) {
+TEST("Scanner(UserOutput, PL)::operator>>(Num<int>)", "-8", Exits{0, "WRONG\nWiersz 1, pozycja 2: Liczba calkowita spoza zakresu\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    string x;
-    s >> oi::Str{x, 10};
+    int32_t x;
+    s >> oi::Num{x, -7, 7};
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(Str)", "", Exits{1, "Line 1, position 1: Read EOF, expected a string\n"}) {
+TEST("Scanner(TestInput, EN)::operator>>(Num<int>)", "-8", Exits{1, "Line 1, position 2: Integer value out of range\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    string x;
-    s >> oi::Str{x, 10};
+    int32_t x;
+    s >> oi::Num{x, -7, 7};
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(Str)", "", Exits{1, "Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano napisu\n"}) {
+TEST("Scanner(TestInput, PL)::operator>>(Num<int>)", "-8", Exits{1, "Wiersz 1, pozycja 2: Liczba calkowita spoza zakresu\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    string x;
-    s >> oi::Str{x, 10};
+    int32_t x;
+    s >> oi::Num{x, -7, 7};
 }
 
-TEST("Scanner(Lax, EN)::operator>>(Str)", "", Exits{4, "Lax scanner: Line 1, position 1: Read EOF, expected a string\n"}) {
+TEST("Scanner(Lax, EN)::operator>>(Num<int>)", "-8", Exits{4, "Lax scanner: Line 1, position 2: Integer value out of range\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    string x;
-    s >> oi::Str{x, 10};
+    int32_t x;
+    s >> oi::Num{x, -7, 7};
 }
 
-TEST("Scanner(Lax, PL)::operator>>(Str)", "", Exits{4, "Lax scanner: Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano napisu\n"}) {
+TEST("Scanner(Lax, PL)::operator>>(Num<int>)", "-8", Exits{4, "Lax scanner: Wiersz 1, pozycja 2: Liczba calkowita spoza zakresu\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    string x;
-    s >> oi::Str{x, 10};
+    int32_t x;
+    s >> oi::Num{x, -7, 7};
 }
 
-TEST("Scanner(UserOutput, EN)::operator>>(Str)", " ", Exits{0, "WRONG\nLine 1, position 2: Read EOF, expected a string\n0\n"}) {
+TEST("Scanner(UserOutput, EN)::operator>>(Num<int>)", "8", Exits{0, "WRONG\nLine 1, position 1: Integer value out of range\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    string x;
-    s >> oi::Str{x, 10};
+    int32_t x;
+    s >> oi::Num{x, -7, 7};
 }
 
-TEST("Scanner(UserOutput, PL)::operator>>(Str)", " ", Exits{0, "WRONG\nWiersz 1, pozycja 2: Wczytano EOF, oczekiwano napisu\n0\n"}) {
+TEST("Scanner(UserOutput, PL)::operator>>(Num<int>)", "8", Exits{0, "WRONG\nWiersz 1, pozycja 1: Liczba calkowita spoza zakresu\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    string x;
-    s >> oi::Str{x, 10};
+    int32_t x;
+    s >> oi::Num{x, -7, 7};
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(Str)", " ", Exits{1, "Line 1, position 1: Read ' ', expected a string\n"}) {
+TEST("Scanner(TestInput, EN)::operator>>(Num<int>)", "8", Exits{1, "Line 1, position 1: Integer value out of range\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    string x;
-    s >> oi::Str{x, 10};
+    int32_t x;
+    s >> oi::Num{x, -7, 7};
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(Str)", " ", Exits{1, "Wiersz 1, pozycja 1: Wczytano ' ', oczekiwano napisu\n"}) {
+TEST("Scanner(TestInput, PL)::operator>>(Num<int>)", "8", Exits{1, "Wiersz 1, pozycja 1: Liczba calkowita spoza zakresu\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    string x;
-    s >> oi::Str{x, 10};
+    int32_t x;
+    s >> oi::Num{x, -7, 7};
 }
 
-TEST("Scanner(Lax, EN)::operator>>(Str)", " ", Exits{4, "Lax scanner: Line 1, position 2: Read EOF, expected a string\n"}) {
+TEST("Scanner(Lax, EN)::operator>>(Num<int>)", "8", Exits{4, "Lax scanner: Line 1, position 1: Integer value out of range\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    string x;
-    s >> oi::Str{x, 10};
+    int32_t x;
+    s >> oi::Num{x, -7, 7};
 }
 
-TEST("Scanner(Lax, PL)::operator>>(Str)", " ", Exits{4, "Lax scanner: Wiersz 1, pozycja 2: Wczytano EOF, oczekiwano napisu\n"}) {
+TEST("Scanner(Lax, PL)::operator>>(Num<int>)", "8", Exits{4, "Lax scanner: Wiersz 1, pozycja 1: Liczba calkowita spoza zakresu\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    string x;
-    s >> oi::Str{x, 10};
+    int32_t x;
+    s >> oi::Num{x, -7, 7};
 }
 
-TEST("Scanner(UserOutput)::operator>>(Str)", "abc", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(UserOutput, EN)::operator>>(Num<int>) whitespace is ignored", " 0", Exits{0, "OK\n\n100\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    string x;
-    s >> oi::Str{x, 10};
-    if (x != "abc") { std::terminate(); }
+    int32_t x;
+    s >> oi::Num{x, 0, 0};
+    if (x != 0) { std::terminate(); }
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput)::operator>>(Str)", "abc", Exits{0, ""}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    string x;
-    s >> oi::Str{x, 10};
-    if (x != "abc") { std::terminate(); }
-    oi::inwer_verdict.exit_ok();
-}
-
-TEST("Scanner(Lax)::operator>>(Str)", "abc", Exits{0, "OK\n\n100\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    string x;
-    s >> oi::Str{x, 10};
-    if (x != "abc") { std::terminate(); }
+TEST("Scanner(UserOutput, PL)::operator>>(Num<int>) whitespace is ignored", " 0", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
+    int32_t x;
+    s >> oi::Num{x, 0, 0};
+    if (x != 0) { std::terminate(); }
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput)::operator>>(Str)", "abc d", Exits{0, "OK\n\n100\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    string x;
-    s >> oi::Str{x, 10} >> ' ' >> 'd';
-    if (x != "abc") { std::terminate(); }
-    oi::checker_verdict.exit_ok();
+TEST("Scanner(TestInput, EN)::operator>>(Num<int>) whitespace is not ignored", " 0", Exits{1, "Line 1, position 1: Read ' ', expected a number\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    int32_t x;
+    s >> oi::Num{x, 0, 0};
 }
 
-TEST("Scanner(TestInput)::operator>>(Str)", "abc d", Exits{0, ""}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    string x;
-    s >> oi::Str{x, 10} >> ' ' >> 'd';
-    if (x != "abc") { std::terminate(); }
-    oi::inwer_verdict.exit_ok();
+TEST("Scanner(TestInput, PL)::operator>>(Num<int>) whitespace is not ignored", " 0", Exits{1, "Wiersz 1, pozycja 1: Wczytano ' ', oczekiwano liczby\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    int32_t x;
+    s >> oi::Num{x, 0, 0};
 }
 
-TEST("Scanner(Lax)::operator>>(Str)", "abc d", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(Lax, EN)::operator>>(Num<int>) whitespace is ignored", " 0", Exits{0, "OK\n\n100\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    string x;
-    s >> oi::Str{x, 10} >> ' ' >> 'd';
-    if (x != "abc") { std::terminate(); }
+    int32_t x;
+    s >> oi::Num{x, 0, 0};
+    if (x != 0) { std::terminate(); }
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput, EN)::operator>>(Str)", "abcefg efg", Exits{0, "WRONG\nLine 1, position 6: Too long string\n0\n"}) {
+TEST("Scanner(Lax, PL)::operator>>(Num<int>) whitespace is ignored", " 0", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
+    int32_t x;
+    s >> oi::Num{x, 0, 0};
+    if (x != 0) { std::terminate(); }
+    oi::checker_verdict.exit_ok();
+}
+
+TEST("Scanner(UserOutput, EN)::operator>>(Num<uint>)", "", Exits{0, "WRONG\nLine 1, position 1: Read EOF, expected a number\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    string x;
-    s >> oi::Str{x, 5};
+    uint32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(UserOutput, PL)::operator>>(Str)", "abcefg efg", Exits{0, "WRONG\nWiersz 1, pozycja 6: Zbyt dlugi napis\n0\n"}) {
+TEST("Scanner(UserOutput, PL)::operator>>(Num<uint>)", "", Exits{0, "WRONG\nWiersz 1, pozycja 1: Wczytano EOF, oczekiwano liczby\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    string x;
-    s >> oi::Str{x, 5};
+    uint32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(Str)", "abcefg efg", Exits{1, "Line 1, position 6: Too long string\n"}) {
+TEST("Scanner(TestInput, EN)::operator>>(Num<uint>)", "", Exits{1, "Line 1, position 1: Read EOF, expected a number\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    string x;
-    s >> oi::Str{x, 5};
+    uint32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(Str)", "abcefg efg", Exits{1, "Wiersz 1, pozycja 6: Zbyt dlugi napis\n"}) {
+TEST("Scanner(TestInput, PL)::operator>>(Num<uint>)", "", Exits{1, "Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano liczby\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    string x;
-    s >> oi::Str{x, 5};
+    uint32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(Lax, EN)::operator>>(Str)", "abcefg efg", Exits{4, "Lax scanner: Line 1, position 6: Too long string\n"}) {
+TEST("Scanner(Lax, EN)::operator>>(Num<uint>)", "", Exits{4, "Lax scanner: Line 1, position 1: Read EOF, expected a number\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    string x;
-    s >> oi::Str{x, 5};
+    uint32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(Lax, PL)::operator>>(Str)", "abcefg efg", Exits{4, "Lax scanner: Wiersz 1, pozycja 6: Zbyt dlugi napis\n"}) {
+TEST("Scanner(Lax, PL)::operator>>(Num<uint>)", "", Exits{4, "Lax scanner: Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano liczby\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    string x;
-    s >> oi::Str{x, 5};
+    uint32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(UserOutput, EN)::operator>>(Str)", " a", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(UserOutput, EN)::operator>>(Num<uint>)", "-", Exits{0, "WRONG\nLine 1, position 1: Read '-', expected a non-negative number\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    string x;
-    s >> oi::Str{x, 5};
-    if (x != "a") { std::terminate(); }
-    oi::checker_verdict.exit_ok();
+    uint32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(UserOutput, PL)::operator>>(Str)", " a", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(UserOutput, PL)::operator>>(Num<uint>)", "-", Exits{0, "WRONG\nWiersz 1, pozycja 1: Wczytano '-', oczekiwano nieujemnej liczby\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    string x;
-    s >> oi::Str{x, 5};
-    if (x != "a") { std::terminate(); }
-    oi::checker_verdict.exit_ok();
+    uint32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(Str)", " a", Exits{1, "Line 1, position 1: Read ' ', expected a string\n"}) {
+TEST("Scanner(TestInput, EN)::operator>>(Num<uint>)", "-", Exits{1, "Line 1, position 1: Read '-', expected a non-negative number\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    string x;
-    s >> oi::Str{x, 5};
+    uint32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(Str)", " a", Exits{1, "Wiersz 1, pozycja 1: Wczytano ' ', oczekiwano napisu\n"}) {
+TEST("Scanner(TestInput, PL)::operator>>(Num<uint>)", "-", Exits{1, "Wiersz 1, pozycja 1: Wczytano '-', oczekiwano nieujemnej liczby\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    string x;
-    s >> oi::Str{x, 5};
+    uint32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(Lax, EN)::operator>>(Str)", " a", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(Lax, EN)::operator>>(Num<uint>)", "-", Exits{4, "Lax scanner: Line 1, position 1: Read '-', expected a non-negative number\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    string x;
-    s >> oi::Str{x, 5};
-    if (x != "a") { std::terminate(); }
-    oi::checker_verdict.exit_ok();
+    uint32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(Lax, PL)::operator>>(Str)", " a", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(Lax, PL)::operator>>(Num<uint>)", "-", Exits{4, "Lax scanner: Wiersz 1, pozycja 1: Wczytano '-', oczekiwano nieujemnej liczby\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    string x;
-    s >> oi::Str{x, 5};
-    if (x != "a") { std::terminate(); }
-    oi::checker_verdict.exit_ok();
+    uint32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(UserOutput)::operator(Char)", "a1c", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(UserOutput)::operator>>(Num<uint>)", "0\n42\n4294967295", Exits{0, "OK\n\n100\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    char c;
-    s >> oi::Char{c, "a1c"};
-    if (c != 'a') { std::terminate(); }
-    s >> oi::Char{c, "a1c"};
-    if (c != '1') { std::terminate(); }
-    s >> oi::Char{c, "a1c"};
-    if (c != 'c') { std::terminate(); }
+    uint32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    if (x != 0) { std::terminate(); }
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    if (x != 42) { std::terminate(); }
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    if (x != 4294967295) { std::terminate(); }
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput)::operator(Char)", "a1c", Exits{0, ""}) {
+TEST("Scanner(TestInput)::operator>>(Num<uint>)", "0\n42\n4294967295", Exits{0, ""}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    char c;
-    s >> oi::Char{c, "a1c"};
-    if (c != 'a') { std::terminate(); }
-    s >> oi::Char{c, "a1c"};
-    if (c != '1') { std::terminate(); }
-    s >> oi::Char{c, "a1c"};
-    if (c != 'c') { std::terminate(); }
+    uint32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    if (x != 0) { std::terminate(); }
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    if (x != 42) { std::terminate(); }
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    if (x != 4294967295) { std::terminate(); }
     oi::inwer_verdict.exit_ok();
 }
 
-TEST("Scanner(Lax)::operator(Char)", "a1c", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(Lax)::operator>>(Num<uint>)", "0\n42\n4294967295", Exits{0, "OK\n\n100\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    char c;
-    s >> oi::Char{c, "a1c"};
-    if (c != 'a') { std::terminate(); }
-    s >> oi::Char{c, "a1c"};
-    if (c != '1') { std::terminate(); }
-    s >> oi::Char{c, "a1c"};
-    if (c != 'c') { std::terminate(); }
+    uint32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    if (x != 0) { std::terminate(); }
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    if (x != 42) { std::terminate(); }
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    if (x != 4294967295) { std::terminate(); }
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput, EN)::operator>>(Char)", "", Exits{0, "WRONG\nLine 1, position 1: Read EOF, expected one of characters: abc\n0\n"}) {
+TEST("Scanner(UserOutput, EN)::operator>>(Num<uint>) multiply by 10 overflow", "42949672950", Exits{0, "WRONG\nLine 1, position 11: Integer value out of range\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    char c;
-    s >> oi::Char{c, "abc"};
+    uint32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(UserOutput, PL)::operator>>(Char)", "", Exits{0, "WRONG\nWiersz 1, pozycja 1: Wczytano EOF, oczekiwano jednego ze znakow: abc\n0\n"}) {
+TEST("Scanner(UserOutput, PL)::operator>>(Num<uint>) multiply by 10 overflow", "42949672950", Exits{0, "WRONG\nWiersz 1, pozycja 11: Liczba calkowita spoza zakresu\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    char c;
-    s >> oi::Char{c, "abc"};
+    uint32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(Char)", "", Exits{1, "Line 1, position 1: Read EOF, expected one of characters: abc\n"}) {
+TEST("Scanner(TestInput, EN)::operator>>(Num<uint>) multiply by 10 overflow", "42949672950", Exits{1, "Line 1, position 11: Integer value out of range\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    char c;
-    s >> oi::Char{c, "abc"};
+    uint32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(Char)", "", Exits{1, "Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano jednego ze znakow: abc\n"}) {
+TEST("Scanner(TestInput, PL)::operator>>(Num<uint>) multiply by 10 overflow", "42949672950", Exits{1, "Wiersz 1, pozycja 11: Liczba calkowita spoza zakresu\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    char c;
-    s >> oi::Char{c, "abc"};
+    uint32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(Lax, EN)::operator>>(Char)", "", Exits{4, "Lax scanner: Line 1, position 1: Read EOF, expected one of characters: abc\n"}) {
+TEST("Scanner(Lax, EN)::operator>>(Num<uint>) multiply by 10 overflow", "42949672950", Exits{4, "Lax scanner: Line 1, position 11: Integer value out of range\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    char c;
-    s >> oi::Char{c, "abc"};
+    uint32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(Lax, PL)::operator>>(Char)", "", Exits{4, "Lax scanner: Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano jednego ze znakow: abc\n"}) {
+TEST("Scanner(Lax, PL)::operator>>(Num<uint>) multiply by 10 overflow", "42949672950", Exits{4, "Lax scanner: Wiersz 1, pozycja 11: Liczba calkowita spoza zakresu\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    char c;
-    s >> oi::Char{c, "abc"};
+    uint32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(UserOutput, EN)::operator>>(Char)", "A", Exits{0, "WRONG\nLine 1, position 1: Read 'A', expected one of characters: abc\n0\n"}) {
+TEST("Scanner(UserOutput, EN)::operator>>(Num<uint>) addition overflow", "4294967296", Exits{0, "WRONG\nLine 1, position 10: Integer value out of range\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    char c;
-    s >> oi::Char{c, "abc"};
+    uint32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(UserOutput, PL)::operator>>(Char)", "A", Exits{0, "WRONG\nWiersz 1, pozycja 1: Wczytano 'A', oczekiwano jednego ze znakow: abc\n0\n"}) {
+TEST("Scanner(UserOutput, PL)::operator>>(Num<uint>) addition overflow", "4294967296", Exits{0, "WRONG\nWiersz 1, pozycja 10: Liczba calkowita spoza zakresu\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    char c;
-    s >> oi::Char{c, "abc"};
+    uint32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(Char)", "A", Exits{1, "Line 1, position 1: Read 'A', expected one of characters: abc\n"}) {
+TEST("Scanner(TestInput, EN)::operator>>(Num<uint>) addition overflow", "4294967296", Exits{1, "Line 1, position 10: Integer value out of range\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    char c;
-    s >> oi::Char{c, "abc"};
+    uint32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(Char)", "A", Exits{1, "Wiersz 1, pozycja 1: Wczytano 'A', oczekiwano jednego ze znakow: abc\n"}) {
+TEST("Scanner(TestInput, PL)::operator>>(Num<uint>) addition overflow", "4294967296", Exits{1, "Wiersz 1, pozycja 10: Liczba calkowita spoza zakresu\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    char c;
-    s >> oi::Char{c, "abc"};
+    uint32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(Lax, EN)::operator>>(Char)", "A", Exits{4, "Lax scanner: Line 1, position 1: Read 'A', expected one of characters: abc\n"}) {
+TEST("Scanner(Lax, EN)::operator>>(Num<uint>) addition overflow", "4294967296", Exits{4, "Lax scanner: Line 1, position 10: Integer value out of range\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    char c;
-    s >> oi::Char{c, "abc"};
+    uint32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(Lax, PL)::operator>>(Char)", "A", Exits{4, "Lax scanner: Wiersz 1, pozycja 1: Wczytano 'A', oczekiwano jednego ze znakow: abc\n"}) {
+TEST("Scanner(Lax, PL)::operator>>(Num<uint>) addition overflow", "4294967296", Exits{4, "Lax scanner: Wiersz 1, pozycja 10: Liczba calkowita spoza zakresu\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    char c;
-    s >> oi::Char{c, "abc"};
+    uint32_t x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(UserOutput, EN)::operator>>(Char)", " a", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(UserOutput)::operator>>(Num<uint>)", "255 256 257", Exits{0, "OK\n\n100\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    char c;
-    s >> oi::Char{c, "abc"};
-    if (c != 'a') { std::terminate(); }
+    uint32_t x;
+    s >> oi::Num{x, 255, 257} >> ' ';
+    if (x != 255) { std::terminate(); }
+    s >> oi::Num{x, 255, 257} >> ' ';
+    if (x != 256) { std::terminate(); }
+    s >> oi::Num{x, 255, 257};
+    if (x != 257) { std::terminate(); }
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput, PL)::operator>>(Char)", " a", Exits{0, "OK\n\n100\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    char c;
-    s >> oi::Char{c, "abc"};
-    if (c != 'a') { std::terminate(); }
+TEST("Scanner(TestInput)::operator>>(Num<uint>)", "255 256 257", Exits{0, ""}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    uint32_t x;
+    s >> oi::Num{x, 255, 257} >> ' ';
+    if (x != 255) { std::terminate(); }
+    s >> oi::Num{x, 255, 257} >> ' ';
+    if (x != 256) { std::terminate(); }
+    s >> oi::Num{x, 255, 257};
+    if (x != 257) { std::terminate(); }
+    oi::inwer_verdict.exit_ok();
+}
+
+TEST("Scanner(Lax)::operator>>(Num<uint>)", "255 256 257", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
+    uint32_t x;
+    s >> oi::Num{x, 255, 257} >> ' ';
+    if (x != 255) { std::terminate(); }
+    s >> oi::Num{x, 255, 257} >> ' ';
+    if (x != 256) { std::terminate(); }
+    s >> oi::Num{x, 255, 257};
+    if (x != 257) { std::terminate(); }
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(Char)", " a", Exits{1, "Line 1, position 1: Read ' ', expected one of characters: abc\n"}) {
+TEST("Scanner(UserOutput, EN)::operator>>(Num<uint>)", "6", Exits{0, "WRONG\nLine 1, position 1: Integer value out of range\n0\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    uint32_t x;
+    s >> oi::Num{x, 7, 77};
+}
+
+TEST("Scanner(UserOutput, PL)::operator>>(Num<uint>)", "6", Exits{0, "WRONG\nWiersz 1, pozycja 1: Liczba calkowita spoza zakresu\n0\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
+    uint32_t x;
+    s >> oi::Num{x, 7, 77};
+}
+
+TEST("Scanner(TestInput, EN)::operator>>(Num<uint>)", "6", Exits{1, "Line 1, position 1: Integer value out of range\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    char c;
-    s >> oi::Char{c, "abc"};
+    uint32_t x;
+    s >> oi::Num{x, 7, 77};
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(Char)", " a", Exits{1, "Wiersz 1, pozycja 1: Wczytano ' ', oczekiwano jednego ze znakow: abc\n"}) {
+TEST("Scanner(TestInput, PL)::operator>>(Num<uint>)", "6", Exits{1, "Wiersz 1, pozycja 1: Liczba calkowita spoza zakresu\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    char c;
-    s >> oi::Char{c, "abc"};
+    uint32_t x;
+    s >> oi::Num{x, 7, 77};
 }
 
-TEST("Scanner(Lax, EN)::operator>>(Char)", " a", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(Lax, EN)::operator>>(Num<uint>)", "6", Exits{4, "Lax scanner: Line 1, position 1: Integer value out of range\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    char c;
-    s >> oi::Char{c, "abc"};
-    if (c != 'a') { std::terminate(); }
-    oi::checker_verdict.exit_ok();
+    uint32_t x;
+    s >> oi::Num{x, 7, 77};
 }
 
-TEST("Scanner(Lax, PL)::operator>>(Char)", " a", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(Lax, PL)::operator>>(Num<uint>)", "6", Exits{4, "Lax scanner: Wiersz 1, pozycja 1: Liczba calkowita spoza zakresu\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    char c;
-    s >> oi::Char{c, "abc"};
-    if (c != 'a') { std::terminate(); }
-    oi::checker_verdict.exit_ok();
+    uint32_t x;
+    s >> oi::Num{x, 7, 77};
 }
 
-TEST("Scanner(UserOutput, EN)::operator>>(Num<int>)", "", Exits{0, "WRONG\nLine 1, position 1: Read EOF, expected a number\n0\n"}) {
+TEST("Scanner(UserOutput, EN)::operator>>(Num<uint>)", "78", Exits{0, "WRONG\nLine 1, position 2: Integer value out of range\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    int32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    uint32_t x;
+    s >> oi::Num{x, 7, 77};
 }
 
-TEST("Scanner(UserOutput, PL)::operator>>(Num<int>)", "", Exits{0, "WRONG\nWiersz 1, pozycja 1: Wczytano EOF, oczekiwano liczby\n0\n"}) {
+TEST("Scanner(UserOutput, PL)::operator>>(Num<uint>)", "78", Exits{0, "WRONG\nWiersz 1, pozycja 2: Liczba calkowita spoza zakresu\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    int32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    uint32_t x;
+    s >> oi::Num{x, 7, 77};
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(Num<int>)", "", Exits{1, "Line 1, position 1: Read EOF, expected a number\n"}) {
+TEST("Scanner(TestInput, EN)::operator>>(Num<uint>)", "78", Exits{1, "Line 1, position 2: Integer value out of range\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    int32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    uint32_t x;
+    s >> oi::Num{x, 7, 77};
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(Num<int>)", "", Exits{1, "Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano liczby\n"}) {
+TEST("Scanner(TestInput, PL)::operator>>(Num<uint>)", "78", Exits{1, "Wiersz 1, pozycja 2: Liczba calkowita spoza zakresu\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    int32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    uint32_t x;
+    s >> oi::Num{x, 7, 77};
 }
 
-TEST("Scanner(Lax, EN)::operator>>(Num<int>)", "", Exits{4, "Lax scanner: Line 1, position 1: Read EOF, expected a number\n"}) {
+TEST("Scanner(Lax, EN)::operator>>(Num<uint>)", "78", Exits{4, "Lax scanner: Line 1, position 2: Integer value out of range\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    int32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    uint32_t x;
+    s >> oi::Num{x, 7, 77};
 }
 
-TEST("Scanner(Lax, PL)::operator>>(Num<int>)", "", Exits{4, "Lax scanner: Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano liczby\n"}) {
+TEST("Scanner(Lax, PL)::operator>>(Num<uint>)", "78", Exits{4, "Lax scanner: Wiersz 1, pozycja 2: Liczba calkowita spoza zakresu\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    int32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    uint32_t x;
+    s >> oi::Num{x, 7, 77};
 }
 
-TEST("Scanner(UserOutput, EN)::operator>>(Num<int>)", "-", Exits{0, "WRONG\nLine 1, position 2: Read EOF, expected a number\n0\n"}) {
+TEST("Scanner(UserOutput, EN)::operator>>(Num<uint>) whitespace is ignored", " 0", Exits{0, "OK\n\n100\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    int32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    uint32_t x;
+    s >> oi::Num{x, 0, 0};
+    if (x != 0) { std::terminate(); }
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput, PL)::operator>>(Num<int>)", "-", Exits{0, "WRONG\nWiersz 1, pozycja 2: Wczytano EOF, oczekiwano liczby\n0\n"}) {
+TEST("Scanner(UserOutput, PL)::operator>>(Num<uint>) whitespace is ignored", " 0", Exits{0, "OK\n\n100\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    int32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    uint32_t x;
+    s >> oi::Num{x, 0, 0};
+    if (x != 0) { std::terminate(); }
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(Num<int>)", "-", Exits{1, "Line 1, position 2: Read EOF, expected a number\n"}) {
+TEST("Scanner(TestInput, EN)::operator>>(Num<uint>) whitespace is not ignored", " 0", Exits{1, "Line 1, position 1: Read ' ', expected a number\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    int32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    uint32_t x;
+    s >> oi::Num{x, 0, 0};
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(Num<int>)", "-", Exits{1, "Wiersz 1, pozycja 2: Wczytano EOF, oczekiwano liczby\n"}) {
+TEST("Scanner(TestInput, PL)::operator>>(Num<uint>) whitespace is not ignored", " 0", Exits{1, "Wiersz 1, pozycja 1: Wczytano ' ', oczekiwano liczby\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    int32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    uint32_t x;
+    s >> oi::Num{x, 0, 0};
 }
 
-TEST("Scanner(Lax, EN)::operator>>(Num<int>)", "-", Exits{4, "Lax scanner: Line 1, position 2: Read EOF, expected a number\n"}) {
+TEST("Scanner(Lax, EN)::operator>>(Num<uint>) whitespace is ignored", " 0", Exits{0, "OK\n\n100\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    int32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    uint32_t x;
+    s >> oi::Num{x, 0, 0};
+    if (x != 0) { std::terminate(); }
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(Lax, PL)::operator>>(Num<int>)", "-", Exits{4, "Lax scanner: Wiersz 1, pozycja 2: Wczytano EOF, oczekiwano liczby\n"}) {
+TEST("Scanner(Lax, PL)::operator>>(Num<uint>) whitespace is ignored", " 0", Exits{0, "OK\n\n100\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    int32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    uint32_t x;
+    s >> oi::Num{x, 0, 0};
+    if (x != 0) { std::terminate(); }
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput)::operator>>(Num<int>)", "0\n42\n-1337\n-2147483648\n2147483647", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(UserOutput)::operator>>(Num<double>)", R"(0
+-0
+3141592653589793238462643383279502
+-3141592653589793238462643383279502
+0.0000000000000000000000000003141592653589793238462643383279502
+-0.0000000000000000000000000003141592653589793238462643383279502
+3141592.653589793238462643383279502
+-3141592.653589793238462643383279502
+)", Exits{0, "OK\n\n100\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    int32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    double x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
     if (x != 0) { std::terminate(); }
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()} >> '\n';
-    if (x != 42) { std::terminate(); }
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()} >> '\n';
-    if (x != -1337) { std::terminate(); }
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()} >> '\n';
-    if (x != -2147483648) { std::terminate(); }
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
-    if (x != 2147483647) { std::terminate(); }
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    if (x != 0) { std::terminate(); }
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    if (std::abs(1 - x / 3141592653589793238462643383279502.0) > 1e-12) { std::terminate(); }
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    if (std::abs(1 - x / -3141592653589793238462643383279502.0) > 1e-12) { std::terminate(); }
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    if (std::abs(1 - x / 0.0000000000000000000000000003141592653589793238462643383279502) > 1e-12) { std::terminate(); }
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    if (std::abs(1 - x / -0.0000000000000000000000000003141592653589793238462643383279502) > 1e-12) { std::terminate(); }
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    if (std::abs(1 - x / 3141592.653589793238462643383279502) > 1e-12) { std::terminate(); }
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    if (std::abs(1 - x / -3141592.653589793238462643383279502) > 1e-12) { std::terminate(); }
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput)::operator>>(Num<int>)", "0\n42\n-1337\n-2147483648\n2147483647", Exits{0, ""}) {
+TEST("Scanner(TestInput)::operator>>(Num<double>)", R"(0
+-0
+3141592653589793238462643383279502
+-3141592653589793238462643383279502
+0.0000000000000000000000000003141592653589793238462643383279502
+-0.0000000000000000000000000003141592653589793238462643383279502
+3141592.653589793238462643383279502
+-3141592.653589793238462643383279502
+)", Exits{0, ""}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    int32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    double x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
     if (x != 0) { std::terminate(); }
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()} >> '\n';
-    if (x != 42) { std::terminate(); }
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()} >> '\n';
-    if (x != -1337) { std::terminate(); }
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()} >> '\n';
-    if (x != -2147483648) { std::terminate(); }
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
-    if (x != 2147483647) { std::terminate(); }
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    if (x != 0) { std::terminate(); }
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    if (std::abs(1 - x / 3141592653589793238462643383279502.0) > 1e-12) { std::terminate(); }
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    if (std::abs(1 - x / -3141592653589793238462643383279502.0) > 1e-12) { std::terminate(); }
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    if (std::abs(1 - x / 0.0000000000000000000000000003141592653589793238462643383279502) > 1e-12) { std::terminate(); }
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    if (std::abs(1 - x / -0.0000000000000000000000000003141592653589793238462643383279502) > 1e-12) { std::terminate(); }
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    if (std::abs(1 - x / 3141592.653589793238462643383279502) > 1e-12) { std::terminate(); }
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    if (std::abs(1 - x / -3141592.653589793238462643383279502) > 1e-12) { std::terminate(); }
     oi::inwer_verdict.exit_ok();
 }
 
-TEST("Scanner(Lax)::operator>>(Num<int>)", "0\n42\n-1337\n-2147483648\n2147483647", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(Lax)::operator>>(Num<double>)", R"(0
+-0
+3141592653589793238462643383279502
+-3141592653589793238462643383279502
+0.0000000000000000000000000003141592653589793238462643383279502
+-0.0000000000000000000000000003141592653589793238462643383279502
+3141592.653589793238462643383279502
+-3141592.653589793238462643383279502
+)", Exits{0, "OK\n\n100\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    int32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    double x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
     if (x != 0) { std::terminate(); }
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()} >> '\n';
-    if (x != 42) { std::terminate(); }
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()} >> '\n';
-    if (x != -1337) { std::terminate(); }
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()} >> '\n';
-    if (x != -2147483648) { std::terminate(); }
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
-    if (x != 2147483647) { std::terminate(); }
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    if (x != 0) { std::terminate(); }
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    if (std::abs(1 - x / 3141592653589793238462643383279502.0) > 1e-12) { std::terminate(); }
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    if (std::abs(1 - x / -3141592653589793238462643383279502.0) > 1e-12) { std::terminate(); }
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    if (std::abs(1 - x / 0.0000000000000000000000000003141592653589793238462643383279502) > 1e-12) { std::terminate(); }
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    if (std::abs(1 - x / -0.0000000000000000000000000003141592653589793238462643383279502) > 1e-12) { std::terminate(); }
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    if (std::abs(1 - x / 3141592.653589793238462643383279502) > 1e-12) { std::terminate(); }
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
+    if (std::abs(1 - x / -3141592.653589793238462643383279502) > 1e-12) { std::terminate(); }
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput, EN)::operator>>(Num<int>) multiply by 10 negative overflow", "-21474836480", Exits{0, "WRONG\nLine 1, position 12: Integer value out of range\n0\n"}) {
+TEST("Scanner(UserOutput, EN)::operator>>(Num<double>)", "", Exits{0, "WRONG\nLine 1, position 1: Read EOF, expected a number\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    int32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    double x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(UserOutput, PL)::operator>>(Num<int>) multiply by 10 negative overflow", "-21474836480", Exits{0, "WRONG\nWiersz 1, pozycja 12: Liczba calkowita spoza zakresu\n0\n"}) {
+TEST("Scanner(UserOutput, PL)::operator>>(Num<double>)", "", Exits{0, "WRONG\nWiersz 1, pozycja 1: Wczytano EOF, oczekiwano liczby\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    int32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    double x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(Num<int>) multiply by 10 negative overflow", "-21474836480", Exits{1, "Line 1, position 12: Integer value out of range\n"}) {
+TEST("Scanner(TestInput, EN)::operator>>(Num<double>)", "", Exits{1, "Line 1, position 1: Read EOF, expected a number\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    int32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    double x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(Num<int>) multiply by 10 negative overflow", "-21474836480", Exits{1, "Wiersz 1, pozycja 12: Liczba calkowita spoza zakresu\n"}) {
+TEST("Scanner(TestInput, PL)::operator>>(Num<double>)", "", Exits{1, "Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano liczby\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    int32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    double x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(Lax, EN)::operator>>(Num<int>) multiply by 10 negative overflow", "-21474836480", Exits{4, "Lax scanner: Line 1, position 12: Integer value out of range\n"}) {
+TEST("Scanner(Lax, EN)::operator>>(Num<double>)", "", Exits{4, "Lax scanner: Line 1, position 1: Read EOF, expected a number\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    int32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    double x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(Lax, PL)::operator>>(Num<int>) multiply by 10 negative overflow", "-21474836480", Exits{4, "Lax scanner: Wiersz 1, pozycja 12: Liczba calkowita spoza zakresu\n"}) {
+TEST("Scanner(Lax, PL)::operator>>(Num<double>)", "", Exits{4, "Lax scanner: Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano liczby\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    int32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    double x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(UserOutput, EN)::operator>>(Num<int>) multiply by 10 positive overflow", "21474836470", Exits{0, "WRONG\nLine 1, position 11: Integer value out of range\n0\n"}) {
+TEST("Scanner(UserOutput, EN)::operator>>(Num<double>)", "-", Exits{0, "WRONG\nLine 1, position 2: Read EOF, expected a number\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    int32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    double x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(UserOutput, PL)::operator>>(Num<int>) multiply by 10 positive overflow", "21474836470", Exits{0, "WRONG\nWiersz 1, pozycja 11: Liczba calkowita spoza zakresu\n0\n"}) {
+TEST("Scanner(UserOutput, PL)::operator>>(Num<double>)", "-", Exits{0, "WRONG\nWiersz 1, pozycja 2: Wczytano EOF, oczekiwano liczby\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    int32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    double x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(Num<int>) multiply by 10 positive overflow", "21474836470", Exits{1, "Line 1, position 11: Integer value out of range\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    int32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+TEST("Scanner(TestInput, EN)::operator>>(Num<double>)", "-", Exits{1, "Line 1, position 2: Read EOF, expected a number\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    double x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(Num<int>) multiply by 10 positive overflow", "21474836470", Exits{1, "Wiersz 1, pozycja 11: Liczba calkowita spoza zakresu\n"}) {
+TEST("Scanner(TestInput, PL)::operator>>(Num<double>)", "-", Exits{1, "Wiersz 1, pozycja 2: Wczytano EOF, oczekiwano liczby\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    int32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    double x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(Lax, EN)::operator>>(Num<int>) multiply by 10 positive overflow", "21474836470", Exits{4, "Lax scanner: Line 1, position 11: Integer value out of range\n"}) {
+TEST("Scanner(Lax, EN)::operator>>(Num<double>)", "-", Exits{4, "Lax scanner: Line 1, position 2: Read EOF, expected a number\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    int32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    double x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(Lax, PL)::operator>>(Num<int>) multiply by 10 positive overflow", "21474836470", Exits{4, "Lax scanner: Wiersz 1, pozycja 11: Liczba calkowita spoza zakresu\n"}) {
+TEST("Scanner(Lax, PL)::operator>>(Num<double>)", "-", Exits{4, "Lax scanner: Wiersz 1, pozycja 2: Wczytano EOF, oczekiwano liczby\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    int32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    double x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(UserOutput, EN)::operator>>(Num<int>) addition positive overflow", "2147483648", Exits{0, "WRONG\nLine 1, position 10: Integer value out of range\n0\n"}) {
+TEST("Scanner(UserOutput, EN)::operator>>(Num<double>) positive overflow", "999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999", Exits{0, "WRONG\nLine 1, position 309: Real number value out of range\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    int32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    double x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(UserOutput, PL)::operator>>(Num<int>) addition positive overflow", "2147483648", Exits{0, "WRONG\nWiersz 1, pozycja 10: Liczba calkowita spoza zakresu\n0\n"}) {
+TEST("Scanner(UserOutput, PL)::operator>>(Num<double>) positive overflow", "999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999", Exits{0, "WRONG\nWiersz 1, pozycja 309: Liczba rzeczywista spoza zakresu\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    int32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    double x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(Num<int>) addition positive overflow", "2147483648", Exits{1, "Line 1, position 10: Integer value out of range\n"}) {
+TEST("Scanner(TestInput, EN)::operator>>(Num<double>) positive overflow", "999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999", Exits{1, "Line 1, position 309: Real number value out of range\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    int32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    double x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(Num<int>) addition positive overflow", "2147483648", Exits{1, "Wiersz 1, pozycja 10: Liczba calkowita spoza zakresu\n"}) {
+TEST("Scanner(TestInput, PL)::operator>>(Num<double>) positive overflow", "999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999", Exits{1, "Wiersz 1, pozycja 309: Liczba rzeczywista spoza zakresu\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    int32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    double x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(Lax, EN)::operator>>(Num<int>) addition positive overflow", "2147483648", Exits{4, "Lax scanner: Line 1, position 10: Integer value out of range\n"}) {
+TEST("Scanner(Lax, EN)::operator>>(Num<double>) positive overflow", "999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999", Exits{4, "Lax scanner: Line 1, position 309: Real number value out of range\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    int32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    double x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(Lax, PL)::operator>>(Num<int>) addition positive overflow", "2147483648", Exits{4, "Lax scanner: Wiersz 1, pozycja 10: Liczba calkowita spoza zakresu\n"}) {
+TEST("Scanner(Lax, PL)::operator>>(Num<double>) positive overflow", "999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999", Exits{4, "Lax scanner: Wiersz 1, pozycja 309: Liczba rzeczywista spoza zakresu\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    int32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    double x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(UserOutput, EN)::operator>>(Num<int>) addition negative overflow", "-2147483649", Exits{0, "WRONG\nLine 1, position 11: Integer value out of range\n0\n"}) {
+TEST("Scanner(UserOutput, EN)::operator>>(Num<double>) negative overflow", "-999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999", Exits{0, "WRONG\nLine 1, position 310: Real number value out of range\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    int32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    double x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(UserOutput, PL)::operator>>(Num<int>) addition negative overflow", "-2147483649", Exits{0, "WRONG\nWiersz 1, pozycja 11: Liczba calkowita spoza zakresu\n0\n"}) {
+TEST("Scanner(UserOutput, PL)::operator>>(Num<double>) negative overflow", "-999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999", Exits{0, "WRONG\nWiersz 1, pozycja 310: Liczba rzeczywista spoza zakresu\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    int32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    double x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(Num<int>) addition negative overflow", "-2147483649", Exits{1, "Line 1, position 11: Integer value out of range\n"}) {
+TEST("Scanner(TestInput, EN)::operator>>(Num<double>) negative overflow", "-999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999", Exits{1, "Line 1, position 310: Real number value out of range\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    int32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    double x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(Num<int>) addition negative overflow", "-2147483649", Exits{1, "Wiersz 1, pozycja 11: Liczba calkowita spoza zakresu\n"}) {
+TEST("Scanner(TestInput, PL)::operator>>(Num<double>) negative overflow", "-999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999", Exits{1, "Wiersz 1, pozycja 310: Liczba rzeczywista spoza zakresu\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    int32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    double x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(Lax, EN)::operator>>(Num<int>) addition negative overflow", "-2147483649", Exits{4, "Lax scanner: Line 1, position 11: Integer value out of range\n"}) {
+TEST("Scanner(Lax, EN)::operator>>(Num<double>) negative overflow", "-999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999", Exits{4, "Lax scanner: Line 1, position 310: Real number value out of range\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    int32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    double x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(Lax, PL)::operator>>(Num<int>) addition negative overflow", "-2147483649", Exits{4, "Lax scanner: Wiersz 1, pozycja 11: Liczba calkowita spoza zakresu\n"}) {
+TEST("Scanner(Lax, PL)::operator>>(Num<double>) negative overflow", "-999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999", Exits{4, "Lax scanner: Wiersz 1, pozycja 310: Liczba rzeczywista spoza zakresu\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    int32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    double x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
 }
 
-TEST("Scanner(UserOutput)::operator>>(Num<int>)", "255 256 257", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(UserOutput)::operator>>(Num<double>)", R"(0
+-0
+3141592653589793238462643383279502
+-3141592653589793238462643383279502
+0.0000000000000000000000000003141592653589793238462643383279502
+-0.0000000000000000000000000003141592653589793238462643383279502
+3141592.653589793238462643383279502
+-3141592.653589793238462643383279502
+)", Exits{0, "OK\n\n100\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    int32_t x;
-    s >> oi::Num{x, 255, 257} >> ' ';
-    if (x != 255) { std::terminate(); }
-    s >> oi::Num{x, 255, 257} >> ' ';
-    if (x != 256) { std::terminate(); }
-    s >> oi::Num{x, 255, 257};
-    if (x != 257) { std::terminate(); }
+    double x;
+    s >> oi::Num{x, 0, 0} >> '\n';
+    s >> oi::Num{x, 0, 0} >> '\n';
+    s >> oi::Num{x, 3141592653580000000000000000000000.0, 3141592653590000000000000000000000.0} >> '\n';
+    s >> oi::Num{x, -3141592653590000000000000000000000.0, -3141592653580000000000000000000000.0} >> '\n';
+    s >> oi::Num{x, 0.000000000000000000000000000314159265358, 0.000000000000000000000000000314159265359} >> '\n';
+    s >> oi::Num{x, -0.000000000000000000000000000314159265359, -0.000000000000000000000000000314159265358} >> '\n';
+    s >> oi::Num{x, 3141592.65358, 3141592.65359} >> '\n';
+    s >> oi::Num{x, -3141592.65359, -3141592.65358} >> '\n';
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput)::operator>>(Num<int>)", "255 256 257", Exits{0, ""}) {
+TEST("Scanner(TestInput)::operator>>(Num<double>)", R"(0
+-0
+3141592653589793238462643383279502
+-3141592653589793238462643383279502
+0.0000000000000000000000000003141592653589793238462643383279502
+-0.0000000000000000000000000003141592653589793238462643383279502
+3141592.653589793238462643383279502
+-3141592.653589793238462643383279502
+)", Exits{0, ""}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    int32_t x;
-    s >> oi::Num{x, 255, 257} >> ' ';
-    if (x != 255) { std::terminate(); }
-    s >> oi::Num{x, 255, 257} >> ' ';
-    if (x != 256) { std::terminate(); }
-    s >> oi::Num{x, 255, 257};
-    if (x != 257) { std::terminate(); }
+    double x;
+    s >> oi::Num{x, 0, 0} >> '\n';
+    s >> oi::Num{x, 0, 0} >> '\n';
+    s >> oi::Num{x, 3141592653580000000000000000000000.0, 3141592653590000000000000000000000.0} >> '\n';
+    s >> oi::Num{x, -3141592653590000000000000000000000.0, -3141592653580000000000000000000000.0} >> '\n';
+    s >> oi::Num{x, 0.000000000000000000000000000314159265358, 0.000000000000000000000000000314159265359} >> '\n';
+    s >> oi::Num{x, -0.000000000000000000000000000314159265359, -0.000000000000000000000000000314159265358} >> '\n';
+    s >> oi::Num{x, 3141592.65358, 3141592.65359} >> '\n';
+    s >> oi::Num{x, -3141592.65359, -3141592.65358} >> '\n';
     oi::inwer_verdict.exit_ok();
 }
 
-TEST("Scanner(Lax)::operator>>(Num<int>)", "255 256 257", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(Lax)::operator>>(Num<double>)", R"(0
+-0
+3141592653589793238462643383279502
+-3141592653589793238462643383279502
+0.0000000000000000000000000003141592653589793238462643383279502
+-0.0000000000000000000000000003141592653589793238462643383279502
+3141592.653589793238462643383279502
+-3141592.653589793238462643383279502
+)", Exits{0, "OK\n\n100\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    int32_t x;
-    s >> oi::Num{x, 255, 257} >> ' ';
-    if (x != 255) { std::terminate(); }
-    s >> oi::Num{x, 255, 257} >> ' ';
-    if (x != 256) { std::terminate(); }
-    s >> oi::Num{x, 255, 257};
-    if (x != 257) { std::terminate(); }
+    double x;
+    s >> oi::Num{x, 0, 0} >> '\n';
+    s >> oi::Num{x, 0, 0} >> '\n';
+    s >> oi::Num{x, 3141592653580000000000000000000000.0, 3141592653590000000000000000000000.0} >> '\n';
+    s >> oi::Num{x, -3141592653590000000000000000000000.0, -3141592653580000000000000000000000.0} >> '\n';
+    s >> oi::Num{x, 0.000000000000000000000000000314159265358, 0.000000000000000000000000000314159265359} >> '\n';
+    s >> oi::Num{x, -0.000000000000000000000000000314159265359, -0.000000000000000000000000000314159265358} >> '\n';
+    s >> oi::Num{x, 3141592.65358, 3141592.65359} >> '\n';
+    s >> oi::Num{x, -3141592.65359, -3141592.65358} >> '\n';
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput, EN)::operator>>(Num<int>)", "-8", Exits{0, "WRONG\nLine 1, position 2: Integer value out of range\n0\n"}) {
+TEST("Scanner(UserOutput, EN)::operator>>(Num<double>)", "3141592.653589793238462643383279502", Exits{0, "WRONG\nLine 1, position 35: Real number value out of range\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    int32_t x;
-    s >> oi::Num{x, -7, 7};
+    double x;
+    s >> oi::Num{x, 3141592.65359, std::numeric_limits<decltype(x)>::max()} >> '\n';
 }
 
-TEST("Scanner(UserOutput, PL)::operator>>(Num<int>)", "-8", Exits{0, "WRONG\nWiersz 1, pozycja 2: Liczba calkowita spoza zakresu\n0\n"}) {
+TEST("Scanner(UserOutput, PL)::operator>>(Num<double>)", "3141592.653589793238462643383279502", Exits{0, "WRONG\nWiersz 1, pozycja 35: Liczba rzeczywista spoza zakresu\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    int32_t x;
-    s >> oi::Num{x, -7, 7};
+    double x;
+    s >> oi::Num{x, 3141592.65359, std::numeric_limits<decltype(x)>::max()} >> '\n';
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(Num<int>)", "-8", Exits{1, "Line 1, position 2: Integer value out of range\n"}) {
+TEST("Scanner(TestInput, EN)::operator>>(Num<double>)", "3141592.653589793238462643383279502", Exits{1, "Line 1, position 35: Real number value out of range\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    int32_t x;
-    s >> oi::Num{x, -7, 7};
+    double x;
+    s >> oi::Num{x, 3141592.65359, std::numeric_limits<decltype(x)>::max()} >> '\n';
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(Num<int>)", "-8", Exits{1, "Wiersz 1, pozycja 2: Liczba calkowita spoza zakresu\n"}) {
+TEST("Scanner(TestInput, PL)::operator>>(Num<double>)", "3141592.653589793238462643383279502", Exits{1, "Wiersz 1, pozycja 35: Liczba rzeczywista spoza zakresu\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    int32_t x;
-    s >> oi::Num{x, -7, 7};
+    double x;
+    s >> oi::Num{x, 3141592.65359, std::numeric_limits<decltype(x)>::max()} >> '\n';
 }
 
-TEST("Scanner(Lax, EN)::operator>>(Num<int>)", "-8", Exits{4, "Lax scanner: Line 1, position 2: Integer value out of range\n"}) {
+TEST("Scanner(Lax, EN)::operator>>(Num<double>)", "3141592.653589793238462643383279502", Exits{4, "Lax scanner: Line 1, position 35: Real number value out of range\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    int32_t x;
-    s >> oi::Num{x, -7, 7};
+    double x;
+    s >> oi::Num{x, 3141592.65359, std::numeric_limits<decltype(x)>::max()} >> '\n';
 }
 
-TEST("Scanner(Lax, PL)::operator>>(Num<int>)", "-8", Exits{4, "Lax scanner: Wiersz 1, pozycja 2: Liczba calkowita spoza zakresu\n"}) {
+TEST("Scanner(Lax, PL)::operator>>(Num<double>)", "3141592.653589793238462643383279502", Exits{4, "Lax scanner: Wiersz 1, pozycja 35: Liczba rzeczywista spoza zakresu\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    int32_t x;
-    s >> oi::Num{x, -7, 7};
+    double x;
+    s >> oi::Num{x, 3141592.65359, std::numeric_limits<decltype(x)>::max()} >> '\n';
 }
 
-TEST("Scanner(UserOutput, EN)::operator>>(Num<int>)", "8", Exits{0, "WRONG\nLine 1, position 1: Integer value out of range\n0\n"}) {
+TEST("Scanner(UserOutput, EN)::operator>>(Num<double>)", "-3141592.653589793238462643383279502", Exits{0, "WRONG\nLine 1, position 36: Real number value out of range\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    int32_t x;
-    s >> oi::Num{x, -7, 7};
+    double x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), -3141592.65359} >> '\n';
 }
 
-TEST("Scanner(UserOutput, PL)::operator>>(Num<int>)", "8", Exits{0, "WRONG\nWiersz 1, pozycja 1: Liczba calkowita spoza zakresu\n0\n"}) {
+TEST("Scanner(UserOutput, PL)::operator>>(Num<double>)", "-3141592.653589793238462643383279502", Exits{0, "WRONG\nWiersz 1, pozycja 36: Liczba rzeczywista spoza zakresu\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    int32_t x;
-    s >> oi::Num{x, -7, 7};
+    double x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), -3141592.65359} >> '\n';
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(Num<int>)", "8", Exits{1, "Line 1, position 1: Integer value out of range\n"}) {
+TEST("Scanner(TestInput, EN)::operator>>(Num<double>)", "-3141592.653589793238462643383279502", Exits{1, "Line 1, position 36: Real number value out of range\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    int32_t x;
-    s >> oi::Num{x, -7, 7};
+    double x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), -3141592.65359} >> '\n';
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(Num<int>)", "8", Exits{1, "Wiersz 1, pozycja 1: Liczba calkowita spoza zakresu\n"}) {
+TEST("Scanner(TestInput, PL)::operator>>(Num<double>)", "-3141592.653589793238462643383279502", Exits{1, "Wiersz 1, pozycja 36: Liczba rzeczywista spoza zakresu\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    int32_t x;
-    s >> oi::Num{x, -7, 7};
+    double x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), -3141592.65359} >> '\n';
 }
 
-TEST("Scanner(Lax, EN)::operator>>(Num<int>)", "8", Exits{4, "Lax scanner: Line 1, position 1: Integer value out of range\n"}) {
+TEST("Scanner(Lax, EN)::operator>>(Num<double>)", "-3141592.653589793238462643383279502", Exits{4, "Lax scanner: Line 1, position 36: Real number value out of range\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    int32_t x;
-    s >> oi::Num{x, -7, 7};
+    double x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), -3141592.65359} >> '\n';
 }
 
-TEST("Scanner(Lax, PL)::operator>>(Num<int>)", "8", Exits{4, "Lax scanner: Wiersz 1, pozycja 1: Liczba calkowita spoza zakresu\n"}) {
+TEST("Scanner(Lax, PL)::operator>>(Num<double>)", "-3141592.653589793238462643383279502", Exits{4, "Lax scanner: Wiersz 1, pozycja 36: Liczba rzeczywista spoza zakresu\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    int32_t x;
-    s >> oi::Num{x, -7, 7};
+    double x;
+    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), -3141592.65359} >> '\n';
 }
 
-TEST("Scanner(UserOutput, EN)::operator>>(Num<int>) whitespace is ignored", " 0", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(UserOutput, EN)::operator>>(Num<double>) whitespace is ignored", " 0", Exits{0, "OK\n\n100\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    int32_t x;
+    double x;
     s >> oi::Num{x, 0, 0};
     if (x != 0) { std::terminate(); }
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput, PL)::operator>>(Num<int>) whitespace is ignored", " 0", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(UserOutput, PL)::operator>>(Num<double>) whitespace is ignored", " 0", Exits{0, "OK\n\n100\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    int32_t x;
+    double x;
     s >> oi::Num{x, 0, 0};
     if (x != 0) { std::terminate(); }
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(Num<int>) whitespace is not ignored", " 0", Exits{1, "Line 1, position 1: Read ' ', expected a number\n"}) {
+TEST("Scanner(TestInput, EN)::operator>>(Num<double>) whitespace is not ignored", " 0", Exits{1, "Line 1, position 1: Read ' ', expected a number\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    int32_t x;
+    double x;
     s >> oi::Num{x, 0, 0};
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(Num<int>) whitespace is not ignored", " 0", Exits{1, "Wiersz 1, pozycja 1: Wczytano ' ', oczekiwano liczby\n"}) {
+TEST("Scanner(TestInput, PL)::operator>>(Num<double>) whitespace is not ignored", " 0", Exits{1, "Wiersz 1, pozycja 1: Wczytano ' ', oczekiwano liczby\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    int32_t x;
+    double x;
     s >> oi::Num{x, 0, 0};
 }
 
-TEST("Scanner(Lax, EN)::operator>>(Num<int>) whitespace is ignored", " 0", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(Lax, EN)::operator>>(Num<double>) whitespace is ignored", " 0", Exits{0, "OK\n\n100\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    int32_t x;
+    double x;
     s >> oi::Num{x, 0, 0};
     if (x != 0) { std::terminate(); }
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(Lax, PL)::operator>>(Num<int>) whitespace is ignored", " 0", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(Lax, PL)::operator>>(Num<double>) whitespace is ignored", " 0", Exits{0, "OK\n\n100\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    int32_t x;
+    double x;
     s >> oi::Num{x, 0, 0};
     if (x != 0) { std::terminate(); }
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput, EN)::operator>>(Num<uint>)", "", Exits{0, "WRONG\nLine 1, position 1: Read EOF, expected a number\n0\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    uint32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+TEST("Scanner(UserOutput, EN)::~Scanner() scans eof", "a", Exits{0, "WRONG\nLine 1, position 1: Read 'a', expected EOF\n0\n"}) {
+    oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
 }
 
-TEST("Scanner(UserOutput, PL)::operator>>(Num<uint>)", "", Exits{0, "WRONG\nWiersz 1, pozycja 1: Wczytano EOF, oczekiwano liczby\n0\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    uint32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+TEST("Scanner(UserOutput, PL)::~Scanner() scans eof", "a", Exits{0, "WRONG\nWiersz 1, pozycja 1: Wczytano 'a', oczekiwano EOF\n0\n"}) {
+    oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(Num<uint>)", "", Exits{1, "Line 1, position 1: Read EOF, expected a number\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    uint32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+TEST("Scanner(TestInput, EN)::~Scanner() scans eof", "a", Exits{1, "Line 1, position 1: Read 'a', expected EOF\n"}) {
+    oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(Num<uint>)", "", Exits{1, "Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano liczby\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    uint32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+TEST("Scanner(TestInput, PL)::~Scanner() scans eof", "a", Exits{1, "Wiersz 1, pozycja 1: Wczytano 'a', oczekiwano EOF\n"}) {
+    oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
 }
 
-TEST("Scanner(Lax, EN)::operator>>(Num<uint>)", "", Exits{4, "Lax scanner: Line 1, position 1: Read EOF, expected a number\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    uint32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+TEST("Scanner(UserOutput, EN)::~Scanner() scans eof during unwinding", "1 a", Exits{0, "WRONG\nLine 1, position 3: Read 'a', expected EOF\n0\n"}) {
+    try {
+        auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+        int x;
+        s >> oi::Num{x, 1, 1};
+        throw std::runtime_error{"handled by the program"};
+    } catch (const std::runtime_error&) {
+    }
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(Lax, PL)::operator>>(Num<uint>)", "", Exits{4, "Lax scanner: Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano liczby\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    uint32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+TEST("Scanner(Lax)::~Scanner() does not scan eof", "a", Exits{0, "OK\n\n100\n"}) {
+    oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput, EN)::operator>>(Num<uint>)", "-", Exits{0, "WRONG\nLine 1, position 1: Read '-', expected a non-negative number\n0\n"}) {
+#undef exit
+TEST("Scanner(UserOutput, EN) exit() scans eof", "a", Exits{0, "WRONG\nLine 1, position 1: Read 'a', expected EOF\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    uint32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    exit(42);
 }
 
-TEST("Scanner(UserOutput, PL)::operator>>(Num<uint>)", "-", Exits{0, "WRONG\nWiersz 1, pozycja 1: Wczytano '-', oczekiwano nieujemnej liczby\n0\n"}) {
+TEST("Scanner(UserOutput, PL) exit() scans eof", "a", Exits{0, "WRONG\nWiersz 1, pozycja 1: Wczytano 'a', oczekiwano EOF\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    uint32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    exit(42);
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(Num<uint>)", "-", Exits{1, "Line 1, position 1: Read '-', expected a non-negative number\n"}) {
+TEST("Scanner(TestInput, EN) exit() scans eof", "a", Exits{1, "Line 1, position 1: Read 'a', expected EOF\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    uint32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    exit(42);
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(Num<uint>)", "-", Exits{1, "Wiersz 1, pozycja 1: Wczytano '-', oczekiwano nieujemnej liczby\n"}) {
+TEST("Scanner(TestInput, PL) exit() scans eof", "a", Exits{1, "Wiersz 1, pozycja 1: Wczytano 'a', oczekiwano EOF\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    uint32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    exit(42);
 }
 
-TEST("Scanner(Lax, EN)::operator>>(Num<uint>)", "-", Exits{4, "Lax scanner: Line 1, position 1: Read '-', expected a non-negative number\n"}) {
+TEST("Scanner(Lax) exit() does not scan eof", "a", Exits{42, ""}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    uint32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    exit(42);
 }
 
-TEST("Scanner(Lax, PL)::operator>>(Num<uint>)", "-", Exits{4, "Lax scanner: Wiersz 1, pozycja 1: Wczytano '-', oczekiwano nieujemnej liczby\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    uint32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+TEST("Scanner(UserOutput, EN) checker_verdict.exit_ok() scans eof", "a", Exits{0, "WRONG\nLine 1, position 1: Read 'a', expected EOF\n0\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput)::operator>>(Num<uint>)", "0\n42\n4294967295", Exits{0, "OK\n\n100\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    uint32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()} >> '\n';
-    if (x != 0) { std::terminate(); }
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()} >> '\n';
-    if (x != 42) { std::terminate(); }
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
-    if (x != 4294967295) { std::terminate(); }
+TEST("Scanner(UserOutput, PL) checker_verdict.exit_ok() scans eof", "a", Exits{0, "WRONG\nWiersz 1, pozycja 1: Wczytano 'a', oczekiwano EOF\n0\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput)::operator>>(Num<uint>)", "0\n42\n4294967295", Exits{0, ""}) {
+TEST("Scanner(TestInput, EN) inwer_verdict.ok() scans eof", "a", Exits{1, "Line 1, position 1: Read 'a', expected EOF\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    uint32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()} >> '\n';
-    if (x != 0) { std::terminate(); }
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()} >> '\n';
-    if (x != 42) { std::terminate(); }
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
-    if (x != 4294967295) { std::terminate(); }
     oi::inwer_verdict.exit_ok();
 }
 
-TEST("Scanner(Lax)::operator>>(Num<uint>)", "0\n42\n4294967295", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(TestInput, PL) inwer_verdict.ok() scans eof", "a", Exits{1, "Wiersz 1, pozycja 1: Wczytano 'a', oczekiwano EOF\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    oi::inwer_verdict.exit_ok();
+}
+
+TEST("Scanner(Lax) checker_verdict.exit_ok() does not scan eof", "a", Exits{0, "OK\n\n100\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    uint32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()} >> '\n';
-    if (x != 0) { std::terminate(); }
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()} >> '\n';
-    if (x != 42) { std::terminate(); }
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
-    if (x != 4294967295) { std::terminate(); }
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput, EN)::operator>>(Num<uint>) multiply by 10 overflow", "42949672950", Exits{0, "WRONG\nLine 1, position 11: Integer value out of range\n0\n"}) {
+TEST("Scanner(UserOutput, EN) checker_verdict.exit_ok_with_score(100, msg) scans eof", "a", Exits{0, "WRONG\nLine 1, position 1: Read 'a', expected EOF\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    uint32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    oi::checker_verdict.exit_ok_with_score(100, "abc");
 }
 
-TEST("Scanner(UserOutput, PL)::operator>>(Num<uint>) multiply by 10 overflow", "42949672950", Exits{0, "WRONG\nWiersz 1, pozycja 11: Liczba calkowita spoza zakresu\n0\n"}) {
+TEST("Scanner(UserOutput, PL) checker_verdict.exit_ok_with_score(100, msg) scans eof", "a", Exits{0, "WRONG\nWiersz 1, pozycja 1: Wczytano 'a', oczekiwano EOF\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    uint32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    oi::checker_verdict.exit_ok_with_score(100, "abc");
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(Num<uint>) multiply by 10 overflow", "42949672950", Exits{1, "Line 1, position 11: Integer value out of range\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    uint32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+TEST("Scanner(Lax) checker_verdict.exit_ok_with_score(100, msg) does not scan eof", "a", Exits{0, "OK\nabc\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
+    oi::checker_verdict.exit_ok_with_score(100, "abc");
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(Num<uint>) multiply by 10 overflow", "42949672950", Exits{1, "Wiersz 1, pozycja 11: Liczba calkowita spoza zakresu\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    uint32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+TEST("Scanner(UserOutput) checker_verdict.exit_ok_with_score(99, msg) does not scan eof", "a", Exits{0, "OK\nabc\n99\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    oi::checker_verdict.exit_ok_with_score(99, "abc");
 }
 
-TEST("Scanner(Lax, EN)::operator>>(Num<uint>) multiply by 10 overflow", "42949672950", Exits{4, "Lax scanner: Line 1, position 11: Integer value out of range\n"}) {
+TEST("Scanner(Lax) checker_verdict.exit_ok_with_score(99, msg) does not scan eof", "a", Exits{0, "OK\nabc\n99\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    uint32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    oi::checker_verdict.exit_ok_with_score(99, "abc");
 }
 
-TEST("Scanner(Lax, PL)::operator>>(Num<uint>) multiply by 10 overflow", "42949672950", Exits{4, "Lax scanner: Wiersz 1, pozycja 11: Liczba calkowita spoza zakresu\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    uint32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+TEST("Scanner(UserOutput) partial score == 99 checker_verdict.wrong() does not scan eof", "a", Exits{0, "OK\nabc; xyz\n99\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    oi::checker_verdict.set_partial_score(99, "abc");
+    oi::checker_verdict.exit_wrong("xyz");
 }
 
-TEST("Scanner(UserOutput, EN)::operator>>(Num<uint>) addition overflow", "4294967296", Exits{0, "WRONG\nLine 1, position 10: Integer value out of range\n0\n"}) {
+TEST("Scanner(Lax) partial score == 99 checker_verdict.wrong() does not scan eof", "a", Exits{0, "OK\nabc; xyz\n99\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
+    oi::checker_verdict.set_partial_score(99, "abc");
+    oi::checker_verdict.exit_wrong("xyz");
+}
+
+TEST("Scanner(UserOutput) checker_verdict.wrong() does not scan eof", "a", Exits{0, "WRONG\nabc\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    uint32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    oi::checker_verdict.exit_wrong("abc");
 }
 
-TEST("Scanner(UserOutput, PL)::operator>>(Num<uint>) addition overflow", "4294967296", Exits{0, "WRONG\nWiersz 1, pozycja 10: Liczba calkowita spoza zakresu\n0\n"}) {
+TEST("Scanner(TestInput) inwer_verdict.exit_wrong() does not scan eof", "a", Exits{1, "abc\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    oi::inwer_verdict.exit_wrong() << "abc";
+}
+
+TEST("Scanner(Lax) checker_verdict.wrong() does not scan eof", "a", Exits{0, "WRONG\nabc\n0\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
+    oi::checker_verdict.exit_wrong("abc");
+}
+
+TEST("Scanner(UserOutput, EN)::constructor(FILE*) makes checker_verdict.exit_ok() scan eof", "a", Exits{0, "WRONG\nLine 1, position 1: Read 'a', expected EOF\n0\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    oi::checker_verdict.exit_ok();
+}
+
+TEST("Scanner(UserOutput, PL)::constructor(FILE*) makes checker_verdict.exit_ok() scan eof", "a", Exits{0, "WRONG\nWiersz 1, pozycja 1: Wczytano 'a', oczekiwano EOF\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    uint32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(Num<uint>) addition overflow", "4294967296", Exits{1, "Line 1, position 10: Integer value out of range\n"}) {
+TEST("Scanner(TestInput, EN)::constructor(FILE*) makes inwer_verdict.ok() scan eof", "a", Exits{1, "Line 1, position 1: Read 'a', expected EOF\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    uint32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    oi::inwer_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(Num<uint>) addition overflow", "4294967296", Exits{1, "Wiersz 1, pozycja 10: Liczba calkowita spoza zakresu\n"}) {
+TEST("Scanner(TestInput, PL)::constructor(FILE*) makes inwer_verdict.ok() scan eof", "a", Exits{1, "Wiersz 1, pozycja 1: Wczytano 'a', oczekiwano EOF\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    uint32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+    oi::inwer_verdict.exit_ok();
 }
 
-TEST("Scanner(Lax, EN)::operator>>(Num<uint>) addition overflow", "4294967296", Exits{4, "Lax scanner: Line 1, position 10: Integer value out of range\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    uint32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+TEST("Scanner(UserOutput, EN)::constructor(const char*) makes checker_verdict.exit_ok() scan eof", "a", Exits{0, "WRONG\nLine 1, position 1: Read 'a', expected EOF\n0\n"}) {
+    auto s = oi::Scanner{"/dev/stdin", oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(Lax, PL)::operator>>(Num<uint>) addition overflow", "4294967296", Exits{4, "Lax scanner: Wiersz 1, pozycja 10: Liczba calkowita spoza zakresu\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    uint32_t x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::min(), std::numeric_limits<decltype(x)>::max()};
+TEST("Scanner(UserOutput, PL)::constructor(const char*) makes checker_verdict.exit_ok() scan eof", "a", Exits{0, "WRONG\nWiersz 1, pozycja 1: Wczytano 'a', oczekiwano EOF\n0\n"}) {
+    auto s = oi::Scanner{"/dev/stdin", oi::Scanner::Mode::UserOutput, oi::Lang::PL};
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput)::operator>>(Num<uint>)", "255 256 257", Exits{0, "OK\n\n100\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    uint32_t x;
-    s >> oi::Num{x, 255, 257} >> ' ';
-    if (x != 255) { std::terminate(); }
-    s >> oi::Num{x, 255, 257} >> ' ';
-    if (x != 256) { std::terminate(); }
-    s >> oi::Num{x, 255, 257};
-    if (x != 257) { std::terminate(); }
-    oi::checker_verdict.exit_ok();
+TEST("Scanner(TestInput, EN)::constructor(const char*) makes inwer_verdict.ok() scan eof", "a", Exits{1, "Line 1, position 1: Read 'a', expected EOF\n"}) {
+    auto s = oi::Scanner{"/dev/stdin", oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    oi::inwer_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput)::operator>>(Num<uint>)", "255 256 257", Exits{0, ""}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    uint32_t x;
-    s >> oi::Num{x, 255, 257} >> ' ';
-    if (x != 255) { std::terminate(); }
-    s >> oi::Num{x, 255, 257} >> ' ';
-    if (x != 256) { std::terminate(); }
-    s >> oi::Num{x, 255, 257};
-    if (x != 257) { std::terminate(); }
+TEST("Scanner(TestInput, PL)::constructor(const char*) makes inwer_verdict.ok() scan eof", "a", Exits{1, "Wiersz 1, pozycja 1: Wczytano 'a', oczekiwano EOF\n"}) {
+    auto s = oi::Scanner{"/dev/stdin", oi::Scanner::Mode::TestInput, oi::Lang::PL};
     oi::inwer_verdict.exit_ok();
 }
 
-TEST("Scanner(Lax)::operator>>(Num<uint>)", "255 256 257", Exits{0, "OK\n\n100\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    uint32_t x;
-    s >> oi::Num{x, 255, 257} >> ' ';
-    if (x != 255) { std::terminate(); }
-    s >> oi::Num{x, 255, 257} >> ' ';
-    if (x != 256) { std::terminate(); }
-    s >> oi::Num{x, 255, 257};
-    if (x != 257) { std::terminate(); }
+TEST("Scanner(UserOutput, EN) destructed before checker_verdict.exit_ok() is ok", "a", Exits{0, "WRONG\nLine 1, position 1: Read 'a', expected EOF\n0\n"}) {
+    void* mem = mmap(nullptr, sizeof(oi::Scanner), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED) { std::terminate(); }
+    auto dev_null_scanner = new (mem) oi::Scanner("/dev/null", oi::Scanner::Mode::UserOutput, oi::Lang::EN);
+    dev_null_scanner->~Scanner();
+    if (munmap(mem, sizeof(oi::Scanner))) {
+        std::terminate();
+    }
+
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput, EN)::operator>>(Num<uint>)", "6", Exits{0, "WRONG\nLine 1, position 1: Integer value out of range\n0\n"}) {
+TEST("Scanner(UserOutput, EN) destructed before checker_verdict.exit_ok() is ok", "a", Exits{0, "WRONG\nLine 1, position 1: Read 'a', expected EOF\n0\n"}) {
+    void* mem = mmap(nullptr, sizeof(oi::Scanner), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED) { std::terminate(); }
+    auto dev_null_scanner = new (mem) oi::Scanner("/dev/null", oi::Scanner::Mode::UserOutput, oi::Lang::EN);
+    dev_null_scanner->~Scanner();
+    if (munmap(mem, sizeof(oi::Scanner))) {
+        std::terminate();
+    }
+
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    uint32_t x;
-    s >> oi::Num{x, 7, 77};
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput, PL)::operator>>(Num<uint>)", "6", Exits{0, "WRONG\nWiersz 1, pozycja 1: Liczba calkowita spoza zakresu\n0\n"}) {
+TEST("Scanner(UserOutput, PL) destructed before checker_verdict.exit_ok() is ok", "a", Exits{0, "WRONG\nWiersz 1, pozycja 1: Wczytano 'a', oczekiwano EOF\n0\n"}) {
+    void* mem = mmap(nullptr, sizeof(oi::Scanner), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED) { std::terminate(); }
+    auto dev_null_scanner = new (mem) oi::Scanner("/dev/null", oi::Scanner::Mode::UserOutput, oi::Lang::PL);
+    dev_null_scanner->~Scanner();
+    if (munmap(mem, sizeof(oi::Scanner))) {
+        std::terminate();
+    }
+
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    uint32_t x;
-    s >> oi::Num{x, 7, 77};
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(Num<uint>)", "6", Exits{1, "Line 1, position 1: Integer value out of range\n"}) {
+TEST("Scanner(TestInput, EN) destructed before inwer_verdict.ok() is ok", "a", Exits{1, "Line 1, position 1: Read 'a', expected EOF\n"}) {
+    void* mem = mmap(nullptr, sizeof(oi::Scanner), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED) { std::terminate(); }
+    auto dev_null_scanner = new (mem) oi::Scanner("/dev/null", oi::Scanner::Mode::TestInput, oi::Lang::EN);
+    dev_null_scanner->~Scanner();
+    if (munmap(mem, sizeof(oi::Scanner))) {
+        std::terminate();
+    }
+
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    uint32_t x;
-    s >> oi::Num{x, 7, 77};
+    oi::inwer_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(Num<uint>)", "6", Exits{1, "Wiersz 1, pozycja 1: Liczba calkowita spoza zakresu\n"}) {
+TEST("Scanner(TestInput, PL) destructed before inwer_verdict.ok() is ok", "a", Exits{1, "Wiersz 1, pozycja 1: Wczytano 'a', oczekiwano EOF\n"}) {
+    void* mem = mmap(nullptr, sizeof(oi::Scanner), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED) { std::terminate(); }
+    auto dev_null_scanner = new (mem) oi::Scanner("/dev/null", oi::Scanner::Mode::TestInput, oi::Lang::PL);
+    dev_null_scanner->~Scanner();
+    if (munmap(mem, sizeof(oi::Scanner))) {
+        std::terminate();
+    }
+
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    uint32_t x;
-    s >> oi::Num{x, 7, 77};
+    oi::inwer_verdict.exit_ok();
 }
 
-TEST("Scanner(Lax, EN)::operator>>(Num<uint>)", "6", Exits{4, "Lax scanner: Line 1, position 1: Integer value out of range\n"}) {
+TEST("Scanner(Lax, EN) destructed before checker_verdict.exit_ok() is ok", "a", Exits{0, "OK\n\n100\n"}) {
+    void* mem = mmap(nullptr, sizeof(oi::Scanner), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED) { std::terminate(); }
+    auto dev_null_scanner = new (mem) oi::Scanner("/dev/null", oi::Scanner::Mode::Lax, oi::Lang::EN);
+    dev_null_scanner->~Scanner();
+    if (munmap(mem, sizeof(oi::Scanner))) {
+        std::terminate();
+    }
+
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    uint32_t x;
-    s >> oi::Num{x, 7, 77};
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(Lax, PL)::operator>>(Num<uint>)", "6", Exits{4, "Lax scanner: Wiersz 1, pozycja 1: Liczba calkowita spoza zakresu\n"}) {
+TEST("Scanner(Lax, PL) destructed before checker_verdict.exit_ok() is ok", "a", Exits{0, "OK\n\n100\n"}) {
+    void* mem = mmap(nullptr, sizeof(oi::Scanner), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED) { std::terminate(); }
+    auto dev_null_scanner = new (mem) oi::Scanner("/dev/null", oi::Scanner::Mode::Lax, oi::Lang::PL);
+    dev_null_scanner->~Scanner();
+    if (munmap(mem, sizeof(oi::Scanner))) {
+        std::terminate();
+    }
+
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    uint32_t x;
-    s >> oi::Num{x, 7, 77};
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput, EN)::operator>>(Num<uint>)", "78", Exits{0, "WRONG\nLine 1, position 2: Integer value out of range\n0\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    uint32_t x;
-    s >> oi::Num{x, 7, 77};
+TEST("Writer::operator<<()", "", Exits{0, "42 -7 abc x 2.5 18446744073709551615\n"}) {
+    oi::Writer w{STDOUT_FILENO};
+    w << 42 << ' ' << -7 << ' ' << "abc" << ' ' << string{"x"} << ' ' << 2.5 << ' '
+      << std::numeric_limits<uint64_t>::max() << '\n';
+    w.flush();
+    oi::inwer_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput, PL)::operator>>(Num<uint>)", "78", Exits{0, "WRONG\nWiersz 1, pozycja 2: Liczba calkowita spoza zakresu\n0\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    uint32_t x;
-    s >> oi::Num{x, 7, 77};
+TEST("Writer::~Writer() flushes", "", Exits{0, "abc\n"}) {
+    {
+        oi::Writer w{STDOUT_FILENO};
+        w << "abc\n";
+    }
+    oi::inwer_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(Num<uint>)", "78", Exits{1, "Line 1, position 2: Integer value out of range\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    uint32_t x;
-    s >> oi::Num{x, 7, 77};
+TEST("Writer writes more than its buffer", "", Exits{0, string(100, 'x') + string(1000, 'y') + "\n"}) {
+    oi::Writer w{STDOUT_FILENO, 64};
+    for (int i = 0; i < 100; ++i) {
+        w << 'x';
+    }
+    w << string(1000, 'y') << '\n';
+    w.flush();
+    oi::inwer_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(Num<uint>)", "78", Exits{1, "Wiersz 1, pozycja 2: Liczba calkowita spoza zakresu\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    uint32_t x;
-    s >> oi::Num{x, 7, 77};
+TEST("Writer::write_parallel()", "", Exits{0, "head\n0 0\n1 1\n2 4\n3 9\n4 16\n5 25\n6 36\n7 49\n8 64\n9 81\ntail\n"}) {
+    setenv("OI_THREADS", "3", 1);
+    oi::Writer w{STDOUT_FILENO};
+    w << "head\n";
+    w.write_parallel(10, 3, [](oi::Writer::Chunk& out, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            out << i << ' ' << i * i << '\n';
+        }
+    });
+    w << "tail\n";
+    w.flush();
+    oi::inwer_verdict.exit_ok();
 }
 
-TEST("Scanner(Lax, EN)::operator>>(Num<uint>)", "78", Exits{4, "Lax scanner: Line 1, position 2: Integer value out of range\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    uint32_t x;
-    s >> oi::Num{x, 7, 77};
-}
+TEST("Writer::write_parallel() to a file, an O_APPEND file and a pipe", "", Exits{0, "OK\n\n100\n"}) {
+    setenv("OI_THREADS", "3", 1);
+    auto format = [](auto& out, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            // Some chunks are empty
+            if (i / 5000 % 7 != 3) {
+                out << i << ' ' << static_cast<int64_t>(i * i) * -1 << ' ' << static_cast<double>(i) / 8 << '\n';
+            }
+        }
+    };
+    constexpr size_t n = 200'003;
+    auto write_to = [&](int fd, bool parallel) {
+        oi::Writer w{fd, 4096};
+        w << "head\n";
+        if (parallel) {
+            w.write_parallel(n, 1000, format);
+        } else {
+            format(w, 0, n);
+        }
+        w << "tail\n";
+    };
+    auto contents = [](int fd) {
+        string res(static_cast<size_t>(lseek(fd, 0, SEEK_END)), '\0');
+        if (pread(fd, res.data(), res.size(), 0) != static_cast<ssize_t>(res.size())) { std::terminate(); }
+        return res;
+    };
 
-TEST("Scanner(Lax, PL)::operator>>(Num<uint>)", "78", Exits{4, "Lax scanner: Wiersz 1, pozycja 2: Liczba calkowita spoza zakresu\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    uint32_t x;
-    s >> oi::Num{x, 7, 77};
+    int seq_fd = memfd_create("seq", MFD_CLOEXEC);
+    write_to(seq_fd, false);
+    auto expected = contents(seq_fd);
+
+    int par_fd = memfd_create("par", MFD_CLOEXEC);
+    if (write(par_fd, "x", 1) != 1 || lseek(par_fd, 0, SEEK_SET) != 0) { std::terminate(); } // overwritten
+    write_to(par_fd, true);
+    if (lseek(par_fd, 0, SEEK_CUR) != static_cast<off_t>(expected.size()) || contents(par_fd) != expected) { std::terminate(); }
+
+    int append_fd = memfd_create("append", MFD_CLOEXEC);
+    if (fcntl(append_fd, F_SETFL, O_APPEND) != 0) { std::terminate(); }
+    write_to(append_fd, true);
+    if (contents(append_fd) != expected) { std::terminate(); }
+
+    int pipe_fds[2];
+    if (pipe(pipe_fds) != 0) { std::terminate(); }
+    string received;
+    std::thread reader{[&] {
+        char buff[1 << 12];
+        for (ssize_t len; (len = read(pipe_fds[0], buff, sizeof(buff))) > 0;) {
+            received.append(buff, static_cast<size_t>(len));
+        }
+    }};
+    write_to(pipe_fds[1], true);
+    (void)close(pipe_fds[1]);
+    reader.join();
+    if (received != expected) { std::terminate(); }
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput, EN)::operator>>(Num<uint>) whitespace is ignored", " 0", Exits{0, "OK\n\n100\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    uint32_t x;
-    s >> oi::Num{x, 0, 0};
-    if (x != 0) { std::terminate(); }
+TEST("Scanner(UserOutput, EN)::constructor(int)", "12  34 \n x", Exits{0, "WRONG\nLine 2, position 2: Read 'x', expected EOF\n0\n"}) {
+    auto s = oi::Scanner{STDIN_FILENO, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    int a, b;
+    s >> oi::Num{a, 0, 100} >> ' ' >> oi::Num{b, 0, 100} >> oi::nl;
+    if (a != 12 || b != 34) { std::terminate(); }
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput, PL)::operator>>(Num<uint>) whitespace is ignored", " 0", Exits{0, "OK\n\n100\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    uint32_t x;
-    s >> oi::Num{x, 0, 0};
-    if (x != 0) { std::terminate(); }
+TEST("Scanner(TestInput, PL)::constructor(int)", "12 34\n", Exits{1, "Wiersz 1, pozycja 3: Wczytano ' ', oczekiwano '\\n'\n"}) {
+    auto s = oi::Scanner{STDIN_FILENO, oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    int a;
+    s >> oi::Num{a, 0, 100} >> oi::nl;
+}
+
+TEST("Scanner(UserOutput)::constructor(int) does not read past the current token", "", Exits{0, "12 34\nWRONG\n\n0\n"}) {
+    int p[2];
+    if (pipe(p)) { std::terminate(); }
+    if (write(p[1], "12 34\n", 6) != 6) { std::terminate(); }
+    auto s = oi::Scanner{p[0], oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    int a, b;
+    // The write end is still open, so reading anything past "\n" would block forever
+    s >> oi::Num{a, 0, 100} >> oi::Num{b, 0, 100} >> oi::nl;
+    oi::Writer w{STDOUT_FILENO};
+    w << a << ' ' << b << '\n';
+    w.flush();
+    oi::checker_verdict.exit_wrong(); // does not scan eof
+}
+
+TEST("Scanner(UserOutput)::constructor(int) flushes the tied writer", "", Exits{0, "OK\n\n100\n"}) {
+    int p[2];
+    if (pipe(p)) { std::terminate(); }
+    if (!oi::tune_interactive_fd(p[1], 1 << 16)) { std::terminate(); }
+    oi::Writer query{p[1]};
+    auto s = oi::Scanner{p[0], oi::Scanner::Mode::UserOutput, oi::Lang::EN, &query};
+    for (int i = 0; i < 10; ++i) {
+        int x;
+        query << i << '\n';
+        s >> oi::Num{x, 0, 100} >> oi::nl;
+        if (x != i) { std::terminate(); }
+    }
+    if (query.round_trip_stats().count != 10) { std::terminate(); }
+    if (query.round_trip_stats().min_ns > query.round_trip_stats().max_ns) { std::terminate(); }
+    (void)close(p[1]);
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(Num<uint>) whitespace is not ignored", " 0", Exits{1, "Line 1, position 1: Read ' ', expected a number\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    uint32_t x;
-    s >> oi::Num{x, 0, 0};
+TEST("Scanner(UserOutput)::constructor(int) reads a SOCK_SEQPACKET message longer than its buffer", "", Exits{0, "OK\n\n100\n"}) {
+    int sv[2];
+    if (socketpair(AF_UNIX, SOCK_SEQPACKET, 0, sv)) { std::terminate(); }
+    if (!oi::tune_interactive_fd(sv[0], 1 << 20)) { std::terminate(); }
+    oi::Writer w{sv[0], 1 << 18};
+    for (int i = 0; i < 20000; ++i) { w << i << ' '; }
+    w << '\n';
+    w.flush(); // about 108 KiB in one message
+    w << "7\n";
+    w.flush();
+    (void)close(sv[0]);
+    auto s = oi::Scanner{sv[1], oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    for (int i = 0; i < 20000; ++i) {
+        int x;
+        s >> oi::Num{x, i, i} >> ' ';
+    }
+    int y;
+    s >> oi::nl >> oi::Num{y, 7, 7} >> oi::nl >> oi::eof;
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(Num<uint>) whitespace is not ignored", " 0", Exits{1, "Wiersz 1, pozycja 1: Wczytano ' ', oczekiwano liczby\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    uint32_t x;
-    s >> oi::Num{x, 0, 0};
+TEST("Scanner(TestInput, EN)::constructor(const char*) reads a regular file from memory", "1 2\n", Exits{0, ""}) {
+    auto s = oi::Scanner{"/dev/stdin", oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    if (!s.is_in_memory()) { std::terminate(); }
+    int a, b;
+    s >> oi::Num{a, 1, 1} >> ' ' >> oi::Num{b, 2, 2} >> oi::nl;
+    oi::inwer_verdict.exit_ok();
 }
 
-TEST("Scanner(Lax, EN)::operator>>(Num<uint>) whitespace is ignored", " 0", Exits{0, "OK\n\n100\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    uint32_t x;
-    s >> oi::Num{x, 0, 0};
-    if (x != 0) { std::terminate(); }
+TEST("Scanner(TestInput, EN)::constructor(const char*) falls back to stdio for pipes", "", Exits{0, "OK\n\n100\n"}) {
+    int p[2];
+    if (pipe(p)) { std::terminate(); }
+    if (write(p[1], "42\n", 3) != 3) { std::terminate(); }
+    (void)close(p[1]);
+    auto s = oi::Scanner{("/dev/fd/" + std::to_string(p[0])).c_str(), oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    if (s.is_in_memory()) { std::terminate(); }
+    int a;
+    s >> oi::Num{a, 42, 42} >> oi::nl;
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(Lax, PL)::operator>>(Num<uint>) whitespace is ignored", " 0", Exits{0, "OK\n\n100\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    uint32_t x;
-    s >> oi::Num{x, 0, 0};
-    if (x != 0) { std::terminate(); }
+TEST("Scanner(UserOutput, EN)::constructor(Memory)", "", Exits{0, "WRONG\nLine 2, position 1: Read 'x', expected EOF\n0\n"}) {
+    auto s = oi::Scanner{oi::Scanner::Memory{"3 \nx"}, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    int a;
+    s >> oi::Num{a, 3, 3} >> oi::nl;
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput)::operator>>(Num<double>)", R"(0
--0
-3141592653589793238462643383279502
--3141592653589793238462643383279502
-0.0000000000000000000000000003141592653589793238462643383279502
--0.0000000000000000000000000003141592653589793238462643383279502
-3141592.653589793238462643383279502
--3141592.653589793238462643383279502
-)", Exits{0, "OK\n\n100\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    double x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
-    if (x != 0) { std::terminate(); }
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
-    if (x != 0) { std::terminate(); }
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
-    if (std::abs(1 - x / 3141592653589793238462643383279502.0) > 1e-12) { std::terminate(); }
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
-    if (std::abs(1 - x / -3141592653589793238462643383279502.0) > 1e-12) { std::terminate(); }
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
-    if (std::abs(1 - x / 0.0000000000000000000000000003141592653589793238462643383279502) > 1e-12) { std::terminate(); }
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
-    if (std::abs(1 - x / -0.0000000000000000000000000003141592653589793238462643383279502) > 1e-12) { std::terminate(); }
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
-    if (std::abs(1 - x / 3141592.653589793238462643383279502) > 1e-12) { std::terminate(); }
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
-    if (std::abs(1 - x / -3141592.653589793238462643383279502) > 1e-12) { std::terminate(); }
+TEST("Scanner(TestInput)::mark() and rewind() scan the input twice", "3\n1 2 3\n", Exits{0, "6 6\n"}) {
+    auto s = oi::Scanner{"/dev/stdin", oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    int n;
+    s >> oi::Num{n, 1, 10} >> oi::nl;
+    auto m = s.mark();
+    int sums[2] = {0, 0};
+    for (int pass = 0; pass < 2; ++pass) {
+        s.rewind(m);
+        for (int i = 0; i < n; ++i) {
+            int x;
+            if (i > 0) { s >> ' '; }
+            s >> oi::Num{x, 1, 10};
+            sums[pass] += x;
+        }
+        s >> oi::nl;
+    }
+    oi::inwer_verdict.exit_ok() << sums[0] << ' ' << sums[1];
+}
+
+TEST("Scanner(UserOutput, EN)::rewind() restores position and pending whitespace", "1 \n  2 x", Exits{0, "WRONG\nLine 2, position 5: Read 'x', expected EOF\n0\n"}) {
+    auto s = oi::Scanner{"/dev/stdin", oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    int a, b;
+    s >> oi::Num{a, 1, 1} >> oi::nl;
+    auto m = s.mark();
+    s >> oi::Num{b, 2, 2};
+    s.rewind(m);
+    s >> oi::Num{b, 2, 2};
+    s.rewind(m);
+    s >> oi::Num{b, 2, 2};
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput)::operator>>(Num<double>)", R"(0
--0
-3141592653589793238462643383279502
--3141592653589793238462643383279502
-0.0000000000000000000000000003141592653589793238462643383279502
--0.0000000000000000000000000003141592653589793238462643383279502
-3141592.653589793238462643383279502
--3141592.653589793238462643383279502
-)", Exits{0, ""}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    double x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
-    if (x != 0) { std::terminate(); }
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
-    if (x != 0) { std::terminate(); }
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
-    if (std::abs(1 - x / 3141592653589793238462643383279502.0) > 1e-12) { std::terminate(); }
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
-    if (std::abs(1 - x / -3141592653589793238462643383279502.0) > 1e-12) { std::terminate(); }
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
-    if (std::abs(1 - x / 0.0000000000000000000000000003141592653589793238462643383279502) > 1e-12) { std::terminate(); }
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
-    if (std::abs(1 - x / -0.0000000000000000000000000003141592653589793238462643383279502) > 1e-12) { std::terminate(); }
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
-    if (std::abs(1 - x / 3141592.653589793238462643383279502) > 1e-12) { std::terminate(); }
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
-    if (std::abs(1 - x / -3141592.653589793238462643383279502) > 1e-12) { std::terminate(); }
+TEST("Scanner(TestInput, PL)::rewind() restores position", "1 2 x\n", Exits{1, "Wiersz 1, pozycja 5: Wczytano 'x', oczekiwano liczby\n"}) {
+    auto s = oi::Scanner{"/dev/stdin", oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    int a;
+    s >> oi::Num{a, 1, 1} >> ' ';
+    auto m = s.mark();
+    s >> oi::Num{a, 2, 2} >> ' ';
+    s.rewind(m);
+    s >> oi::Num{a, 2, 2} >> ' ' >> oi::Num{a, 0, 9};
+}
+
+TEST("Scanner::peek()", "12 ab\n", Exits{0, "[12 ][ ab\n][][]\n"}) {
+    auto s = oi::Scanner{"/dev/stdin", oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    oi::Writer w{STDOUT_FILENO};
+    w << '[' << s.peek(3) << ']';
+    int a;
+    s >> oi::Num{a, 12, 12};
+    w << '[' << s.peek(100) << ']';
+    string str;
+    s >> ' ' >> oi::Str{str, 2} >> oi::nl;
+    w << '[' << s.peek(100) << ']';
+    s >> oi::eof;
+    w << '[' << s.peek(100) << "]\n";
+    w.flush();
     oi::inwer_verdict.exit_ok();
 }
 
-TEST("Scanner(Lax)::operator>>(Num<double>)", R"(0
--0
-3141592653589793238462643383279502
--3141592653589793238462643383279502
-0.0000000000000000000000000003141592653589793238462643383279502
--0.0000000000000000000000000003141592653589793238462643383279502
-3141592.653589793238462643383279502
--3141592.653589793238462643383279502
-)", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner::mark() requires the input in memory", "", Exits{2, "BUG: Scanner::mark() requires the input to be in memory (a regular file or Memory{})\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    double x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
-    if (x != 0) { std::terminate(); }
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
-    if (x != 0) { std::terminate(); }
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
-    if (std::abs(1 - x / 3141592653589793238462643383279502.0) > 1e-12) { std::terminate(); }
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
-    if (std::abs(1 - x / -3141592653589793238462643383279502.0) > 1e-12) { std::terminate(); }
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
-    if (std::abs(1 - x / 0.0000000000000000000000000003141592653589793238462643383279502) > 1e-12) { std::terminate(); }
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
-    if (std::abs(1 - x / -0.0000000000000000000000000003141592653589793238462643383279502) > 1e-12) { std::terminate(); }
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
-    if (std::abs(1 - x / 3141592.653589793238462643383279502) > 1e-12) { std::terminate(); }
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()} >> '\n';
-    if (std::abs(1 - x / -3141592.653589793238462643383279502) > 1e-12) { std::terminate(); }
-    oi::checker_verdict.exit_ok();
+    (void)s.mark();
+}
+
+TEST("read_graph() undirected", "1 2\n3 1\n2 2\n", Exits{0, "1: 2/0 3/1\n2: 1/0 2/2\n3: 1/1\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    auto g = oi::read_graph(s, 3, 3);
+    oi::Writer w{STDOUT_FILENO};
+    for (int v = 1; v <= g.n; ++v) {
+        w << v << ':';
+        for (size_t i = 0; i < g.neighbours(v).size(); ++i) {
+            w << ' ' << g.neighbours(v)[i] << '/' << g.incident_edges(v)[i];
+        }
+        w << '\n';
+    }
+    w.flush();
+    oi::inwer_verdict.exit_ok();
+}
+
+TEST("read_graph() directed with attribute", "1 2 7\n3 1 5\n1 3 7\n", Exits{0, "1: 2/7 3/7\n2:\n3: 1/5\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    auto g = oi::read_graph(s, 3, 3, {.directed = true, .with_attribute = true, .attribute_min = 5, .attribute_max = 7});
+    oi::Writer w{STDOUT_FILENO};
+    for (int v = 1; v <= g.n; ++v) {
+        w << v << ':';
+        for (size_t i = 0; i < g.neighbours(v).size(); ++i) {
+            w << ' ' << g.neighbours(v)[i] << '/' << g.edge_attribute[static_cast<size_t>(g.incident_edges(v)[i])];
+        }
+        w << '\n';
+    }
+    w.flush();
+    oi::inwer_verdict.exit_ok();
+}
+
+TEST("read_graph() vertex out of range", "1 2\n3 4\n", Exits{1, "Line 2, position 3: Integer value out of range\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    (void)oi::read_graph(s, 3, 2);
+}
+
+TEST("read_graph() attribute out of range", "1 2 3\n", Exits{1, "Wiersz 1, pozycja 5: Liczba calkowita spoza zakresu\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    (void)oi::read_graph(s, 3, 1, {.with_attribute = true, .attribute_min = 1, .attribute_max = 2});
 }
 
-TEST("Scanner(UserOutput, EN)::operator>>(Num<double>)", "", Exits{0, "WRONG\nLine 1, position 1: Read EOF, expected a number\n0\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    double x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
+TEST("read_graph() loops not allowed", "1 2\n3 3\n", Exits{1, "Line 2, position 3: Loops are not allowed\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    (void)oi::read_graph(s, 3, 2, {.allow_loops = false});
 }
 
-TEST("Scanner(UserOutput, PL)::operator>>(Num<double>)", "", Exits{0, "WRONG\nWiersz 1, pozycja 1: Wczytano EOF, oczekiwano liczby\n0\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    double x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
+TEST("read_graph() undirected multi-edges not allowed", "3 4\n1 2\n3 1\n2 1\n2 3\n", Exits{1, "Wiersz 4, pozycja 3: Krawedzie 1 i 3 lacza te same wierzcholki\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    int n, m;
+    s >> oi::Num{n, 1, 3} >> ' ' >> oi::Num{m, 0, 4} >> oi::nl;
+    (void)oi::read_graph(s, n, m, {.allow_multi_edges = false});
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(Num<double>)", "", Exits{1, "Line 1, position 1: Read EOF, expected a number\n"}) {
+TEST("read_graph() directed multi-edges not allowed", "1 2\n2 1\n3 3\n", Exits{0, ""}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    double x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
+    (void)oi::read_graph(s, 3, 3, {.directed = true, .allow_multi_edges = false});
+    oi::inwer_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(Num<double>)", "", Exits{1, "Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano liczby\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    double x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
+TEST("read_graph() directed multi-edges not allowed", "1 2\n2 1\n1 2\n3 1\n", Exits{0, "WRONG\nLine 3, position 3: Edges 1 and 3 connect the same vertices\n0\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    (void)oi::read_graph(s, 3, 4, {.directed = true, .allow_multi_edges = false});
 }
 
-TEST("Scanner(Lax, EN)::operator>>(Num<double>)", "", Exits{4, "Lax scanner: Line 1, position 1: Read EOF, expected a number\n"}) {
+TEST("read_graph() multi-edges after a header", "3\n1 2\n2 3\n2 1\n", Exits{0, "WRONG\nLine 4, position 3: Edges 1 and 3 connect the same vertices\n0\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    int m;
+    s >> oi::Num{m, 0, 3} >> oi::nl;
+    (void)oi::read_graph(s, 3, m, {.allow_multi_edges = false});
+}
+
+TEST("read_graph(Lax) multi-edges with extra whitespace", "1  2 \n2 3\n  2   1  \n", Exits{4, "Lax scanner: Line 3, position 7: Edges 1 and 3 connect the same vertices\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    double x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
+    (void)oi::read_graph(s, 3, 3, {.allow_multi_edges = false});
 }
 
-TEST("Scanner(Lax, PL)::operator>>(Num<double>)", "", Exits{4, "Lax scanner: Wiersz 1, pozycja 1: Wczytano EOF, oczekiwano liczby\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    double x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
+TEST("cert::Validator::permutation()", "", Exits{0, "OK\n\n100\n"}) {
+    oi::cert::Validator v{oi::Lang::EN};
+    for (int i = 0; i < 3; ++i) {
+        if (auto err = v.permutation(vector<int>{3, 1, 2})) { oi::checker_verdict.exit_wrong(*err); }
+        if (auto err = v.permutation(vector<int>{})) { oi::checker_verdict.exit_wrong(*err); }
+    }
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput, EN)::operator>>(Num<double>)", "-", Exits{0, "WRONG\nLine 1, position 2: Read EOF, expected a number\n0\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    double x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
+TEST("cert::Validator::permutation() repeated value", "", Exits{0, "WRONG\nValue 1 occurs more than once\n0\n"}) {
+    oi::cert::Validator v{oi::Lang::EN};
+    if (auto err = v.permutation(vector<int>{1, 2, 3})) { oi::checker_verdict.exit_wrong(*err); }
+    if (auto err = v.permutation(vector<int>{1, 2, 1})) { oi::checker_verdict.exit_wrong(*err); }
 }
 
-TEST("Scanner(UserOutput, PL)::operator>>(Num<double>)", "-", Exits{0, "WRONG\nWiersz 1, pozycja 2: Wczytano EOF, oczekiwano liczby\n0\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    double x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
+TEST("cert::Validator::distinct() out of range", "", Exits{0, "WRONG\nWartosc 5 spoza zakresu [-3, 4]\n0\n"}) {
+    oi::cert::Validator v{oi::Lang::PL};
+    if (auto err = v.distinct(vector<int>{-3, 4, 0, 5}, -3, 4)) { oi::checker_verdict.exit_wrong(*err); }
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(Num<double>)", "-", Exits{1, "Line 1, position 2: Read EOF, expected a number\n"}) {
+TEST("cert::Validator::path() and cycle()", "4 4\n1 2\n2 3\n3 4\n4 2\n", Exits{0, "OK\n\n100\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    double x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
+    int n, m;
+    s >> oi::Num{n, 1, 10} >> ' ' >> oi::Num{m, 1, 10} >> oi::nl;
+    auto g = oi::read_graph(s, n, m);
+    oi::cert::Validator v{oi::Lang::EN};
+    if (auto err = v.path(g, vector<int>{1, 2, 4, 3})) { oi::checker_verdict.exit_wrong(*err); }
+    if (auto err = v.cycle(g, vector<int>{2, 3, 4})) { oi::checker_verdict.exit_wrong(*err); }
+    if (!v.path(g, vector<int>{1, 2, 1})) { std::terminate(); }
+    if (!v.path(g, vector<int>{1, 3})) { std::terminate(); }
+    if (!v.cycle(g, vector<int>{1, 2})) { std::terminate(); }
+    if (!v.cycle(g, vector<int>{1, 2, 3})) { std::terminate(); }
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(Num<double>)", "-", Exits{1, "Wiersz 1, pozycja 2: Wczytano EOF, oczekiwano liczby\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    double x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
+TEST("cert::Validator::cycle() missing edge", "1 2\n2 3\n3 1\n", Exits{0, "WRONG\nThere is no edge from 1 to 3\n0\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    auto g = oi::read_graph(s, 3, 3, {.directed = true});
+    oi::cert::Validator v{oi::Lang::EN};
+    if (auto err = v.cycle(g, vector<int>{1, 2, 3})) { oi::checker_verdict.exit_wrong(*err); }
+    if (auto err = v.cycle(g, vector<int>{1, 3, 2})) { oi::checker_verdict.exit_wrong(*err); }
 }
 
-TEST("Scanner(Lax, EN)::operator>>(Num<double>)", "-", Exits{4, "Lax scanner: Line 1, position 2: Read EOF, expected a number\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    double x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
+TEST("cert::Validator::spanning_tree()", "1 2\n2 3\n3 1\n3 4\n", Exits{0, "WRONG\nKrawedz 3 zamyka cykl\n0\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    auto g = oi::read_graph(s, 4, 4);
+    oi::cert::Validator v{oi::Lang::PL};
+    if (auto err = v.spanning_tree(g, vector<int>{1, 2, 4})) { oi::checker_verdict.exit_wrong(*err); }
+    if (auto err = v.connected(g)) { oi::checker_verdict.exit_wrong(*err); }
+    if (!v.spanning_tree(g, vector<int>{1, 2})) { std::terminate(); }
+    if (!v.spanning_tree(g, vector<int>{1, 2, 5})) { std::terminate(); }
+    if (auto err = v.spanning_tree(g, vector<int>{1, 2, 3})) { oi::checker_verdict.exit_wrong(*err); }
 }
 
-TEST("Scanner(Lax, PL)::operator>>(Num<double>)", "-", Exits{4, "Lax scanner: Wiersz 1, pozycja 2: Wczytano EOF, oczekiwano liczby\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    double x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
+TEST("cert::Validator::acyclic()", "1 2\n3 4\n4 2\n1 3\n", Exits{0, "WRONG\nEdge 4 closes a cycle\n0\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    auto g = oi::read_graph(s, 5, 4);
+    oi::cert::Validator v{oi::Lang::EN};
+    if (auto err = v.acyclic(g)) { oi::checker_verdict.exit_wrong(*err); }
 }
 
-TEST("Scanner(UserOutput, EN)::operator>>(Num<double>) positive overflow", "999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999", Exits{0, "WRONG\nLine 1, position 309: Real number value out of range\n0\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    double x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
+TEST("cert::Validator::matching() and connected()", "1 2\n2 3\n3 4\n", Exits{0, "WRONG\nGraph is not connected: vertex 5 is not reachable from vertex 1\n0\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    auto g = oi::read_graph(s, 5, 3);
+    oi::cert::Validator v{oi::Lang::EN};
+    if (auto err = v.matching(g, vector<int>{1, 3})) { oi::checker_verdict.exit_wrong(*err); }
+    if (v.matching(g, vector<int>{1, 2}) != "Vertex 2 is matched more than once") { std::terminate(); }
+    if (v.matching(g, vector<int>{3, 3}) != "Edge 3 occurs more than once") { std::terminate(); }
+    if (auto err = v.connected(g)) { oi::checker_verdict.exit_wrong(*err); }
+}
+
+TEST("cert::Dsu and cert::EpochSet reset", "", Exits{0, "OK\n\n100\n"}) {
+    oi::cert::Dsu dsu;
+    oi::cert::EpochSet set;
+    for (int round = 0; round < 1000; ++round) {
+        dsu.reset(10);
+        set.reset(10);
+        for (size_t i = 0; i < 10; ++i) {
+            if (set.contains(i) || !set.insert(i) || set.insert(i)) { std::terminate(); }
+        }
+        for (size_t i = 1; i < 10; i += 2) {
+            if (!dsu.unite(i - 1, i)) { std::terminate(); }
+        }
+        if (dsu.sets_count() != 5 || dsu.unite(8, 9) || dsu.find(2) == dsu.find(4)) { std::terminate(); }
+    }
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput, PL)::operator>>(Num<double>) positive overflow", "999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999", Exits{0, "WRONG\nWiersz 1, pozycja 309: Liczba rzeczywista spoza zakresu\n0\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    double x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
+TEST("Scanner(TestInput, EN)::skip_lines() in memory", "a b\n\nc\nx\n", Exits{1, "Line 4, position 1: Read 'x', expected one of characters: y\n"}) {
+    auto s = oi::Scanner{"/dev/stdin", oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    char c;
+    s.skip_lines(0).skip_lines(3) >> oi::Char{c, "y"};
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(Num<double>) positive overflow", "999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999", Exits{1, "Line 1, position 309: Real number value out of range\n"}) {
+TEST("Scanner(TestInput, EN)::skip_lines()", "a b\n\nc\nx\n", Exits{1, "Line 4, position 1: Read 'x', expected one of characters: y\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    double x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
+    char c;
+    s.skip_lines(0).skip_lines(3) >> oi::Char{c, "y"};
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(Num<double>) positive overflow", "999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999", Exits{1, "Wiersz 1, pozycja 309: Liczba rzeczywista spoza zakresu\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    double x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
+TEST("Scanner(Lax, EN)::skip_lines() in memory after a token", "12 ab\ncd  \n3\n", Exits{4, "Lax scanner: Line 3, position 1: here\n"}) {
+    auto s = oi::Scanner{"/dev/stdin", oi::Scanner::Mode::Lax, oi::Lang::EN};
+    int a;
+    s >> oi::Num{a, 12, 12};
+    s.skip_lines(2) >> oi::Num{a, 3, 3};
+    s.error("here");
 }
 
-TEST("Scanner(Lax, EN)::operator>>(Num<double>) positive overflow", "999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999", Exits{4, "Lax scanner: Line 1, position 309: Real number value out of range\n"}) {
+TEST("Scanner(Lax, EN)::skip_lines() after a token", "12 ab\ncd  \n3\n", Exits{4, "Lax scanner: Line 3, position 1: here\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    double x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
+    int a;
+    s >> oi::Num{a, 12, 12};
+    s.skip_lines(2) >> oi::Num{a, 3, 3};
+    s.error("here");
 }
 
-TEST("Scanner(Lax, PL)::operator>>(Num<double>) positive overflow", "999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999", Exits{4, "Lax scanner: Wiersz 1, pozycja 309: Liczba rzeczywista spoza zakresu\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    double x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
+TEST("Scanner(TestInput, PL)::skip_lines() in memory past EOF", "a\nbc", Exits{1, "Wiersz 2, pozycja 3: Wczytano EOF, oczekiwano '\\n'\n"}) {
+    auto s = oi::Scanner{"/dev/stdin", oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    s.skip_lines(3);
 }
 
-TEST("Scanner(UserOutput, EN)::operator>>(Num<double>) negative overflow", "-999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999", Exits{0, "WRONG\nLine 1, position 310: Real number value out of range\n0\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    double x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
+TEST("Scanner(TestInput, PL)::skip_lines() past EOF", "a\nbc", Exits{1, "Wiersz 2, pozycja 3: Wczytano EOF, oczekiwano '\\n'\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    s.skip_lines(3);
 }
 
-TEST("Scanner(UserOutput, PL)::operator>>(Num<double>) negative overflow", "-999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999", Exits{0, "WRONG\nWiersz 1, pozycja 310: Liczba rzeczywista spoza zakresu\n0\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    double x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
+TEST("Scanner(UserOutput, EN)::skip_lines() in memory leaves the newline pending", "a\nb  \n\n", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{"/dev/stdin", oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    auto m = s.mark();
+    s.skip_lines(2);
+    if (s.peek(10) != "\n\n") { std::terminate(); }
+    s.rewind(m);
+    s.skip_lines(2);
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(Num<double>) negative overflow", "-999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999", Exits{1, "Line 1, position 310: Real number value out of range\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    double x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
+#ifdef OI_H_ZLIB
+int gzip_to_memfd(const vector<string>& members) {
+    int fd = memfd_create("oi.h test gz", 0);
+    if (fd == -1) { std::terminate(); }
+    for (auto& data : members) {
+        gzFile gz = gzdopen(dup(fd), "ab");
+        if (!gz || gzwrite(gz, data.data(), static_cast<unsigned>(data.size())) != static_cast<int>(data.size())) { std::terminate(); }
+        if (gzclose(gz) != Z_OK) { std::terminate(); }
+    }
+    return fd;
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(Num<double>) negative overflow", "-999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999", Exits{1, "Wiersz 1, pozycja 310: Liczba rzeczywista spoza zakresu\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    double x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
+string numbers_lines(int from, int to) {
+    string res;
+    for (int i = from; i <= to; ++i) {
+        res += std::to_string(i);
+        res += '\n';
+    }
+    return res;
+}
+
+TEST("Scanner(TestInput)::constructor(const char*) reads gzip", "", Exits{0, "500000500000\n"}) {
+    int fd = gzip_to_memfd({numbers_lines(1, 700000), numbers_lines(700001, 1000000)});
+    auto s = oi::Scanner{("/proc/self/fd/" + std::to_string(fd)).c_str(), oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    if (!s.is_in_memory()) { std::terminate(); }
+    int64_t sum = 0;
+    for (int i = 1; i <= 1000000; ++i) {
+        int x;
+        s >> oi::Num{x, i, i} >> oi::nl;
+        sum += x;
+    }
+    oi::inwer_verdict.exit_ok() << sum;
 }
 
-TEST("Scanner(Lax, EN)::operator>>(Num<double>) negative overflow", "-999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999", Exits{4, "Lax scanner: Line 1, position 310: Real number value out of range\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    double x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
+TEST("Scanner(UserOutput, EN)::constructor(const char*) reads gzip", "", Exits{0, "WRONG\nLine 3, position 2: Read 'x', expected EOF\n0\n"}) {
+    int fd = gzip_to_memfd({"1 2\n\n x"});
+    auto s = oi::Scanner{("/proc/self/fd/" + std::to_string(fd)).c_str(), oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    int a;
+    s >> oi::Num{a, 1, 1} >> oi::Num{a, 2, 2};
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(Lax, PL)::operator>>(Num<double>) negative overflow", "-999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999", Exits{4, "Lax scanner: Wiersz 1, pozycja 310: Liczba rzeczywista spoza zakresu\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    double x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), std::numeric_limits<decltype(x)>::max()};
+TEST("Scanner(TestInput)::mark() and rewind() on gzip", "", Exits{0, "2 3 4\n"}) {
+    int fd = gzip_to_memfd({"2\n1 ", "2\n3 4\n"});
+    auto s = oi::Scanner{("/proc/self/fd/" + std::to_string(fd)).c_str(), oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    int n, a, b;
+    s >> oi::Num{n, 1, 10} >> oi::nl;
+    auto m = s.mark();
+    s.skip_lines(2);
+    s.rewind(m);
+    if (s.peek(4) != "1 2\n") { std::terminate(); }
+    s >> oi::Num{a, 1, 1} >> ' ' >> oi::Num{b, 2, 2} >> oi::nl;
+    auto end = s.mark();
+    s >> oi::Num{a, 3, 3} >> ' ' >> oi::Num{b, 4, 4} >> oi::nl >> oi::eof;
+    s.rewind(m);
+    s.skip_lines(1);
+    if (s.peek(10) != "3 4\n") { std::terminate(); }
+    s.rewind(end);
+    s >> oi::Num{a, 3, 3} >> ' ' >> oi::Num{b, 4, 4} >> oi::nl >> oi::eof;
+    oi::inwer_verdict.exit_ok() << n << ' ' << a << ' ' << b;
+}
+
+TEST("Scanner::constructor(const char*) truncated gzip", "", Exits{2, "BUG: Truncated gzip input\n"}) {
+    int fd = gzip_to_memfd({numbers_lines(1, 1000)});
+    struct stat st;
+    if (fstat(fd, &st) || ftruncate(fd, st.st_size - 10)) { std::terminate(); }
+    auto s = oi::Scanner{("/proc/self/fd/" + std::to_string(fd)).c_str(), oi::Scanner::Mode::Lax, oi::Lang::EN};
+    s.skip_lines(1000);
+}
+
+TEST("Scanner::constructor(const char*) scans gzip before it is decompressed", "", Exits{2, "1\nBUG: Truncated gzip input\n"}) {
+    int fd = gzip_to_memfd({"1\n", numbers_lines(1, 100000)});
+    struct stat st;
+    if (fstat(fd, &st) || ftruncate(fd, st.st_size - 10)) { std::terminate(); }
+    auto s = oi::Scanner{("/proc/self/fd/" + std::to_string(fd)).c_str(), oi::Scanner::Mode::Lax, oi::Lang::EN};
+    int x;
+    s >> oi::Num{x, 1, 1} >> oi::nl;
+    (void)fprintf(stdout, "%d\n", x);
+    (void)fflush(stdout);
+    s.skip_lines(100000);
+}
+
+size_t peak_rss_kib() {
+    int fd = open("/proc/self/status", O_RDONLY);
+    char status[1 << 14];
+    auto len = read(fd, status, sizeof(status) - 1);
+    (void)close(fd);
+    if (len <= 0) { std::terminate(); }
+    status[len] = '\0';
+    const char* hwm = strstr(status, "VmHWM:");
+    if (!hwm) { std::terminate(); }
+    return strtoul(hwm + 6, nullptr, 10);
+}
+
+TEST("Scanner::constructor(const char*) frees scanned gzip input", "", Exits{0, "OK\n\n100\n"}) {
+    constexpr size_t line_len = 1024, lines = 256 << 10; // 256 MiB
+    int fd = memfd_create("oi.h test gz", 0);
+    gzFile gz = gzdopen(dup(fd), "wb1");
+    if (!gz) { std::terminate(); }
+    string chunk;
+    for (size_t i = 0; i < 1024; ++i) {
+        chunk += string(line_len - 1, 'a') + '\n';
+    }
+    for (size_t i = 0; i < lines / 1024; ++i) {
+        if (gzwrite(gz, chunk.data(), static_cast<unsigned>(chunk.size())) != static_cast<int>(chunk.size())) { std::terminate(); }
+    }
+    if (gzclose(gz) != Z_OK) { std::terminate(); }
+    chunk = {};
+    size_t rss_before = peak_rss_kib();
+    auto s = oi::Scanner{("/proc/self/fd/" + std::to_string(fd)).c_str(), oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    s.skip_lines(lines) >> oi::eof;
+    if (peak_rss_kib() - rss_before > (128 << 10)) { std::terminate(); }
+    oi::checker_verdict.exit_ok();
+}
+#else
+TEST("Scanner::constructor(const char*) gzip without OI_H_ZLIB", "\x1f\x8b\x08\x08", Exits{2, "BUG: Input is gzip-compressed, compile with -DOI_H_ZLIB and link with -lz to read it\n"}) {
+    auto s = oi::Scanner{"/dev/stdin", oi::Scanner::Mode::Lax, oi::Lang::EN};
+}
+#endif
+
+#ifdef OI_H_ZSTD
+TEST("Scanner(TestInput)::constructor(const char*) reads zstd", "", Exits{1, "Line 3, position 2: Read 'x', expected '\\n'\n"}) {
+    string data = "1\n22\n3x\n";
+    string compressed(ZSTD_compressBound(data.size()), '\0');
+    auto len = ZSTD_compress(compressed.data(), compressed.size(), data.data(), data.size(), 1);
+    if (ZSTD_isError(len)) { std::terminate(); }
+    int fd = memfd_create("oi.h test zst", 0);
+    if (pwrite(fd, compressed.data(), len, 0) != static_cast<ssize_t>(len)) { std::terminate(); }
+    auto s = oi::Scanner{("/proc/self/fd/" + std::to_string(fd)).c_str(), oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    int a;
+    s >> oi::Num{a, 1, 1} >> oi::nl >> oi::Num{a, 22, 22} >> oi::nl >> oi::Num{a, 3, 3} >> oi::nl;
+}
+
+TEST("Scanner(TestInput)::mark() and rewind() on zstd", "", Exits{0, "OK\n\n100\n"}) {
+    string data;
+    for (int i = 0; i < 300000; ++i) {
+        data += std::to_string(i) + "\n";
+    }
+    string compressed(ZSTD_compressBound(data.size()), '\0');
+    auto len = ZSTD_compress(compressed.data(), compressed.size(), data.data(), data.size(), 1);
+    if (ZSTD_isError(len)) { std::terminate(); }
+    int fd = memfd_create("oi.h test zst", 0);
+    if (pwrite(fd, compressed.data(), len, 0) != static_cast<ssize_t>(len)) { std::terminate(); }
+    auto s = oi::Scanner{("/proc/self/fd/" + std::to_string(fd)).c_str(), oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    if (!s.is_in_memory()) { std::terminate(); }
+    auto m = s.mark();
+    s.skip_lines(299999);
+    if (s.peek(100) != "299999\n") { std::terminate(); }
+    s.rewind(m);
+    for (int i = 0; i < 300000; ++i) {
+        int x;
+        s >> oi::Num{x, i, i} >> oi::nl;
+    }
+    s >> oi::eof;
+    oi::checker_verdict.exit_ok();
 }
+#else
+TEST("Scanner::constructor(const char*) zstd without OI_H_ZSTD", "\x28\xb5\x2f\xfd", Exits{2, "BUG: Input is zstd-compressed, compile with -DOI_H_ZSTD and link with -lzstd to read it\n"}) {
+    auto s = oi::Scanner{"/dev/stdin", oi::Scanner::Mode::Lax, oi::Lang::EN};
+}
+#endif
 
-TEST("Scanner(UserOutput)::operator>>(Num<double>)", R"(0
--0
-3141592653589793238462643383279502
--3141592653589793238462643383279502
-0.0000000000000000000000000003141592653589793238462643383279502
--0.0000000000000000000000000003141592653589793238462643383279502
-3141592.653589793238462643383279502
--3141592.653589793238462643383279502
-)", Exits{0, "OK\n\n100\n"}) {
+TEST("HugePages", "", Exits{0, ""}) {
+    oi::HugePages empty;
+    if (empty.data() != nullptr || empty.size() != 0) { std::terminate(); }
+    oi::HugePages hp{3 << 20};
+    if (hp.size() != (4 << 20) || reinterpret_cast<uintptr_t>(hp.data()) % oi::HugePages::huge_page_size != 0) { std::terminate(); }
+    std::memset(hp.data(), 'x', hp.size());
+    empty = std::move(hp);
+    if (hp.data() != nullptr || empty.size() != (4 << 20) || empty.data()[42] != 'x') { std::terminate(); }
+    oi::inwer_verdict.exit_ok();
+}
+
+TEST("HugePageArena and ArenaAllocator", "", Exits{0, ""}) {
+    oi::HugePageArena arena{1 << 20};
+    int* first = nullptr;
+    for (int round = 0; round < 3; ++round) {
+        arena.reset();
+        vector<int, oi::ArenaAllocator<int>> v(1000, oi::ArenaAllocator<int>{arena});
+        std::iota(v.begin(), v.end(), 0);
+        if (round == 0) { first = v.data(); }
+        if (v.data() != first) { std::terminate(); } // memory is reused after reset()
+        vector<char, oi::ArenaAllocator<char>> big(3 << 20, 'a', oi::ArenaAllocator<char>{arena});
+        auto* d = static_cast<double*>(arena.allocate(sizeof(double), alignof(double)));
+        if (reinterpret_cast<uintptr_t>(d) % alignof(double) != 0) { std::terminate(); }
+        for (int i = 0; i < 100000; ++i) {
+            v.push_back(i);
+        }
+        if (v[999] != 999 || v.back() != 99999 || big.back() != 'a') { std::terminate(); }
+    }
+    oi::inwer_verdict.exit_ok();
+}
+
+static_assert(std::ranges::input_range<oi::Tokens<int>>);
+
+TEST("tokens() UserOutput", "1 2\n3 4 5\n", Exits{0, "OK\n\n100\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    double x;
-    s >> oi::Num{x, 0, 0} >> '\n';
-    s >> oi::Num{x, 0, 0} >> '\n';
-    s >> oi::Num{x, 3141592653580000000000000000000000.0, 3141592653590000000000000000000000.0} >> '\n';
-    s >> oi::Num{x, -3141592653590000000000000000000000.0, -3141592653580000000000000000000000.0} >> '\n';
-    s >> oi::Num{x, 0.000000000000000000000000000314159265358, 0.000000000000000000000000000314159265359} >> '\n';
-    s >> oi::Num{x, -0.000000000000000000000000000314159265359, -0.000000000000000000000000000314159265358} >> '\n';
-    s >> oi::Num{x, 3141592.65358, 3141592.65359} >> '\n';
-    s >> oi::Num{x, -3141592.65359, -3141592.65358} >> '\n';
+    int sum = 0;
+    for (int x : oi::tokens(s, 1, 5).take(2)) { sum += x; }
+    s >> oi::nl;
+    for (int x : oi::tokens(s, 1, 5).take(0)) { sum += 100 * x; }
+    for (int64_t x : oi::tokens<int64_t>(s, 1, 5)) {
+        sum += static_cast<int>(x);
+        if (x == 4) { break; }
+    }
+    if (sum != 10) { std::terminate(); }
+    s >> oi::Num{sum, 5, 5} >> oi::nl >> oi::eof;
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput)::operator>>(Num<double>)", R"(0
--0
-3141592653589793238462643383279502
--3141592653589793238462643383279502
-0.0000000000000000000000000003141592653589793238462643383279502
--0.0000000000000000000000000003141592653589793238462643383279502
-3141592.653589793238462643383279502
--3141592.653589793238462643383279502
-)", Exits{0, ""}) {
+TEST("tokens() UserOutput, PL out of range", "3 1 9 2\n", Exits{0, "WRONG\nWiersz 1, pozycja 5: Liczba calkowita spoza zakresu\n0\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
+    int k;
+    s >> oi::Num{k, 1, 3};
+    for (int x : oi::tokens(s, 1, 5).take(static_cast<size_t>(k))) { (void)x; }
+}
+
+TEST("tokens() TestInput separated_by()", "1 2 3\n", Exits{0, ""}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    double x;
-    s >> oi::Num{x, 0, 0} >> '\n';
-    s >> oi::Num{x, 0, 0} >> '\n';
-    s >> oi::Num{x, 3141592653580000000000000000000000.0, 3141592653590000000000000000000000.0} >> '\n';
-    s >> oi::Num{x, -3141592653590000000000000000000000.0, -3141592653580000000000000000000000.0} >> '\n';
-    s >> oi::Num{x, 0.000000000000000000000000000314159265358, 0.000000000000000000000000000314159265359} >> '\n';
-    s >> oi::Num{x, -0.000000000000000000000000000314159265359, -0.000000000000000000000000000314159265358} >> '\n';
-    s >> oi::Num{x, 3141592.65358, 3141592.65359} >> '\n';
-    s >> oi::Num{x, -3141592.65359, -3141592.65358} >> '\n';
+    int sum = 0;
+    for (int x : oi::tokens(s, 1, 3).separated_by(' ').take(3)) { sum += x; }
+    s >> oi::nl >> oi::eof;
+    if (sum != 6) { std::terminate(); }
     oi::inwer_verdict.exit_ok();
 }
 
-TEST("Scanner(Lax)::operator>>(Num<double>)", R"(0
--0
-3141592653589793238462643383279502
--3141592653589793238462643383279502
-0.0000000000000000000000000003141592653589793238462643383279502
--0.0000000000000000000000000003141592653589793238462643383279502
-3141592.653589793238462643383279502
--3141592.653589793238462643383279502
-)", Exits{0, "OK\n\n100\n"}) {
+TEST("tokens() TestInput without a separator", "1 2 3\n", Exits{1, "Line 1, position 2: Read ' ', expected a number\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    for (int x : oi::tokens(s, 1, 3).take(3)) { (void)x; }
+}
+
+TEST("tokens() reads lazily", "1 2 x", Exits{4, "Lax scanner: Line 1, position 5: Read 'x', expected a number\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    double x;
-    s >> oi::Num{x, 0, 0} >> '\n';
-    s >> oi::Num{x, 0, 0} >> '\n';
-    s >> oi::Num{x, 3141592653580000000000000000000000.0, 3141592653590000000000000000000000.0} >> '\n';
-    s >> oi::Num{x, -3141592653590000000000000000000000.0, -3141592653580000000000000000000000.0} >> '\n';
-    s >> oi::Num{x, 0.000000000000000000000000000314159265358, 0.000000000000000000000000000314159265359} >> '\n';
-    s >> oi::Num{x, -0.000000000000000000000000000314159265359, -0.000000000000000000000000000314159265358} >> '\n';
-    s >> oi::Num{x, 3141592.65358, 3141592.65359} >> '\n';
-    s >> oi::Num{x, -3141592.65359, -3141592.65358} >> '\n';
-    oi::checker_verdict.exit_ok();
+    auto it = oi::tokens(s, 1, 2).take(3).begin();
+    if (*it != 1) { std::terminate(); }
+    ++it;
+    if (*it != 2 || it == std::default_sentinel) { std::terminate(); }
+    ++it;
 }
 
-TEST("Scanner(UserOutput, EN)::operator>>(Num<double>)", "3141592.653589793238462643383279502", Exits{0, "WRONG\nLine 1, position 35: Real number value out of range\n0\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    double x;
-    s >> oi::Num{x, 3141592.65359, std::numeric_limits<decltype(x)>::max()} >> '\n';
+TEST("ScoreAggregator all passed", "", Exits{0, "OK\n\n100\n"}) {
+    oi::ScoreAggregator score{oi::Lang::EN};
+    for (int i = 0; i < 3; ++i) { score.pass(); }
+    score.exit_with_verdict();
 }
 
-TEST("Scanner(UserOutput, PL)::operator>>(Num<double>)", "3141592.653589793238462643383279502", Exits{0, "WRONG\nWiersz 1, pozycja 35: Liczba rzeczywista spoza zakresu\n0\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    double x;
-    s >> oi::Num{x, 3141592.65359, std::numeric_limits<decltype(x)>::max()} >> '\n';
+TEST("ScoreAggregator(EN) proportional", "", Exits{0, "OK\nTest case 2: bad 7\n33\n"}) {
+    oi::ScoreAggregator score{oi::Lang::EN};
+    score.pass();
+    score.fail("bad ", 7);
+    score.fail("ignored");
+    if (score.passed_count() != 1 || score.failed_count() != 2) { std::terminate(); }
+    score.exit_with_verdict();
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(Num<double>)", "3141592.653589793238462643383279502", Exits{1, "Line 1, position 35: Real number value out of range\n"}) {
+TEST("ScoreAggregator(PL) without a message", "", Exits{0, "WRONG\nPrzypadek testowy 1\n0\n"}) {
+    oi::ScoreAggregator score{oi::Lang::PL};
+    score.fail();
+    score.exit_with_verdict();
+}
+
+TEST("ScoreAggregator(EN) all_or_nothing", "", Exits{0, "WRONG\nTest case 3: x\n0\n"}) {
+    oi::ScoreAggregator score{oi::Lang::EN, oi::ScoreAggregator::all_or_nothing};
+    score.pass();
+    score.pass();
+    score.fail('x');
+    score.pass();
+    score.exit_with_verdict();
+}
+
+TEST("ScoreAggregator(EN) custom scoring", "", Exits{0, "OK\nTest case 1\n25\n"}) {
+    oi::ScoreAggregator score{oi::Lang::EN, [](uint64_t passed, uint64_t total) { return passed * 2 >= total ? 25 : 0; }};
+    score.fail();
+    score.pass();
+    score.exit_with_verdict();
+}
+
+TEST("Constraint", "3\n2\n1\n", Exits{0, ""}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    double x;
-    s >> oi::Num{x, 3141592.65359, std::numeric_limits<decltype(x)>::max()} >> '\n';
+    oi::Constraint total{"n", 6};
+    for (int i = 0; i < 3; ++i) {
+        int n;
+        s >> oi::Num{n, 1, 3}.sum_into(total) >> oi::nl;
+        total.end_test_case(s);
+    }
+    if (total.value() != 6 || total.exceeded()) { std::terminate(); }
+    s >> oi::eof;
+    oi::inwer_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(Num<double>)", "3141592.653589793238462643383279502", Exits{1, "Wiersz 1, pozycja 35: Liczba rzeczywista spoza zakresu\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    double x;
-    s >> oi::Num{x, 3141592.65359, std::numeric_limits<decltype(x)>::max()} >> '\n';
+TEST("Constraint(TestInput, EN) exceeded", "1\n3 3\n2 2\n", Exits{1, "Line 3, position 4: Test case 3: sum of n exceeds 5\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    oi::Constraint total_n{"n", 5}, total_m{"m", 100};
+    for (int i = 0; i < 3; ++i) {
+        int n, m = 0;
+        s >> oi::Num{n, 1, 3}.sum_into(total_n);
+        if (i > 0) {
+            s >> ' ' >> oi::Num{m, 1, 3}.sum_into(total_m);
+        }
+        s >> oi::nl;
+        total_n.end_test_case(s);
+        total_m.end_test_case(s);
+    }
 }
 
-TEST("Scanner(Lax, EN)::operator>>(Num<double>)", "3141592.653589793238462643383279502", Exits{4, "Lax scanner: Line 1, position 35: Real number value out of range\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    double x;
-    s >> oi::Num{x, 3141592.65359, std::numeric_limits<decltype(x)>::max()} >> '\n';
+TEST("Constraint(Lax, PL) overflow", "9223372036854775807 1\n", Exits{4, "Lax scanner: Wiersz 1, pozycja 21: Przypadek testowy 1: suma a przekracza 9223372036854775807\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
+    oi::Constraint total{"a", std::numeric_limits<int64_t>::max()};
+    int64_t a;
+    s >> oi::Num{a, int64_t{0}, std::numeric_limits<int64_t>::max()}.sum_into(total);
+    s >> oi::Num{a, int64_t{0}, std::numeric_limits<int64_t>::max()}.sum_into(total);
+    total.end_test_case(s);
+}
+
+TEST("Constraint unsigned overflow", "", Exits{0, ""}) {
+    oi::Constraint total{"a", 10};
+    total.add(std::numeric_limits<uint64_t>::max());
+    if (!total.exceeded()) { std::terminate(); }
+    oi::Constraint negative{"b", -5};
+    negative.add(-3);
+    negative.add(-3);
+    if (negative.exceeded() || negative.value() != -6) { std::terminate(); }
+    oi::inwer_verdict.exit_ok();
+}
+
+TEST("Scanner(Trusted) skips checks", "  12\n-5 abc  \n\nline here\n  x\n 7 8\n", Exits{0, ""}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Trusted, oi::Lang::EN};
+    int a, b;
+    string str, line;
+    char c;
+    s >> oi::Num{a, 0, 1} >> oi::nl >> oi::Num{b, 0, 1} >> ' ' >> oi::Str{str, 1} >> oi::nl >> oi::nl;
+    s >> oi::Line{line, 1} >> oi::nl >> oi::Char{c, "y"} >> oi::nl;
+    if (a != 12 || b != -5 || str != "abc" || line != "line here" || c != 'x') { std::terminate(); }
+    s >> oi::Num{a, 0, 1} >> oi::Num{b, 0, 1} >> oi::eof;
+    if (a != 7 || b != 8) { std::terminate(); }
+    oi::inwer_verdict.exit_ok();
+}
+
+TEST("Scanner(Trusted) in memory", "3\n1 2\n\n3 4\n5 6\n", Exits{0, ""}) {
+    auto s = oi::Scanner{"/dev/stdin", oi::Scanner::Mode::Trusted, oi::Lang::EN};
+    uint64_t k;
+    int64_t x;
+    s >> oi::Num{k, uint64_t{0}, uint64_t{0}} >> oi::nl;
+    auto m = s.mark();
+    s.skip_lines(k) >> oi::Num{x, int64_t{0}, int64_t{0}};
+    if (k != 3 || x != 5) { std::terminate(); }
+    s.rewind(m);
+    s >> oi::Num{x, int64_t{0}, int64_t{0}};
+    if (x != 1) { std::terminate(); }
+    oi::inwer_verdict.exit_ok();
+}
+
+TEST("Scanner(Trusted, EN) malformed number", "\n  ab", Exits{2, "BUG: Trusted scanner: Read 'a', expected a number\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Trusted, oi::Lang::EN};
+    int a;
+    s >> oi::Num{a, 0, 1};
+}
+
+TEST("Scanner(Trusted, PL) EOF instead of a number", "  ", Exits{2, "BUG: Trusted scanner: Wczytano EOF, oczekiwano liczby\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Trusted, oi::Lang::PL};
+    int a;
+    s >> oi::Num{a, 0, 1};
+}
+
+TEST("Scanner(Trusted, EN)::operator>>(EofType)", "1 \n x", Exits{2, "BUG: Trusted scanner: Read 'x', expected EOF\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Trusted, oi::Lang::EN};
+    int a;
+    s >> oi::Num{a, 0, 1} >> oi::eof;
+}
+
+TEST("Scanner(Trusted, EN)::operator>>(const char&)", "1,2", Exits{2, "BUG: Trusted scanner: Read '2', expected ','\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Trusted, oi::Lang::EN};
+    int a;
+    s >> oi::Num{a, 0, 1} >> ',' >> ',';
+}
+
+TEST("Scanner(TestInput)::operator>>(CNum)", "007 -0 1000000 -5 0\n", Exits{0, ""}) {
+    {
+        auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+        int a, b, c, d;
+        unsigned e;
+        using Int = oi::CNum<int, -5, 1'000'000>;
+        s >> Int{a} >> ' ' >> Int{b} >> ' ' >> Int{c} >> ' ' >> Int{d} >> ' ' >> oi::CNum<unsigned, 0, 0>{e} >> oi::nl;
+        if (a != 7 || b != 0 || c != 1'000'000 || d != -5 || e != 0) { std::terminate(); }
+    }
+    int64_t x;
+    auto s = oi::Scanner{oi::Scanner::Memory{"-9223372036854775808"}, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    s >> oi::CNum<int64_t, std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()>{x};
+    if (x != std::numeric_limits<int64_t>::min()) { std::terminate(); }
+    oi::inwer_verdict.exit_ok();
 }
 
-TEST("Scanner(Lax, PL)::operator>>(Num<double>)", "3141592.653589793238462643383279502", Exits{4, "Lax scanner: Wiersz 1, pozycja 35: Liczba rzeczywista spoza zakresu\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    double x;
-    s >> oi::Num{x, 3141592.65359, std::numeric_limits<decltype(x)>::max()} >> '\n';
+TEST("Scanner(UserOutput, EN)::operator>>(CNum) above max", "  1001", Exits{0, "WRONG\nLine 1, position 6: Integer value out of range\n0\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    int a;
+    s >> oi::CNum<int, 1, 1000>{a};
 }
 
-TEST("Scanner(UserOutput, EN)::operator>>(Num<double>)", "-3141592.653589793238462643383279502", Exits{0, "WRONG\nLine 1, position 36: Real number value out of range\n0\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    double x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), -3141592.65359} >> '\n';
+TEST("Scanner(TestInput, PL)::operator>>(CNum) below min", "-6", Exits{1, "Wiersz 1, pozycja 2: Liczba calkowita spoza zakresu\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    int a;
+    s >> oi::CNum<int, -5, 5>{a};
 }
 
-TEST("Scanner(UserOutput, PL)::operator>>(Num<double>)", "-3141592.653589793238462643383279502", Exits{0, "WRONG\nWiersz 1, pozycja 36: Liczba rzeczywista spoza zakresu\n0\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    double x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), -3141592.65359} >> '\n';
+TEST("Scanner(Lax, EN)::operator>>(CNum) too many digits", "000012345678901234567890", Exits{4, "Lax scanner: Line 1, position 9: Integer value out of range\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
+    int a;
+    s >> oi::CNum<int, 1, 1000>{a};
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(Num<double>)", "-3141592.653589793238462643383279502", Exits{1, "Line 1, position 36: Real number value out of range\n"}) {
+TEST("Scanner(TestInput, EN)::operator>>(CNum<unsigned>)", "-1", Exits{1, "Line 1, position 1: Read '-', expected a non-negative number\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    double x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), -3141592.65359} >> '\n';
+    unsigned a;
+    s >> oi::CNum<unsigned, 0, 10>{a};
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(Num<double>)", "-3141592.653589793238462643383279502", Exits{1, "Wiersz 1, pozycja 36: Liczba rzeczywista spoza zakresu\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    double x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), -3141592.65359} >> '\n';
+TEST("Scanner(Trusted)::operator>>(CNum)", "12345", Exits{0, ""}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Trusted, oi::Lang::EN};
+    int a;
+    s >> oi::CNum<int, 1, 10>{a};
+    if (a != 12345) { std::terminate(); }
+    oi::inwer_verdict.exit_ok();
 }
 
-TEST("Scanner(Lax, EN)::operator>>(Num<double>)", "-3141592.653589793238462643383279502", Exits{4, "Lax scanner: Line 1, position 36: Real number value out of range\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    double x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), -3141592.65359} >> '\n';
+TEST("Scanner(Lax, EN)::operator>>(CNum) in memory too many digits", "000012345678901234567890", Exits{4, "Lax scanner: Line 1, position 9: Integer value out of range\n"}) {
+    auto s = oi::Scanner{"/dev/stdin", oi::Scanner::Mode::Lax, oi::Lang::EN};
+    int a;
+    s >> oi::CNum<int, 1, 1000>{a};
 }
 
-TEST("Scanner(Lax, PL)::operator>>(Num<double>)", "-3141592.653589793238462643383279502", Exits{4, "Lax scanner: Wiersz 1, pozycja 36: Liczba rzeczywista spoza zakresu\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    double x;
-    s >> oi::Num{x, std::numeric_limits<decltype(x)>::lowest(), -3141592.65359} >> '\n';
+TEST("Scanner(TestInput, EN)::operator>>(CNum) in memory", "12 345\n6", Exits{1, "Line 2, position 1: Read '6', expected EOF\n"}) {
+    auto s = oi::Scanner{"/dev/stdin", oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    int a, b;
+    s >> oi::CNum<int, 1, 1000>{a} >> ' ' >> oi::CNum<int, 1, 1000>{b} >> oi::nl;
+    if (a != 12 || b != 345) { std::terminate(); }
+}
+
+TEST("Scanner(TestInput)::operator>>(Grid)", "#.#.\n....\n##.#\n", Exits{0, ""}) {
+    auto s = oi::Scanner{fdopen(dup(0), "r"), oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    auto m = oi::Scanner{"/dev/stdin", oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    string a, b;
+    s >> oi::Grid{a, 3, 4, ".#"} >> oi::nl >> oi::eof;
+    m >> oi::Grid{b, 3, 4, ".#"} >> oi::nl >> oi::eof;
+    if (a != "#.#.....##.#" || a != b) { std::terminate(); }
+    oi::inwer_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput, EN)::operator>>(Num<double>) whitespace is ignored", " 0", Exits{0, "OK\n\n100\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    double x;
-    s >> oi::Num{x, 0, 0};
-    if (x != 0) { std::terminate(); }
-    oi::checker_verdict.exit_ok();
+TEST("Scanner(TestInput, EN)::operator>>(Grid) in memory wrong char", "....................\n.................x..\n", Exits{1, "Line 2, position 18: Read 'x', expected one of characters: .#\n"}) {
+    auto s = oi::Scanner{"/dev/stdin", oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    string g;
+    s >> oi::Grid{g, 2, 20, ".#"};
 }
 
-TEST("Scanner(UserOutput, PL)::operator>>(Num<double>) whitespace is ignored", " 0", Exits{0, "OK\n\n100\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    double x;
-    s >> oi::Num{x, 0, 0};
-    if (x != 0) { std::terminate(); }
-    oi::checker_verdict.exit_ok();
+TEST("Scanner(TestInput, EN)::operator>>(Grid) wrong char", "....................\n.................x..\n", Exits{1, "Line 2, position 18: Read 'x', expected one of characters: .#\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    string g;
+    s >> oi::Grid{g, 2, 20, ".#"};
 }
 
-TEST("Scanner(TestInput, EN)::operator>>(Num<double>) whitespace is not ignored", " 0", Exits{1, "Line 1, position 1: Read ' ', expected a number\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    double x;
-    s >> oi::Num{x, 0, 0};
+TEST("Scanner(TestInput, PL)::operator>>(Grid) in memory short row", "abc\nab\nabc\n", Exits{1, "Wiersz 2, pozycja 3: Wczytano '\\n', oczekiwano jednego ze znakow: abc\n"}) {
+    auto s = oi::Scanner{"/dev/stdin", oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    string g;
+    s >> oi::Grid{g, 3, 3, "abc"};
 }
 
-TEST("Scanner(TestInput, PL)::operator>>(Num<double>) whitespace is not ignored", " 0", Exits{1, "Wiersz 1, pozycja 1: Wczytano ' ', oczekiwano liczby\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    double x;
-    s >> oi::Num{x, 0, 0};
+TEST("Scanner(TestInput, EN)::operator>>(Grid) in memory long row", "abc\nabca\nabc\n", Exits{1, "Line 2, position 4: Read 'a', expected '\\n'\n"}) {
+    auto s = oi::Scanner{"/dev/stdin", oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    string g;
+    s >> oi::Grid{g, 3, 3, "abc"};
 }
 
-TEST("Scanner(Lax, EN)::operator>>(Num<double>) whitespace is ignored", " 0", Exits{0, "OK\n\n100\n"}) {
+TEST("Scanner(UserOutput, EN)::operator>>(Grid) in memory EOF", "abc  \nab", Exits{0, "WRONG\nLine 2, position 3: Read EOF, expected one of characters: abc\n0\n"}) {
+    auto s = oi::Scanner{"/dev/stdin", oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    string g;
+    s >> oi::Grid{g, 2, 3, "abc"};
+}
+
+TEST("Scanner(Lax)::operator>>(Grid) trailing whitespace", "abc  \nabc\t\n", Exits{0, ""}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    double x;
-    s >> oi::Num{x, 0, 0};
-    if (x != 0) { std::terminate(); }
-    oi::checker_verdict.exit_ok();
+    string g;
+    s >> oi::Grid{g, 2, 3, "abc"} >> oi::nl >> oi::eof;
+    if (g != "abcabc") { std::terminate(); }
+    oi::inwer_verdict.exit_ok();
 }
 
-TEST("Scanner(Lax, PL)::operator>>(Num<double>) whitespace is ignored", " 0", Exits{0, "OK\n\n100\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
-    double x;
-    s >> oi::Num{x, 0, 0};
-    if (x != 0) { std::terminate(); }
-    oi::checker_verdict.exit_ok();
+TEST("Scanner(Trusted)::operator>>(Grid)", "axc\nabc\n", Exits{0, ""}) {
+    auto s = oi::Scanner{"/dev/stdin", oi::Scanner::Mode::Trusted, oi::Lang::EN};
+    string g;
+    s >> oi::Grid{g, 2, 3, "abc"};
+    if (g != "axcabc") { std::terminate(); }
+    oi::inwer_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput, EN)::~Scanner() scans eof", "a", Exits{0, "WRONG\nLine 1, position 1: Read 'a', expected EOF\n0\n"}) {
-    oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+TEST("Scanner(TestInput, EN)::operator>>(Line) too long", "abcd\nabcdefghijklmnop\n", Exits{1, "Line 2, position 11: Too long line\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    string x;
+    s >> oi::Line{x, 10} >> oi::nl >> oi::Line{x, 10};
 }
 
-TEST("Scanner(UserOutput, PL)::~Scanner() scans eof", "a", Exits{0, "WRONG\nWiersz 1, pozycja 1: Wczytano 'a', oczekiwano EOF\n0\n"}) {
-    oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
+TEST("Scanner(UserOutput, PL)::operator>>(Line) in memory too long", "abcd\nabcdefghijklmnop\n", Exits{0, "WRONG\nWiersz 2, pozycja 11: Zbyt dlugi wiersz\n0\n"}) {
+    auto s = oi::Scanner{"/dev/stdin", oi::Scanner::Mode::UserOutput, oi::Lang::PL};
+    string x;
+    s >> oi::Line{x, 10} >> oi::nl >> oi::Line{x, 10};
 }
 
-TEST("Scanner(TestInput, EN)::~Scanner() scans eof", "a", Exits{1, "Line 1, position 1: Read 'a', expected EOF\n"}) {
-    oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+TEST("Scanner(Lax)::operator>>(Line) in memory exactly max_size", "a\nabcdefghij", Exits{0, ""}) {
+    auto s = oi::Scanner{"/dev/stdin", oi::Scanner::Mode::Lax, oi::Lang::EN};
+    string x;
+    s >> oi::Line{x, 1} >> oi::nl >> oi::Line{x, 10} >> oi::eof;
+    if (x != "abcdefghij") { std::terminate(); }
+    oi::inwer_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput, PL)::~Scanner() scans eof", "a", Exits{1, "Wiersz 1, pozycja 1: Wczytano 'a', oczekiwano EOF\n"}) {
-    oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
+TEST("Scanner(TestInput, EN)::operator>>(Line) fd across refills", "", Exits{1, "Line 2, position 150001: Too long line\n"}) {
+    int fd = memfd_create("oi.h test line", 0);
+    string data = "x\n" + string(200'000, 'a') + "b\n";
+    if (fd == -1 || pwrite(fd, data.data(), data.size(), 0) != static_cast<ssize_t>(data.size())) { std::terminate(); }
+    {
+        auto s = oi::Scanner{fd, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+        string x;
+        s >> oi::Line{x, 1} >> oi::nl >> oi::Line{x, 200'001} >> oi::nl >> oi::eof;
+        if (x.size() != 200'001 || x.back() != 'b') { std::terminate(); }
+    }
+    (void)lseek(fd, 0, SEEK_SET);
+    auto s = oi::Scanner{fd, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    string x;
+    s >> oi::Line{x, 1} >> oi::nl >> oi::Line{x, 150'000};
 }
 
-TEST("Scanner(Lax)::~Scanner() does not scan eof", "a", Exits{0, "OK\n\n100\n"}) {
-    oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    oi::checker_verdict.exit_ok();
+TEST("read_sequence()", "1 3 5 10\n", Exits{0, "1 3 5 10\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    auto a = oi::read_sequence(s, 4, 1, 10, {.order = oi::SequenceOrder::Increasing, .distinct = true, .max_sum = 19});
+    s >> oi::nl;
+    oi::Writer w{STDOUT_FILENO};
+    for (size_t i = 0; i < a.size(); ++i) {
+        w << a[i] << (i + 1 == a.size() ? '\n' : ' ');
+    }
+    w.flush();
+    oi::inwer_verdict.exit_ok();
 }
 
-#undef exit
-TEST("Scanner(UserOutput, EN) exit() scans eof", "a", Exits{0, "WRONG\nLine 1, position 1: Read 'a', expected EOF\n0\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    exit(42);
+TEST("read_sequence() not increasing", "1 3 3 4\n", Exits{1, "Line 1, position 5: Element 3 is not greater than the previous one\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    (void)oi::read_sequence(s, 4, 1, 10, {.order = oi::SequenceOrder::Increasing});
 }
 
-TEST("Scanner(UserOutput, PL) exit() scans eof", "a", Exits{0, "WRONG\nWiersz 1, pozycja 1: Wczytano 'a', oczekiwano EOF\n0\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    exit(42);
+TEST("read_sequence() not non-increasing", "5 5 6\n", Exits{1, "Wiersz 1, pozycja 5: Element 3 jest wiekszy od poprzedniego\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    (void)oi::read_sequence(s, 3, 1, 10, {.order = oi::SequenceOrder::NonIncreasing});
 }
 
-TEST("Scanner(TestInput, EN) exit() scans eof", "a", Exits{1, "Line 1, position 1: Read 'a', expected EOF\n"}) {
+TEST("read_sequence() not distinct, bounded range", "4 1 4 2\n", Exits{1, "Line 1, position 5: Element 3 repeats value 4\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    exit(42);
+    (void)oi::read_sequence(s, 4, 1, 10, {.distinct = true});
 }
 
-TEST("Scanner(TestInput, PL) exit() scans eof", "a", Exits{1, "Wiersz 1, pozycja 1: Wczytano 'a', oczekiwano EOF\n"}) {
+TEST("read_sequence() not distinct, unbounded range", "1000000000 7 1000000000\n", Exits{1, "Wiersz 1, pozycja 23: Element 3 powtarza wartosc 1000000000\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    exit(42);
+    (void)oi::read_sequence(s, 3, -1'000'000'000, 1'000'000'000, {.distinct = true});
 }
 
-TEST("Scanner(Lax) exit() does not scan eof", "a", Exits{42, ""}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    exit(42);
+TEST("read_sequence() distinct, reused between calls", "", Exits{0, "OK\n\n100\n"}) {
+    for (int round = 0; round < 1000; ++round) {
+        oi::Scanner s{oi::Scanner::Memory{"3 1 2 5"}, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+        auto a = oi::read_sequence<uint64_t>(s, 4, 1, 5, {.distinct = true});
+        if (a != vector<uint64_t>{3, 1, 2, 5}) { std::terminate(); }
+    }
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput, EN) checker_verdict.exit_ok() scans eof", "a", Exits{0, "WRONG\nLine 1, position 1: Read 'a', expected EOF\n0\n"}) {
+TEST("read_sequence() sum exceeded", "3 4 5 1\n", Exits{0, "WRONG\nLine 1, position 5: Sum of the first 3 elements exceeds 10\n0\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    oi::checker_verdict.exit_ok();
+    (void)oi::read_sequence(s, 4, 0, 10, {.max_sum = 10});
 }
 
-TEST("Scanner(UserOutput, PL) checker_verdict.exit_ok() scans eof", "a", Exits{0, "WRONG\nWiersz 1, pozycja 1: Wczytano 'a', oczekiwano EOF\n0\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
+TEST("read_sequence() sum with negative numbers", "20 -5 -10\n", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    (void)oi::read_sequence(s, 3, -100, 100, {.max_sum = 10});
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput, EN) inwer_verdict.ok() scans eof", "a", Exits{1, "Line 1, position 1: Read 'a', expected EOF\n"}) {
+TEST("read_sequence() sum with negative numbers exceeded", "20 -5 -1\n", Exits{1, "Wiersz 1, pozycja 8: Suma pierwszych 3 elementow przekracza 10\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    (void)oi::read_sequence(s, 3, -100, 100, {.max_sum = 10});
+}
+
+TEST("read_sequence() sum overflow", "9223372036854775807 1\n", Exits{1, "Line 1, position 21: Sum of the first 2 elements exceeds 9223372036854775807\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    oi::inwer_verdict.exit_ok();
+    (void)oi::read_sequence<int64_t>(s, 2, 0, std::numeric_limits<int64_t>::max(), {.max_sum = std::numeric_limits<int64_t>::max()});
 }
 
-TEST("Scanner(TestInput, PL) inwer_verdict.ok() scans eof", "a", Exits{1, "Wiersz 1, pozycja 1: Wczytano 'a', oczekiwano EOF\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    oi::inwer_verdict.exit_ok();
+TEST("read_sequence() intermediate sum overflows, total fits", "9223372036854775807 1 -5\n-9223372036854775808 -1 1\n", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    constexpr auto min = std::numeric_limits<int64_t>::min(), max = std::numeric_limits<int64_t>::max();
+    (void)oi::read_sequence<int64_t>(s, 3, min, max, {.max_sum = max});
+    s >> oi::nl;
+    // The running sum goes below INT64_MIN, which is not exceeding max_sum
+    (void)oi::read_sequence<int64_t>(s, 3, min, max, {.max_sum = -5});
+    s >> oi::nl;
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(Lax) checker_verdict.exit_ok() does not scan eof", "a", Exits{0, "OK\n\n100\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
+TEST("read_sequence() sum of uint64_t", "18446744073709551615 18446744073709551615\n", Exits{1, "Line 1, position 20: Sum of the first 1 elements exceeds 9223372036854775807\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    (void)oi::read_sequence<uint64_t>(s, 2, 0, std::numeric_limits<uint64_t>::max(), {.max_sum = std::numeric_limits<int64_t>::max()});
+}
+
+TEST("validate_bytes() clean input", "", Exits{0, "OK\n\n100\n"}) {
+    oi::Scanner s{oi::Scanner::Memory{"1 2\nabc def\n"}, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    oi::validate_bytes(s);
+    int a, b;
+    string str;
+    s >> oi::Num{a, 1, 2} >> ' ' >> oi::Num{b, 1, 2} >> oi::nl >> oi::Line{str, 10} >> oi::nl >> oi::eof;
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput, EN) checker_verdict.exit_ok_with_score(100, msg) scans eof", "a", Exits{0, "WRONG\nLine 1, position 1: Read 'a', expected EOF\n0\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    oi::checker_verdict.exit_ok_with_score(100, "abc");
+TEST("validate_bytes() carriage return", "", Exits{1, "Line 1, position 3: Forbidden character '\\r'\n"}) {
+    oi::Scanner s{oi::Scanner::Memory{"ab\r\ncd\n"}, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    oi::validate_bytes(s);
 }
 
-TEST("Scanner(UserOutput, PL) checker_verdict.exit_ok_with_score(100, msg) scans eof", "a", Exits{0, "WRONG\nWiersz 1, pozycja 1: Wczytano 'a', oczekiwano EOF\n0\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    oi::checker_verdict.exit_ok_with_score(100, "abc");
+TEST("validate_bytes() trailing whitespace", "", Exits{1, "Line 3, position 4: Whitespace at the end of the line\n"}) {
+    oi::Scanner s{oi::Scanner::Memory{"0123456789 0123456789\nxyz\nfoo \t \nbar\n"}, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    oi::validate_bytes(s, {.allow_tab = true});
 }
 
-TEST("Scanner(Lax) checker_verdict.exit_ok_with_score(100, msg) does not scan eof", "a", Exits{0, "OK\nabc\n100\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    oi::checker_verdict.exit_ok_with_score(100, "abc");
+TEST("validate_bytes() trailing whitespace at EOF", "", Exits{1, "Wiersz 2, pozycja 3: Bialy znak na koncu wiersza\n"}) {
+    oi::Scanner s{oi::Scanner::Memory{"abc\nde   "}, oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    oi::validate_bytes(s);
 }
 
-TEST("Scanner(UserOutput) checker_verdict.exit_ok_with_score(99, msg) does not scan eof", "a", Exits{0, "OK\nabc\n99\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    oi::checker_verdict.exit_ok_with_score(99, "abc");
+TEST("validate_bytes() on stdin", "1 2\nabc de \n", Exits{1, "Line 2, position 7: Whitespace at the end of the line\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    int a;
+    s >> oi::Num{a, 1, 1} >> ' ';
+    oi::validate_bytes(s);
 }
 
-TEST("Scanner(Lax) checker_verdict.exit_ok_with_score(99, msg) does not scan eof", "a", Exits{0, "OK\nabc\n99\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    oi::checker_verdict.exit_ok_with_score(99, "abc");
+TEST("validate_bytes() on stdin, then scanning", "1 2\nabc def\n", Exits{0, "OK\n\n100\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    int a, b;
+    string str;
+    s >> oi::Num{a, 1, 1} >> ' ' >> oi::Num{b, 2, 2};
+    oi::validate_bytes(s);
+    if (!s.is_in_memory()) { std::terminate(); }
+    s >> oi::nl >> oi::Line{str, 10} >> oi::nl >> oi::eof;
+    if (str != "abc def") { std::terminate(); }
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput) partial score == 99 checker_verdict.wrong() does not scan eof", "a", Exits{0, "OK\nabc; xyz\n99\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    oi::checker_verdict.set_partial_score(99, "abc");
-    oi::checker_verdict.exit_wrong("xyz");
+TEST("validate_bytes() trailing whitespace allowed", "", Exits{0, "OK\n\n100\n"}) {
+    oi::Scanner s{oi::Scanner::Memory{"0123456789 0123456789\nxyz\nfoo \nbar\n"}, oi::Scanner::Mode::Lax, oi::Lang::EN};
+    oi::validate_bytes(s, {.allow_trailing_whitespace = true});
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(Lax) partial score == 99 checker_verdict.wrong() does not scan eof", "a", Exits{0, "OK\nabc; xyz\n99\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    oi::checker_verdict.set_partial_score(99, "abc");
-    oi::checker_verdict.exit_wrong("xyz");
+TEST("validate_bytes() non-ASCII", "", Exits{1, "Wiersz 2, pozycja 1: Niedozwolony znak '\\xc5'\n"}) {
+    oi::Scanner s{oi::Scanner::Memory{"a\tb\n\xc5\x82\n"}, oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    oi::validate_bytes(s, {.allow_tab = true});
 }
 
-TEST("Scanner(UserOutput) checker_verdict.wrong() does not scan eof", "a", Exits{0, "WRONG\nabc\n0\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    oi::checker_verdict.exit_wrong("abc");
+TEST("validate_bytes() no final newline", "", Exits{0, "WRONG\nLine 2, position 2: No newline at the end of the input\n0\n"}) {
+    oi::Scanner s{oi::Scanner::Memory{"abc\nde"}, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+    oi::validate_bytes(s);
 }
 
-TEST("Scanner(TestInput) inwer_verdict.exit_wrong() does not scan eof", "a", Exits{1, "abc\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    oi::inwer_verdict.exit_wrong() << "abc";
+TEST("validate_bytes() empty input", "", Exits{1, "Wiersz 1, pozycja 1: Brak znaku nowej linii na koncu wejscia\n"}) {
+    oi::Scanner s{oi::Scanner::Memory{""}, oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    oi::validate_bytes(s);
 }
 
-TEST("Scanner(Lax) checker_verdict.wrong() does not scan eof", "a", Exits{0, "WRONG\nabc\n0\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
-    oi::checker_verdict.exit_wrong("abc");
+TEST("validate_bytes() after a token", "", Exits{1, "Line 1, position 4: Forbidden character '\\x01'\n"}) {
+    oi::Scanner s{oi::Scanner::Memory{"5 x\x01\n"}, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    int x;
+    s >> oi::Num{x, 1, 9};
+    oi::validate_bytes(s);
 }
 
-TEST("Scanner(UserOutput, EN)::constructor(FILE*) makes checker_verdict.exit_ok() scan eof", "a", Exits{0, "WRONG\nLine 1, position 1: Read 'a', expected EOF\n0\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+TEST("validate_bytes() finds the first violation at every offset", "", Exits{0, "OK\n\n100\n"}) {
+    for (size_t len = 1; len < 80; ++len) {
+        string str(len, 'a');
+        for (size_t i = 6; i < len; i += 7) {
+            str[i] = '\n';
+        }
+        for (size_t k = 0; k < len; ++k) {
+            for (char bad : {'\x7f', '\0', ' '}) {
+                string s = str;
+                s[k] = bad;
+                if (bad == ' ' && k + 1 < len && s[k + 1] != '\n') {
+                    continue;
+                }
+                auto res = oi::detail::first_byte_violation(s.data(), s.size(), {});
+                auto newlines = static_cast<size_t>(std::count(s.begin(), s.begin() + static_cast<ptrdiff_t>(k), '\n'));
+                if (res.index != k || res.newlines != newlines) { std::terminate(); }
+            }
+        }
+        auto res = oi::detail::first_byte_violation(str.data(), str.size(), {});
+        if (res.index != len || res.newlines != static_cast<size_t>(std::count(str.begin(), str.end(), '\n'))) {
+            std::terminate();
+        }
+    }
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput, PL)::constructor(FILE*) makes checker_verdict.exit_ok() scan eof", "a", Exits{0, "WRONG\nWiersz 1, pozycja 1: Wczytano 'a', oczekiwano EOF\n0\n"}) {
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    oi::checker_verdict.exit_ok();
+TEST("graph_checks::no_loops()", "1 2\n3 3\n", Exits{1, "Edge 2 is a loop\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    oi::graph_checks::no_loops(oi::read_graph(s, 3, 2), oi::Lang::EN);
 }
 
-TEST("Scanner(TestInput, EN)::constructor(FILE*) makes inwer_verdict.ok() scan eof", "a", Exits{1, "Line 1, position 1: Read 'a', expected EOF\n"}) {
+TEST("graph_checks::no_multi_edges() undirected", "1 2\n2 3\n3 2\n2 1\n", Exits{1, "Edges 2 and 3 connect the same vertices\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    oi::inwer_verdict.exit_ok();
+    oi::graph_checks::no_multi_edges(oi::read_graph(s, 3, 4), oi::Lang::EN);
 }
 
-TEST("Scanner(TestInput, PL)::constructor(FILE*) makes inwer_verdict.ok() scan eof", "a", Exits{1, "Wiersz 1, pozycja 1: Wczytano 'a', oczekiwano EOF\n"}) {
+TEST("graph_checks::no_multi_edges() directed", "1 2\n2 1\n3 3\n1 2\n", Exits{1, "Krawedzie 1 i 4 lacza te same wierzcholki\n"}) {
     auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    oi::inwer_verdict.exit_ok();
+    auto g = oi::read_graph(s, 3, 4, {.directed = true});
+    oi::graph_checks::no_multi_edges(g, oi::Lang::PL);
 }
 
-TEST("Scanner(UserOutput, EN)::constructor(const char*) makes checker_verdict.exit_ok() scan eof", "a", Exits{0, "WRONG\nLine 1, position 1: Read 'a', expected EOF\n0\n"}) {
-    auto s = oi::Scanner{"/dev/stdin", oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    oi::checker_verdict.exit_ok();
+TEST("graph_checks::connected()", "1 2\n3 4\n", Exits{1, "Graph is not connected: vertex 3 is not reachable from vertex 1\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    oi::graph_checks::connected(oi::read_graph(s, 4, 2), oi::Lang::EN);
 }
 
-TEST("Scanner(UserOutput, PL)::constructor(const char*) makes checker_verdict.exit_ok() scan eof", "a", Exits{0, "WRONG\nWiersz 1, pozycja 1: Wczytano 'a', oczekiwano EOF\n0\n"}) {
-    auto s = oi::Scanner{"/dev/stdin", oi::Scanner::Mode::UserOutput, oi::Lang::PL};
-    oi::checker_verdict.exit_ok();
+TEST("graph_checks::tree() edge count", "1 2\n3 4\n", Exits{1, "Drzewo na 4 wierzcholkach ma 3 krawedzi, a nie 2\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    oi::graph_checks::tree(oi::read_graph(s, 4, 2), oi::Lang::PL);
 }
 
-TEST("Scanner(TestInput, EN)::constructor(const char*) makes inwer_verdict.ok() scan eof", "a", Exits{1, "Line 1, position 1: Read 'a', expected EOF\n"}) {
-    auto s = oi::Scanner{"/dev/stdin", oi::Scanner::Mode::TestInput, oi::Lang::EN};
-    oi::inwer_verdict.exit_ok();
+TEST("graph_checks::tree() cycle", "1 2\n2 3\n3 1\n", Exits{1, "Edge 3 closes a cycle\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    oi::graph_checks::tree(oi::read_graph(s, 4, 3), oi::Lang::EN);
 }
 
-TEST("Scanner(TestInput, PL)::constructor(const char*) makes inwer_verdict.ok() scan eof", "a", Exits{1, "Wiersz 1, pozycja 1: Wczytano 'a', oczekiwano EOF\n"}) {
-    auto s = oi::Scanner{"/dev/stdin", oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    oi::inwer_verdict.exit_ok();
+TEST("graph_checks::dag() cycle", "1 2\n2 3\n3 2\n", Exits{1, "Graf ma cykl\n"}) {
+    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
+    oi::graph_checks::dag(oi::read_graph(s, 3, 3, {.directed = true}), oi::Lang::PL);
 }
 
-TEST("Scanner(UserOutput, EN) destructed before checker_verdict.exit_ok() is ok", "a", Exits{0, "WRONG\nLine 1, position 1: Read 'a', expected EOF\n0\n"}) {
-    void* mem = mmap(nullptr, sizeof(oi::Scanner), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
-    if (mem == MAP_FAILED) { std::terminate(); }
-    auto dev_null_scanner = new (mem) oi::Scanner("/dev/null", oi::Scanner::Mode::UserOutput, oi::Lang::EN);
-    dev_null_scanner->~Scanner();
-    if (munmap(mem, sizeof(oi::Scanner))) {
-        std::terminate();
+TEST("graph_checks on a long path", "", Exits{0, "OK\n\n100\n"}) {
+    constexpr int n = 1'000'000;
+    string input;
+    for (int v = 1; v < n; ++v) {
+        input += std::to_string(v) + ' ' + std::to_string(v + 1) + '\n';
     }
-
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
-    oi::checker_verdict.exit_ok();
-}
-
-TEST("Scanner(UserOutput, EN) destructed before checker_verdict.exit_ok() is ok", "a", Exits{0, "WRONG\nLine 1, position 1: Read 'a', expected EOF\n0\n"}) {
-    void* mem = mmap(nullptr, sizeof(oi::Scanner), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
-    if (mem == MAP_FAILED) { std::terminate(); }
-    auto dev_null_scanner = new (mem) oi::Scanner("/dev/null", oi::Scanner::Mode::UserOutput, oi::Lang::EN);
-    dev_null_scanner->~Scanner();
-    if (munmap(mem, sizeof(oi::Scanner))) {
-        std::terminate();
+    for (bool directed : {false, true}) {
+        oi::Scanner s{oi::Scanner::Memory{input}, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+        auto g = oi::read_graph(s, n, n - 1, {.directed = directed});
+        oi::graph_checks::no_loops(g, oi::Lang::EN);
+        oi::graph_checks::no_multi_edges(g, oi::Lang::EN);
+        oi::graph_checks::connected(g, oi::Lang::EN);
+        if (directed) {
+            oi::graph_checks::dag(g, oi::Lang::EN);
+        } else {
+            oi::graph_checks::tree(g, oi::Lang::EN);
+        }
     }
-
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(UserOutput, PL) destructed before checker_verdict.exit_ok() is ok", "a", Exits{0, "WRONG\nWiersz 1, pozycja 1: Wczytano 'a', oczekiwano EOF\n0\n"}) {
-    void* mem = mmap(nullptr, sizeof(oi::Scanner), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
-    if (mem == MAP_FAILED) { std::terminate(); }
-    auto dev_null_scanner = new (mem) oi::Scanner("/dev/null", oi::Scanner::Mode::UserOutput, oi::Lang::PL);
-    dev_null_scanner->~Scanner();
-    if (munmap(mem, sizeof(oi::Scanner))) {
-        std::terminate();
+TEST("FirstFailure reports the earliest failed test case", "", Exits{0, "WRONG\nLine 1, position 1: Read 'a', expected a number\n0\n"}) {
+    const vector<string> cases = {"1", "7", "abc", "3", "4", "11", "5", "x"};
+    oi::FirstFailure first_failure;
+    vector<std::thread> workers;
+    // Later test cases start first, so that they fail first
+    for (size_t i = cases.size(); i-- > 0;) {
+        workers.emplace_back([&, i] {
+            first_failure.run({.test_case = i}, [&] {
+                oi::Scanner s{oi::Scanner::Memory{cases[i]}, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+                int x;
+                s >> oi::Num{x, 1, 10};
+            });
+        });
+        workers.back().join();
     }
-
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::UserOutput, oi::Lang::PL};
+    first_failure.exit_if_failed();
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput, EN) destructed before inwer_verdict.ok() is ok", "a", Exits{1, "Line 1, position 1: Read 'a', expected EOF\n"}) {
-    void* mem = mmap(nullptr, sizeof(oi::Scanner), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
-    if (mem == MAP_FAILED) { std::terminate(); }
-    auto dev_null_scanner = new (mem) oi::Scanner("/dev/null", oi::Scanner::Mode::TestInput, oi::Lang::EN);
-    dev_null_scanner->~Scanner();
-    if (munmap(mem, sizeof(oi::Scanner))) {
-        std::terminate();
+TEST("FirstFailure captures the destructor checks", "", Exits{1, "Line 1, position 2: Read ' ', expected EOF\n"}) {
+    const vector<string> cases = {"1", "2 ", "3", "42"};
+    oi::FirstFailure first_failure;
+    vector<std::thread> workers;
+    for (size_t i = 0; i < cases.size(); ++i) {
+        workers.emplace_back([&, i] {
+            first_failure.run({.test_case = i}, [&] {
+                oi::Scanner s{oi::Scanner::Memory{cases[i]}, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+                int x;
+                s >> oi::Num{x, 1, 10};
+            });
+        });
     }
-
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    first_failure.exit_if_failed();
     oi::inwer_verdict.exit_ok();
 }
 
-TEST("Scanner(TestInput, PL) destructed before inwer_verdict.ok() is ok", "a", Exits{1, "Wiersz 1, pozycja 1: Wczytano 'a', oczekiwano EOF\n"}) {
-    void* mem = mmap(nullptr, sizeof(oi::Scanner), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
-    if (mem == MAP_FAILED) { std::terminate(); }
-    auto dev_null_scanner = new (mem) oi::Scanner("/dev/null", oi::Scanner::Mode::TestInput, oi::Lang::PL);
-    dev_null_scanner->~Scanner();
-    if (munmap(mem, sizeof(oi::Scanner))) {
+TEST("FirstFailure with Mode::Lax", "", Exits{4, "Lax scanner: Wiersz 1, pozycja 2: Liczba calkowita spoza zakresu\n"}) {
+    oi::FirstFailure first_failure;
+    std::thread{[&] {
+        first_failure.run({.test_case = 1}, [&] {
+            oi::Scanner s{oi::Scanner::Memory{"42"}, oi::Scanner::Mode::Lax, oi::Lang::PL};
+            int x;
+            s >> oi::Num{x, 1, 10};
+        });
+    }}.join();
+    first_failure.exit_if_failed();
+}
+
+TEST("FirstFailure::propose_wrong() and cancelled()", "", Exits{0, "WRONG\nb\n0\n"}) {
+    oi::FirstFailure first_failure;
+    first_failure.exit_if_failed();
+    first_failure.propose_wrong({.test_case = 3, .token = 5}, 'a');
+    first_failure.propose_wrong({.test_case = 3, .token = 2}, 'b');
+    first_failure.propose_wrong({.test_case = 5}, 'c');
+    if (!first_failure.cancelled({.test_case = 4}) || first_failure.cancelled({.test_case = 3, .token = 9})) {
         std::terminate();
     }
+    if (first_failure.run({.test_case = 4}, [] { std::terminate(); })) { std::terminate(); }
+    if (!first_failure.run({.test_case = 2}, [] {})) { std::terminate(); }
+    first_failure.exit_if_failed();
+}
 
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::TestInput, oi::Lang::PL};
-    oi::inwer_verdict.exit_ok();
+TEST("available_threads()", "", Exits{0, "OK\n\n100\n"}) {
+    if (oi::available_threads() < 1) { std::terminate(); }
+    if (setenv("OI_THREADS", "5", 1) != 0 || oi::available_threads() != 5) { std::terminate(); }
+    if (setenv("USER", "oioioiworker", 1) != 0 || oi::available_threads() != 1) { std::terminate(); }
+    oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(Lax, EN) destructed before checker_verdict.exit_ok() is ok", "a", Exits{0, "OK\n\n100\n"}) {
-    void* mem = mmap(nullptr, sizeof(oi::Scanner), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
-    if (mem == MAP_FAILED) { std::terminate(); }
-    auto dev_null_scanner = new (mem) oi::Scanner("/dev/null", oi::Scanner::Mode::Lax, oi::Lang::EN);
-    dev_null_scanner->~Scanner();
-    if (munmap(mem, sizeof(oi::Scanner))) {
-        std::terminate();
+TEST("parallel_for() chunks do not depend on the number of threads", "", Exits{0, "OK\n\n100\n"}) {
+    if (setenv("OI_THREADS", "4", 1) != 0 || oi::available_threads() != 4) { std::terminate(); }
+    constexpr size_t n = 1'000'003, chunk = 1000;
+    vector<uint64_t> par(n), seq(n);
+    auto fill = [](vector<uint64_t>& vals, size_t begin, size_t end) {
+        oi::Random rng{begin};
+        for (size_t i = begin; i < end; ++i) {
+            vals[i] = rng(uint64_t{0}, std::numeric_limits<uint64_t>::max());
+        }
+    };
+    oi::parallel_for(n, chunk, [&](size_t begin, size_t end) { fill(par, begin, end); });
+    for (size_t begin = 0; begin < n; begin += chunk) {
+        fill(seq, begin, std::min(n, begin + chunk));
     }
+    if (par != seq) { std::terminate(); }
+    oi::parallel_for(0, chunk, [](size_t, size_t) { std::terminate(); });
+    oi::checker_verdict.exit_ok();
+}
 
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::EN};
+TEST("TaskGroup nested", "", Exits{0, "OK\n\n100\n"}) {
+    setenv("OI_THREADS", "3", 1);
+    auto fib = [](auto& self, int k) -> uint64_t {
+        if (k < 2) {
+            return static_cast<uint64_t>(k);
+        }
+        uint64_t a = 0, b = 0;
+        oi::TaskGroup tg;
+        tg.run([&] { a = self(self, k - 1); });
+        tg.run([&] { b = self(self, k - 2); });
+        tg.wait();
+        return a + b;
+    };
+    if (fib(fib, 22) != 17711) { std::terminate(); }
+    oi::parallel_for(1000, 7, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (fib(fib, static_cast<int>(i % 10)) == 1000) { std::terminate(); }
+        }
+    });
     oi::checker_verdict.exit_ok();
 }
 
-TEST("Scanner(Lax, PL) destructed before checker_verdict.exit_ok() is ok", "a", Exits{0, "OK\n\n100\n"}) {
-    void* mem = mmap(nullptr, sizeof(oi::Scanner), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
-    if (mem == MAP_FAILED) { std::terminate(); }
-    auto dev_null_scanner = new (mem) oi::Scanner("/dev/null", oi::Scanner::Mode::Lax, oi::Lang::PL);
-    dev_null_scanner->~Scanner();
-    if (munmap(mem, sizeof(oi::Scanner))) {
+TEST("TaskGroup tasks run in the capture context of their submitter", "", Exits{0, "WRONG\nLine 1, position 1: Read 'x', expected a number\n0\n"}) {
+    setenv("OI_THREADS", "4", 1);
+    oi::FirstFailure first_failure;
+    // Waiting inside run(), a thread picks up outer tasks, which start their own run()
+    oi::parallel_for(64, 1, [&](size_t begin, size_t /*end*/) {
+        first_failure.run({.test_case = begin}, [&] {
+            oi::parallel_for(1000, 10, [&](size_t b, size_t e) {
+                for (size_t i = b; i < e; ++i) {
+                    oi::Scanner s{oi::Scanner::Memory{begin == 7 && i == 500 ? "x" : "1"}, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+                    int x;
+                    s >> oi::Num{x, 1, 1};
+                }
+            });
+        });
+    });
+    first_failure.exit_if_failed();
+    oi::checker_verdict.exit_ok();
+}
+
+TEST("TaskGroup::wait() rethrows", "", Exits{0, "OK\n\n100\n"}) {
+    setenv("OI_THREADS", "2", 1);
+    oi::TaskGroup tg;
+    std::atomic<int> done = 0;
+    for (int i = 0; i < 100; ++i) {
+        tg.run([&done, i] {
+            ++done;
+            if (i == 42) {
+                throw std::runtime_error{"42"};
+            }
+        });
+    }
+    try {
+        tg.wait();
         std::terminate();
+    } catch (const std::runtime_error& e) {
+        if (string{e.what()} != "42" || done != 100) { std::terminate(); }
     }
-
-    auto s = oi::Scanner{stdin, oi::Scanner::Mode::Lax, oi::Lang::PL};
+    tg.wait();
     oi::checker_verdict.exit_ok();
 }
 
+TEST("Random::parallel_shuffle() on one thread", "", Exits{0, "OK\n11369540270575963432\n100\n"}) {
+    setenv("OI_THREADS", "1", 1);
+    vector<uint32_t> v(300'001);
+    std::iota(v.begin(), v.end(), 0);
+    oi::Random rd{123};
+    rd.parallel_shuffle(v);
+    auto sorted = v;
+    std::sort(sorted.begin(), sorted.end());
+    uint64_t hash = 0;
+    for (size_t i = 0; i < v.size(); ++i) {
+        if (sorted[i] != i) { std::terminate(); }
+        hash = hash * 1'000'003 + v[i];
+    }
+    oi::checker_verdict.exit_ok_with_score(100, hash);
+}
+
+TEST("Random::parallel_shuffle() on three threads", "", Exits{0, "OK\n11369540270575963432\n100\n"}) {
+    setenv("OI_THREADS", "3", 1);
+    vector<uint32_t> v(300'001);
+    std::iota(v.begin(), v.end(), 0);
+    oi::Random rd{123};
+    rd.parallel_shuffle(v);
+    uint64_t hash = 0;
+    for (size_t i = 0; i < v.size(); ++i) {
+        hash = hash * 1'000'003 + v[i];
+    }
+    oi::checker_verdict.exit_ok_with_score(100, hash);
+}
+
 template<class T, class Rand, std::enable_if_t<std::is_integral_v<T>, int> = 0>
 void distributes_evenly(T min, T max, size_t reps, Rand rnd) {
     vector<int> count(static_cast<size_t>(max - min + 1));
@@ -4123,6 +9091,106 @@ void test_random() {
             std::terminate();
         }
     }
+    {
+        oi::Random rd;
+        constexpr int N = 1'000'000;
+        auto dist = rd.discrete(vector<int>{1, 2, 3, 0, 4});
+        vector<int> count(dist.size());
+        for (int i = 0; i < N; ++i) {
+            ++count[rd(dist)];
+        }
+        for (size_t i = 0; i < count.size(); ++i) {
+            double expected = N * std::array{0.1, 0.2, 0.3, 0.0, 0.4}[i];
+            std::cerr << count[i] << ' ' << expected << '\n';
+            if (std::abs(count[i] - expected) > N * 0.005) {
+                std::terminate();
+            }
+        }
+    }
+    {
+        vector<double> weights(1000);
+        for (size_t i = 0; i < weights.size(); ++i) {
+            weights[i] = 1.0 / static_cast<double>(i + 1);
+        }
+        oi::Random rd1{7}, rd2{7};
+        auto dist = oi::Random::discrete(weights);
+        vector<uint16_t> samples(10000);
+        rd1.fill(std::span{samples}, dist);
+        for (auto x : samples) {
+            if (x != rd2(dist)) { std::terminate(); }
+        }
+        auto one = oi::Random::discrete(std::array{5.0});
+        for (int i = 0; i < 100; ++i) {
+            if (rd1(one) != 0) { std::terminate(); }
+        }
+    }
+    {
+        oi::Random rd;
+        constexpr int N = 100000;
+        std::map<vector<int>, int> count;
+        for (int i = 0; i < N; ++i) {
+            vector<int> v = {1, 2, 3, 4, 5};
+            rd.parallel_shuffle(v);
+            ++count[v];
+        }
+        if (count.size() != 120) { std::terminate(); }
+        auto [min_it, max_it] = std::ranges::minmax_element(count, {}, [](auto& kv) { return kv.second; });
+        if (max_it->second - min_it->second > static_cast<double>(N) / 120 * 0.5) {
+            std::terminate();
+        }
+    }
+    {
+        // Elements have to cross the blocks evenly
+        oi::Random rd;
+        constexpr size_t n = 3 << 16;
+        constexpr int runs = 300;
+        std::array<std::array<int, 3>, 2> count{};
+        vector<int> v(n);
+        for (int run = 0; run < runs; ++run) {
+            std::iota(v.begin(), v.end(), 0);
+            rd.parallel_shuffle(v);
+            count[0][static_cast<size_t>(std::find(v.begin(), v.end(), 0) - v.begin()) * 3 / n]++;
+            count[1][static_cast<size_t>(std::find(v.begin(), v.end(), n - 1) - v.begin()) * 3 / n]++;
+        }
+        for (auto& c : count) {
+            std::cerr << c[0] << ' ' << c[1] << ' ' << c[2] << '\n';
+            for (int x : c) {
+                if (std::abs(x - runs / 3) > 40) { std::terminate(); }
+            }
+        }
+    }
+    for (std::string_view alphabet : {"abcdefghijklmnopqrstuvwxyz", "01", "0123456789abcdef", "xyz"}) {
+        oi::Random rd;
+        constexpr size_t N = 1'000'000;
+        auto str = rd.string(N, alphabet);
+        std::array<int, 256> count{};
+        for (char c : str) {
+            ++count[static_cast<unsigned char>(c)];
+        }
+        double expected = static_cast<double>(N) / static_cast<double>(alphabet.size());
+        for (size_t c = 0; c < count.size(); ++c) {
+            if (alphabet.find(static_cast<char>(c)) == std::string_view::npos ? count[c] != 0
+                                                                               : std::abs(count[c] - expected) > expected * 0.02) {
+                std::terminate();
+            }
+        }
+        // Pairs of consecutive symbols, which come from one draw, have to be independent
+        std::map<std::pair<char, char>, int> pairs;
+        for (size_t i = 0; i + 1 < N; i += 2) {
+            ++pairs[{str[i], str[i + 1]}];
+        }
+        double expected_pair = expected / 2 / static_cast<double>(alphabet.size());
+        for (auto& [pair, c] : pairs) {
+            if (std::abs(c - expected_pair) > expected_pair * 0.15) { std::terminate(); }
+        }
+    }
+    {
+        oi::Random rd1{5}, rd2{5};
+        vector<int> a(1001), b(1001);
+        rd1.sequence(std::span{a}, vector<int>{-7, 42, 1'000'000});
+        rd2.sequence(std::span{b}, std::array{-7, 42, 1'000'000});
+        if (a != b || rd1.string(3, "x") != "xxx") { std::terminate(); }
+    }
 }
 
 int main() {
@@ -4136,3 +9204,704 @@ int main() {
 }
 
 #endif // OI_H_TESTS
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////// oi.h benchmarks /////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// g++ -std=c++23 -O2 -DOI_H_BENCHMARKS -x c++ oi.h -o bench && ./bench
+#if defined(OI_H_BENCHMARKS) && !defined(OI_H_TESTS)
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <numeric>
+#include <string>
+
+namespace bench {
+
+// Returns the best of a few runs, in nanoseconds
+template <class Fn>
+double best_time_ns(Fn&& fn) {
+    double best = std::numeric_limits<double>::max();
+    for (int run = 0; run < 5; ++run) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        auto end = std::chrono::steady_clock::now();
+        best = std::min(best, static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+    }
+    return best;
+}
+
+void tokens_vs_operator() {
+    constexpr int n = 10'000'000;
+    constexpr int max = 1 << 30;
+    std::string input;
+    uint64_t state = 42;
+    for (int i = 0; i < n; ++i) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        input += std::to_string(state >> 34 | 1);
+        input += ' ';
+    }
+    input += '\n';
+
+    int64_t operator_sum = 0, tokens_sum = 0;
+    double operator_ns = best_time_ns([&] {
+        auto s = oi::Scanner{oi::Scanner::Memory{input}, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+        operator_sum = 0;
+        for (int i = 0; i < n; ++i) {
+            int x;
+            s >> oi::Num{x, 1, max};
+            operator_sum += x;
+        }
+    });
+    double tokens_ns = best_time_ns([&] {
+        auto s = oi::Scanner{oi::Scanner::Memory{input}, oi::Scanner::Mode::UserOutput, oi::Lang::EN};
+        tokens_sum = 0;
+        for (int x : oi::tokens(s, 1, max).take(n)) {
+            tokens_sum += x;
+        }
+    });
+    if (operator_sum != tokens_sum) {
+        std::terminate();
+    }
+    (void)fprintf(stdout, "tokens() vs operator>>: %.2f ns/token vs %.2f ns/token (%.3fx)\n", tokens_ns / n, operator_ns / n,
+        tokens_ns / operator_ns);
+}
+
+void trusted_vs_lax() {
+    constexpr int n = 10'000'000;
+    string input;
+    uint64_t state = 7;
+    for (int i = 0; i < n; ++i) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        input += std::to_string(state >> 34);
+        input += i % 3 == 2 ? '\n' : ' ';
+    }
+
+    auto scan = [&](oi::Scanner::Mode mode) {
+        int64_t sum = 0;
+        auto s = oi::Scanner{oi::Scanner::Memory{input}, mode, oi::Lang::EN};
+        for (int i = 0; i < n; ++i) {
+            int x;
+            s >> oi::Num{x, 0, 1 << 30};
+            if (i % 3 == 2) {
+                s >> oi::nl;
+            } else {
+                s >> ' ';
+            }
+            sum += x;
+        }
+        return sum;
+    };
+    int64_t lax_sum = 0, trusted_sum = 0;
+    double lax_ns = best_time_ns([&] { lax_sum = scan(oi::Scanner::Mode::Lax); });
+    double trusted_ns = best_time_ns([&] { trusted_sum = scan(oi::Scanner::Mode::Trusted); });
+    if (lax_sum != trusted_sum) {
+        std::terminate();
+    }
+    (void)fprintf(stdout, "Mode::Trusted vs Mode::Lax: %.2f ns/token vs %.2f ns/token (%.3fx)\n", trusted_ns / n,
+        lax_ns / n, trusted_ns / lax_ns);
+}
+
+void cnum_vs_num() {
+    constexpr int n = 10'000'000;
+    constexpr int max = 1'000'000;
+    string input;
+    uint64_t state = 11;
+    for (int i = 0; i < n; ++i) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        input += std::to_string(state >> 33 & ((1 << 19) - 1));
+        input += ' ';
+    }
+
+    int64_t num_sum = 0, cnum_sum = 0;
+    double num_ns = best_time_ns([&] {
+        auto s = oi::Scanner{oi::Scanner::Memory{input}, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+        num_sum = 0;
+        for (int i = 0; i < n; ++i) {
+            int x;
+            s >> oi::Num{x, 0, max} >> ' ';
+            num_sum += x;
+        }
+    });
+    double cnum_ns = best_time_ns([&] {
+        auto s = oi::Scanner{oi::Scanner::Memory{input}, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+        cnum_sum = 0;
+        for (int i = 0; i < n; ++i) {
+            int x;
+            s >> oi::CNum<int, 0, max>{x} >> ' ';
+            cnum_sum += x;
+        }
+    });
+    if (num_sum != cnum_sum) {
+        std::terminate();
+    }
+    (void)fprintf(stdout, "CNum vs Num: %.2f ns/token vs %.2f ns/token (%.3fx)\n", cnum_ns / n, num_ns / n,
+        cnum_ns / num_ns);
+}
+
+void grid_vs_lines() {
+    constexpr size_t n = 4000, w = 4000;
+    string input;
+    uint64_t state = 3;
+    for (size_t r = 0; r < n; ++r) {
+        for (size_t c = 0; c < w; ++c) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            input += (state >> 63) ? '#' : '.';
+        }
+        input += '\n';
+    }
+
+    string grid;
+    vector<string> lines(n);
+    double grid_ns = best_time_ns([&] {
+        auto s = oi::Scanner{oi::Scanner::Memory{input}, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+        s >> oi::Grid{grid, n, w, ".#"} >> oi::nl >> oi::eof;
+    });
+    double lines_ns = best_time_ns([&] {
+        auto s = oi::Scanner{oi::Scanner::Memory{input}, oi::Scanner::Mode::TestInput, oi::Lang::EN};
+        for (auto& line : lines) {
+            s >> oi::Line{line, w} >> oi::nl;
+            if (line.size() != w || line.find_first_not_of(".#") != string::npos) {
+                std::terminate();
+            }
+        }
+        s >> oi::eof;
+    });
+    for (size_t r = 0; r < n; ++r) {
+        if (std::string_view{grid}.substr(r * w, w) != lines[r]) {
+            std::terminate();
+        }
+    }
+    (void)fprintf(stdout, "Grid vs Line per row (%zux%zu): %.2f ms vs %.2f ms (%.3fx)\n", n, w, grid_ns / 1e6,
+        lines_ns / 1e6, grid_ns / lines_ns);
+}
+
+void discrete_vs_binary_search() {
+    constexpr size_t n = 10'000'000;
+    constexpr size_t values = 100'000;
+    // Zipf-like weights
+    std::vector<double> weights(values), prefix_sums(values);
+    double sum = 0;
+    for (size_t i = 0; i < values; ++i) {
+        weights[i] = 1.0 / static_cast<double>(i + 1);
+        prefix_sums[i] = sum += weights[i];
+    }
+    std::vector<uint32_t> samples(n);
+
+    uint64_t discrete_sum = 0, binary_search_sum = 0;
+    double discrete_ns = best_time_ns([&] {
+        oi::Random rd{1};
+        auto dist = rd.discrete(weights);
+        rd.fill(std::span{samples}, dist);
+        discrete_sum = std::accumulate(samples.begin(), samples.end(), uint64_t{0});
+    });
+    double binary_search_ns = best_time_ns([&] {
+        oi::Random rd{1};
+        for (auto& x : samples) {
+            double r = rd(0.0, sum);
+            x = static_cast<uint32_t>(std::lower_bound(prefix_sums.begin(), prefix_sums.end() - 1, r) - prefix_sums.begin());
+        }
+        binary_search_sum = std::accumulate(samples.begin(), samples.end(), uint64_t{0});
+    });
+    // Both sample the same distribution, so the means have to be close
+    auto discrete_mean = static_cast<double>(discrete_sum) / n;
+    auto binary_search_mean = static_cast<double>(binary_search_sum) / n;
+    if (std::abs(discrete_mean - binary_search_mean) > 0.02 * binary_search_mean) {
+        std::terminate();
+    }
+    (void)fprintf(stdout, "Random::discrete() vs binary search: %.1f ms vs %.1f ms for %zu samples (%.3fx)\n",
+        discrete_ns / 1e6, binary_search_ns / 1e6, n, discrete_ns / binary_search_ns);
+}
+
+void parallel_shuffle_vs_shuffle() {
+    constexpr size_t n = 30'000'000;
+    std::vector<uint32_t> v(n);
+    double shuffle_ns = best_time_ns([&] {
+        std::iota(v.begin(), v.end(), 0);
+        oi::Random{1}.shuffle(v);
+    });
+    double parallel_shuffle_ns = best_time_ns([&] {
+        std::iota(v.begin(), v.end(), 0);
+        oi::Random{1}.parallel_shuffle(v);
+    });
+    (void)fprintf(stdout, "Random::parallel_shuffle() vs shuffle(): %.1f ms vs %.1f ms for %zu elements on %u threads (%.3fx)\n",
+        parallel_shuffle_ns / 1e6, shuffle_ns / 1e6, n, oi::available_threads(), parallel_shuffle_ns / shuffle_ns);
+}
+
+void string_vs_operator() {
+    constexpr size_t n = 100'000'000;
+    std::string str(n, '\0');
+    double operator_ns = best_time_ns([&] {
+        oi::Random rd{1};
+        for (char& c : str) {
+            c = rd('a', 'z');
+        }
+    });
+    double string_ns = best_time_ns([&] {
+        oi::Random rd{1};
+        str = rd.string(n, "abcdefghijklmnopqrstuvwxyz");
+    });
+    (void)fprintf(stdout, "Random::string() vs operator(): %.1f ms vs %.1f ms for %zu letters (%.3fx)\n", string_ns / 1e6,
+        operator_ns / 1e6, n, string_ns / operator_ns);
+}
+
+void write_parallel_vs_sequential() {
+    constexpr size_t n = 20'000'000;
+    int fd = memfd_create("bench", MFD_CLOEXEC);
+    auto format = [](auto& out, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            out << i << ' ' << i * 2654435761 % 1'000'000'007 << '\n';
+        }
+    };
+    double sequential_ns = best_time_ns([&] {
+        (void)lseek(fd, 0, SEEK_SET);
+        oi::Writer w{fd};
+        format(w, 0, n);
+    });
+    double parallel_ns = best_time_ns([&] {
+        (void)lseek(fd, 0, SEEK_SET);
+        oi::Writer w{fd};
+        w.write_parallel(n, 1 << 16, format);
+    });
+    (void)close(fd);
+    (void)fprintf(stdout, "Writer::write_parallel() vs operator<<(): %.1f ms vs %.1f ms for %zu lines on %u threads (%.3fx)\n",
+        parallel_ns / 1e6, sequential_ns / 1e6, n, oi::available_threads(), parallel_ns / sequential_ns);
+}
+
+} // namespace bench
+
+int main() {
+    bench::tokens_vs_operator();
+    bench::trusted_vs_lax();
+    bench::cnum_vs_num();
+    bench::grid_vs_lines();
+    bench::discrete_vs_binary_search();
+    bench::parallel_shuffle_vs_shuffle();
+    bench::string_vs_operator();
+    bench::write_parallel_vs_sequential();
+    return 0;
+}
+
+#endif // OI_H_BENCHMARKS
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////// oi.h differential tests //////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Scans generated and mutated inputs with a generated script, using every Scanner backend in every
+// Mode and Lang, and checks that the outcome is exactly the same as with the FILE* backend, which
+// scans byte by byte and is the reference for all the faster ones. Failures are captured in this
+// process like in FirstFailure::run(); only a Trusted Scanner, which exits with bug() on malformed
+// input, runs in a forked process, and only on inputs on which it may exit.
+// g++ -std=c++23 -O2 -DOI_H_DIFF_TESTS -x c++ oi.h -o diff_tests && ./diff_tests [inputs [seed]]
+#if defined(OI_H_DIFF_TESTS) && !defined(OI_H_TESTS) && !defined(OI_H_BENCHMARKS)
+
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+namespace diff_tests {
+
+struct Op {
+    enum Kind { INT, CINT, INT64, DOUBLE, CHAR, STR, LINE, GRID, SPACE, NL, IGNORE_WS, SKIP_LINES, END } kind;
+    int64_t min = 0, max = 0;
+    size_t size = 0;
+};
+
+using Script = vector<Op>;
+
+[[noreturn]] void fail(auto&&... msg) {
+    (std::cerr << ... << msg) << std::endl;
+    std::terminate();
+}
+
+// Appends to input a token that op accepts (most of the time)
+void gen_token(oi::Random& rnd, Script& script, string& input) {
+    auto random_word = [&](size_t len, std::string_view alphabet) {
+        for (size_t i = 0; i < len; ++i) {
+            input += alphabet[rnd(size_t{0}, alphabet.size() - 1)];
+        }
+    };
+    switch (rnd(0, 6)) {
+    case 6: {
+        script.push_back({.kind = Op::CINT});
+        input += std::to_string(rnd(-1010, 1010));
+    } break;
+    case 0: {
+        int64_t min = rnd(-1000, 1000);
+        int64_t max = min + rnd(0, 2000);
+        script.push_back({.kind = Op::INT, .min = min, .max = max});
+        input += std::to_string(rnd(min - 2, max + 2));
+    } break;
+    case 1: {
+        script.push_back({.kind = Op::INT64, .min = std::numeric_limits<int64_t>::min(), .max = std::numeric_limits<int64_t>::max()});
+        input += std::to_string(rnd(std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()));
+    } break;
+    case 2: {
+        script.push_back({.kind = Op::DOUBLE, .min = -100, .max = 100});
+        input += std::to_string(rnd(-110, 110));
+        if (rnd(0, 1)) {
+            input += '.';
+            random_word(rnd(size_t{1}, size_t{8}), "0123456789");
+        }
+    } break;
+    case 3: {
+        script.push_back({.kind = Op::CHAR});
+        random_word(1, "TNx");
+    } break;
+    case 4: {
+        size_t max = rnd(size_t{1}, size_t{8});
+        script.push_back({.kind = Op::STR, .size = max});
+        random_word(rnd(size_t{1}, max + 1), "abcXYZ09");
+    } break;
+    case 5: {
+        script.push_back({.kind = Op::IGNORE_WS});
+        random_word(rnd(0, 2), " \t");
+        gen_token(rnd, script, input);
+    } break;
+    }
+}
+
+void gen(oi::Random& rnd, Script& script, string& input) {
+    for (int lines = rnd(0, 6); lines-- > 0;) {
+        switch (rnd(0, 5)) {
+        case 0: {
+            size_t max = rnd(size_t{0}, size_t{12});
+            script.push_back({.kind = Op::LINE, .size = max});
+            for (size_t len = rnd(size_t{0}, max + 1); len-- > 0;) {
+                input += " ab\t"[rnd(0, 3)];
+            }
+        } break;
+        case 2: {
+            size_t rows = rnd(size_t{1}, size_t{3}), cols = rnd(size_t{1}, size_t{40});
+            script.push_back({.kind = Op::GRID, .min = static_cast<int64_t>(rows), .size = cols});
+            for (size_t r = 0; r < rows; ++r) {
+                if (r > 0) {
+                    input += '\n';
+                }
+                for (size_t c = 0; c < cols; ++c) {
+                    input += "..#"[rnd(0, 2)];
+                }
+            }
+        } break;
+        case 1: {
+            size_t k = rnd(size_t{0}, size_t{3});
+            script.push_back({.kind = Op::SKIP_LINES, .size = k});
+            for (size_t i = 0; i < k; ++i) {
+                for (int len = rnd(0, 5); len-- > 0;) {
+                    input += " x1\t"[rnd(0, 3)];
+                }
+                input += '\n';
+            }
+            continue;
+        }
+        default: {
+            for (int tokens = rnd(1, 5); tokens-- > 0;) {
+                gen_token(rnd, script, input);
+                if (tokens > 0) {
+                    script.push_back({.kind = Op::SPACE});
+                    input += ' ';
+                }
+            }
+        } break;
+        }
+        script.push_back({.kind = Op::NL});
+        input += '\n';
+    }
+    if (rnd(0, 1)) {
+        script.push_back({.kind = Op::END});
+    }
+}
+
+void mutate(oi::Random& rnd, string& input) {
+    constexpr std::string_view interesting = " \n\t\r-+.0019ea\x08";
+    for (int mutations = rnd(0, 3); mutations-- > 0;) {
+        size_t pos = rnd(size_t{0}, input.size());
+        char c = interesting[rnd(size_t{0}, interesting.size() - 1)];
+        switch (rnd(0, 4)) {
+        case 0: if (pos < input.size()) { input[pos] = c; } break;
+        case 1: input.insert(input.begin() + static_cast<ptrdiff_t>(pos), c); break;
+        case 2: if (pos < input.size()) { input.erase(pos, 1); } break;
+        case 3: input.resize(pos); break;
+        case 4: input += rnd(0, 1) ? ' ' : '\n'; break;
+        }
+    }
+}
+
+void run_script(oi::Scanner& s, const Script& script) {
+    for (auto& op : script) {
+        switch (op.kind) {
+        case Op::INT: {
+            int x;
+            s >> oi::Num{x, static_cast<int>(op.min), static_cast<int>(op.max)};
+        } break;
+        case Op::CINT: {
+            int x;
+            s >> oi::CNum<int, -1000, 1000>{x};
+        } break;
+        case Op::INT64: {
+            int64_t x;
+            s >> oi::Num{x, op.min, op.max};
+        } break;
+        case Op::DOUBLE: {
+            double x;
+            s >> oi::Num{x, static_cast<double>(op.min), static_cast<double>(op.max)};
+        } break;
+        case Op::CHAR: {
+            char c;
+            s >> oi::Char{c, "TN"};
+        } break;
+        case Op::STR: {
+            string str;
+            s >> oi::Str{str, op.size};
+        } break;
+        case Op::LINE: {
+            string line;
+            s >> oi::Line{line, op.size};
+        } break;
+        case Op::GRID: {
+            string cells;
+            s >> oi::Grid{cells, static_cast<size_t>(op.min), op.size, ".#"};
+        } break;
+        case Op::SPACE: s >> ' '; break;
+        case Op::NL: s >> oi::nl; break;
+        case Op::IGNORE_WS: s >> oi::ignore_ws; break;
+        case Op::SKIP_LINES: s.skip_lines(op.size); break;
+        case Op::END: s >> oi::eof; break;
+        }
+    }
+}
+
+enum class Backend { FILE_, FD, MMAP, MEMORY, GZIP };
+
+constexpr std::string_view backend_name(Backend backend) {
+    switch (backend) {
+    case Backend::FILE_: return "FILE*";
+    case Backend::FD: return "fd";
+    case Backend::MMAP: return "mmap";
+    case Backend::MEMORY: return "Memory";
+    case Backend::GZIP: return "gzip";
+    }
+    return "?";
+}
+
+int memfd_with(std::string_view data) {
+    int fd = memfd_create("oi.h diff test", 0);
+    if (fd == -1 || pwrite(fd, data.data(), data.size(), 0) != static_cast<ssize_t>(data.size())) {
+        fail("memfd_create() / pwrite() - ", strerror(errno));
+    }
+    return fd;
+}
+
+// Returns the exit code and the output of scanning input (stored in input_fd) with script in a
+// forked process
+string run_forked(const Script& script, std::string_view input, int input_fd, Backend backend, oi::Scanner::Mode mode, oi::Lang lang) {
+    int out_fd = memfd_create("oi.h diff test out", MFD_CLOEXEC);
+    if (out_fd == -1) {
+        fail("memfd_create() - ", strerror(errno));
+    }
+    int pid = fork();
+    if (pid == -1) {
+        fail("fork() - ", strerror(errno));
+    }
+    if (pid == 0) {
+        if (dup2(out_fd, STDOUT_FILENO) != STDOUT_FILENO || dup2(out_fd, STDERR_FILENO) != STDERR_FILENO ||
+            lseek(input_fd, 0, SEEK_SET) != 0)
+        {
+            std::abort();
+        }
+        oi::detail::change_error_ostream_to_cout();
+        string path = "/proc/self/fd/" + std::to_string(input_fd);
+        std::optional<oi::Scanner> s;
+        switch (backend) {
+        case Backend::FILE_: s.emplace(fdopen(input_fd, "r"), mode, lang); break;
+        case Backend::FD: s.emplace(input_fd, mode, lang); break;
+        case Backend::MMAP:
+        case Backend::GZIP: s.emplace(path.c_str(), mode, lang); break;
+        case Backend::MEMORY: s.emplace(oi::Scanner::Memory{input}, mode, lang); break;
+        }
+        run_script(*s, script);
+        if (mode == oi::Scanner::Mode::UserOutput) {
+            oi::checker_verdict.exit_ok();
+        }
+        oi::inwer_verdict.exit_ok();
+    }
+    int status;
+    if (waitpid(pid, &status, 0) != pid) {
+        fail("waitpid() - ", strerror(errno));
+    }
+    string out = WIFEXITED(status) ? "exited with " + std::to_string(WEXITSTATUS(status)) : "crashed";
+    out += ", output:\n";
+    std::array<char, 4096> buff;
+    for (off_t offset = 0;;) {
+        auto rc = pread(out_fd, buff.data(), buff.size(), offset);
+        if (rc < 0) {
+            fail("pread() - ", strerror(errno));
+        }
+        if (rc == 0) {
+            break;
+        }
+        offset += rc;
+        out.append(buff.data(), static_cast<size_t>(rc));
+    }
+    (void)close(out_fd);
+    // The same as the outcome of run_in_process() of a passing script
+    return out == "exited with 0, output:\n" ? "passed" : out;
+}
+
+constexpr std::string_view failure_kind_name(oi::detail::FailureKind kind) {
+    switch (kind) {
+    case oi::detail::FailureKind::CheckerWrong: return "checker WRONG";
+    case oi::detail::FailureKind::InwerWrong: return "inwer WRONG";
+    case oi::detail::FailureKind::LaxScanner: return "Lax scanner error";
+    }
+    return "?";
+}
+
+// Returns the outcome of scanning input (stored in input_fd) with script in this process, where
+// failures are thrown as CapturedFailure instead of exiting
+string run_in_process(const Script& script, std::string_view input, int input_fd, Backend backend, oi::Scanner::Mode mode, oi::Lang lang) {
+    if ((backend == Backend::FILE_ || backend == Backend::FD) && lseek(input_fd, 0, SEEK_SET) != 0) {
+        fail("lseek() - ", strerror(errno));
+    }
+    // Scanner does not close a FILE* it is given
+    FILE* file = backend == Backend::FILE_ ? fdopen(dup(input_fd), "r") : nullptr;
+    if (backend == Backend::FILE_ && !file) {
+        fail("fdopen() - ", strerror(errno));
+    }
+    string path = "/proc/self/fd/" + std::to_string(input_fd);
+    string out = "passed";
+    bool& capturing = oi::detail::capturing_failures();
+    capturing = true;
+    try {
+        std::optional<oi::Scanner> s;
+        switch (backend) {
+        case Backend::FILE_: s.emplace(file, mode, lang); break;
+        case Backend::FD: s.emplace(input_fd, mode, lang); break;
+        case Backend::MMAP:
+        case Backend::GZIP: s.emplace(path.c_str(), mode, lang); break;
+        case Backend::MEMORY: s.emplace(oi::Scanner::Memory{input}, mode, lang); break;
+        }
+        run_script(*s, script);
+        // Done here, because a failure thrown from the destructor of std::optional would terminate
+        s->do_destructor_checks();
+    } catch (oi::detail::CapturedFailure& failure) {
+        out = string{failure_kind_name(failure.kind)} + ": " + failure.msg;
+    }
+    capturing = false;
+    if (file) {
+        (void)fclose(file);
+    }
+    return out;
+}
+
+constexpr std::string_view mode_name(oi::Scanner::Mode mode) {
+    switch (mode) {
+    case oi::Scanner::Mode::UserOutput: return "UserOutput";
+    case oi::Scanner::Mode::Lax: return "Lax";
+    case oi::Scanner::Mode::TestInput: return "TestInput";
+    case oi::Scanner::Mode::Trusted: return "Trusted";
+    }
+    return "?";
+}
+
+string escaped(std::string_view str) {
+    string res;
+    for (char c : str) {
+        switch (c) {
+        case '\n': res += "\\n"; break;
+        case '\t': res += "\\t"; break;
+        case '\r': res += "\\r"; break;
+        case '\\': res += "\\\\"; break;
+        default:
+            if (isprint(static_cast<unsigned char>(c))) {
+                res += c;
+            } else {
+                res += "\\x";
+                res += "0123456789abcdef"[static_cast<unsigned char>(c) >> 4];
+                res += "0123456789abcdef"[c & 15];
+            }
+        }
+    }
+    return res;
+}
+
+#ifdef OI_H_ZLIB
+int gzip_memfd_with(std::string_view data) {
+    int fd = memfd_create("oi.h diff test gz", 0);
+    gzFile gz = fd == -1 ? nullptr : gzdopen(dup(fd), "wb");
+    if (!gz || gzwrite(gz, data.data(), static_cast<unsigned>(data.size())) != static_cast<int>(data.size()) ||
+        gzclose(gz) != Z_OK)
+    {
+        fail("gzip_memfd_with() failed");
+    }
+    return fd;
+}
+#endif
+
+} // namespace diff_tests
+
+int main(int argc, char** argv) {
+    using namespace diff_tests;
+    size_t inputs = argc > 1 ? std::stoull(argv[1]) : 200'000;
+    uint64_t seed = argc > 2 ? std::stoull(argv[2]) : 42;
+    oi::Random rnd{seed};
+    for (size_t i = 0; i < inputs; ++i) {
+        Script script;
+        string input;
+        gen(rnd, script, input);
+        mutate(rnd, input);
+
+        int input_fd = memfd_with(input);
+        vector<std::pair<Backend, int>> backends = {
+            {Backend::FD, input_fd}, {Backend::MMAP, input_fd}, {Backend::MEMORY, input_fd}};
+#ifdef OI_H_ZLIB
+        backends.emplace_back(Backend::GZIP, gzip_memfd_with(input));
+#endif
+        // A Trusted Scanner can only exit with bug() on input that does not pass as TestInput. Even
+        // then, if it passes with the FILE* backend, the other backends are expected to pass too.
+        std::array<bool, 2> passes_as_test_input{};
+        for (auto mode : {oi::Scanner::Mode::UserOutput, oi::Scanner::Mode::Lax, oi::Scanner::Mode::TestInput,
+                 oi::Scanner::Mode::Trusted})
+        {
+            for (auto lang : {oi::Lang::EN, oi::Lang::PL}) {
+                auto& passes = passes_as_test_input[static_cast<size_t>(lang)];
+                auto run = mode == oi::Scanner::Mode::Trusted && !passes ? run_forked : run_in_process;
+                auto expected = run(script, input, input_fd, Backend::FILE_, mode, lang);
+                if (mode == oi::Scanner::Mode::TestInput) {
+                    passes = (expected == "passed");
+                }
+                if (expected == "passed") {
+                    run = run_in_process;
+                }
+                for (auto [backend, fd] : backends) {
+                    auto out = run(script, input, fd, backend, mode, lang);
+                    if (out != expected) {
+                        fail("Input ", i, " (seed ", seed, "): \"", escaped(input), "\", mode ", mode_name(mode),
+                            ", lang ", lang == oi::Lang::EN ? "EN" : "PL", ":\nFILE* ", expected, "\n", backend_name(backend),
+                            " ", out);
+                    }
+                }
+            }
+        }
+        (void)close(input_fd);
+#ifdef OI_H_ZLIB
+        (void)close(backends.back().second);
+#endif
+    }
+    (void)fprintf(stdout, "Differential tests passed (%zu inputs)\n", inputs);
+    return 0;
+}
+
+#endif // OI_H_DIFF_TESTS
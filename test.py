@@ -28,7 +28,7 @@ def run(test_in: str, user_out: str, test_out: str):
         ["./checker", test_in_file.name, user_out_file.name, test_out_file.name],
         capture_output=True)
 
-    return bytes(ret, encoding='utf8')
+    return ret
 
 class TestCorrect():
     inputs = [("1\n2 1\n1 2 1", "NO", "NO")]
@@ -38,11 +38,14 @@ class TestCorrect():
         assert run(test_in, test_out, user_out).stdout == b'OK\n\n100\n'
 
 class TestWrong():
-    inputs = [("1\n2 1\n1 2 1", "NO", "no"), ("1\n2 1\n1 2 1", "NO", "YES\n1 1")]
+    inputs = [
+        ("1\n2 1\n1 2 1", "NO", "no", b'WRONG\n\n0\n'),
+        ("1\n2 1\n1 2 1", "NO", "YES\n1 1", b'WRONG\nPrzypadek testowy 1\n0\n'),
+    ]
 
-    @pytest.mark.parametrize("test_in,user_out,test_out", inputs)
-    def test_wrong(self, compile, test_in, test_out, user_out):
-        assert run(test_in, test_out, user_out).stdout == 'WRONG\n\n0\n'
+    @pytest.mark.parametrize("test_in,user_out,test_out,checker_out", inputs)
+    def test_wrong(self, compile, test_in, test_out, user_out, checker_out):
+        assert run(test_in, test_out, user_out).stdout == checker_out
 
 def wrong_message(line, pos, message, score = 0):
     return bytes(f"WRONG\nWiersz {line}, pozycja {pos}: {message}\n{score}\n", encoding='utf8')
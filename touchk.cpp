@@ -1,63 +1,153 @@
 #include "oi.h"
 #include <bits/stdc++.h>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
 using namespace std;
 
 constexpr auto scanner_lang = oi::Lang::PL;
 
+template <class T>
+using ArenaVector = vector<T, oi::ArenaAllocator<T>>;
+
+// Padded to 16 bytes, so that all fields of an edge are in the same cache line
+struct alignas(16) Edge {
+    int from, to, colour, unused;
+};
+
+// How many cycle ids ahead the edges are prefetched
+constexpr int prefetch_distance = 32;
+
+// Whether the edges with 1-based ids cycle[i], i >= begin, end where the next one (cyclically)
+// begins and differ from it in colour
+bool is_cycle_tail(const Edge* edges, const int* cycle, int begin, int k) {
+    for (int i = begin; i < k; ++i) {
+        if (i + prefetch_distance < k) {
+            __builtin_prefetch(&edges[cycle[i + prefetch_distance] - 1]);
+        }
+        const Edge& edge = edges[cycle[i] - 1];
+        const Edge& next = edges[cycle[i + 1 < k ? i + 1 : 0] - 1];
+        if (edge.to != next.from or edge.colour == next.colour) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#if defined(__x86_64__)
+// Same as is_cycle_tail(edges, cycle, 0, k), checks 8 consecutive pairs of edges at once
+__attribute__((target("avx2"))) bool is_cycle_avx2(const Edge* edges, const int* cycle, int k) {
+    const int* fields = &edges[0].from;
+    const __m256i one = _mm256_set1_epi32(1);
+    int i = 0;
+    // Every block also needs cycle[i + 8]; the last (incomplete) block wraps around
+    for (; i + 8 < k; i += 8) {
+        if (i + prefetch_distance + 8 < k) {
+            for (int j = 0; j < 8; ++j) {
+                __builtin_prefetch(&edges[cycle[i + prefetch_distance + j] - 1]);
+            }
+        }
+        // Indices of the field 'from' of the edges, in ints
+        __m256i ids = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cycle + i));
+        __m256i next_ids = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cycle + i + 1));
+        __m256i offsets = _mm256_slli_epi32(_mm256_sub_epi32(ids, one), 2);
+        __m256i next_offsets = _mm256_slli_epi32(_mm256_sub_epi32(next_ids, one), 2);
+        __m256i to = _mm256_i32gather_epi32(fields + 1, offsets, 4);
+        __m256i colour = _mm256_i32gather_epi32(fields + 2, offsets, 4);
+        __m256i next_from = _mm256_i32gather_epi32(fields, next_offsets, 4);
+        __m256i next_colour = _mm256_i32gather_epi32(fields + 2, next_offsets, 4);
+        __m256i bad = _mm256_or_si256(
+            _mm256_xor_si256(to, next_from), _mm256_cmpeq_epi32(colour, next_colour)
+        );
+        if (!_mm256_testz_si256(bad, bad)) {
+            return false;
+        }
+    }
+    return is_cycle_tail(edges, cycle, i, k);
+}
+#endif
+
+bool is_cycle(const Edge* edges, const int* cycle, int k) {
+#if defined(__x86_64__)
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    if (has_avx2) {
+        return is_cycle_avx2(edges, cycle, k);
+    }
+#endif
+    return is_cycle_tail(edges, cycle, 0, k);
+}
+
 [[noreturn]] void checker(
     [[maybe_unused]] oi::Scanner& tin,
     [[maybe_unused]] oi::Scanner& tout,
     oi::Scanner& user
 ) {
-    const int max_t = 1e6;
-    const int max_n = 1e6;
-    const int max_m = 1e6;
+    constexpr int max_t = 1e6;
+    constexpr int max_n = 1e6;
+    constexpr int max_m = 1e6;
     int t;
-    tin >> oi::Num{t, 1, max_t} >> oi::nl;
+    tin >> oi::CNum<int, 1, max_t>{t} >> oi::nl;
+    // Edges are accessed randomly, huge pages make it miss the TLB less often
+    oi::HugePageArena arena;
+    // Every test case gives an equal part of the points
+    oi::ScoreAggregator score{scanner_lang};
     for (int tt = 0; tt < t; ++tt) {
+        arena.reset();
         int n, m;
-        tin >> oi::Num{n, 1, max_n} >> ' ' >> oi::Num{m, 1, max_m} >> oi::nl;
-        vector<tuple<int, int, int>> edges(m);
-        for (auto& [a, b, c] : edges) {
-            tin >> oi::Num{a, 1, n} >> ' ' >> oi::Num{b, 1, n} >> ' ' >> oi::Num{c, 1, m} >> oi::nl;
-        }
+        tin >> oi::CNum<int, 1, max_n>{n} >> ' ' >> oi::CNum<int, 1, max_m>{m} >> oi::nl;
+        // Edges are needed only to verify a cycle, so for now only find where they end
+        auto edges_begin = tin.mark();
+        tin.skip_lines(m);
 
         string correct_out, user_out;
         tout >> oi::Str(correct_out, 4) >> oi::nl;
         user >> oi::Str(user_out, 4) >> oi::nl;
+        oi_assert(correct_out == "YES" or correct_out == "NO");
         if (correct_out != user_out) {
-            oi::checker_verdict.exit_wrong();
+            // After an answer that is neither, it is unknown where the next test case starts
+            if (user_out != "YES" and user_out != "NO") {
+                oi::checker_verdict.exit_wrong();
+            }
+            score.fail();
+            (correct_out == "YES" ? tout : user).skip_lines(1);
+            continue;
         }
-        oi_assert(correct_out == "YES" or correct_out == "NO");
         if (correct_out == "YES") {
             int k;
             user >> oi::Num{k, 1, m};
-            vector<int> cycle(k);
+            ArenaVector<int> cycle(k, oi::ArenaAllocator<int>{arena});
             for (auto& id : cycle) {
                 user >> oi::Num{id, 1, m};
             }
             user >> oi::nl;
-            for (int i = 0; i < k; ++i) {
-                auto [a, b, c] = edges[cycle[i] - 1];
-                auto [d, e, f] = edges[cycle[(i + 1) % k] - 1];
-                if (b != d or c == f) {
-                    oi::checker_verdict.exit_wrong();
-                }
+
+            auto edges_end = tin.mark();
+            tin.rewind(edges_begin);
+            ArenaVector<Edge> edges(m, oi::ArenaAllocator<Edge>{arena});
+            for (auto& e : edges) {
+                tin >> oi::Num{e.from, 1, n} >> ' ' >> oi::Num{e.to, 1, n} >> ' ' >> oi::Num{e.colour, 1, m} >> oi::nl;
+            }
+            tin.rewind(edges_end);
+
+            tout.skip_lines(1);
+            if (!is_cycle(edges.data(), cycle.data(), k)) {
+                score.fail();
+                continue;
             }
-            string h;
-            tout >> oi::Line{h, numeric_limits<size_t>::max()} >> oi::nl;
         }
+        score.pass();
     }
     user >> oi::eof;
     tout >> oi::eof;
-    oi::checker_verdict.exit_ok();
+    score.exit_with_verdict();
 }
 
 int main(int argc, char* argv[]) {
     oi_assert(argc == 4);
-    auto test_in = oi::Scanner(argv[1], oi::Scanner::Mode::Lax, scanner_lang);
+    // The test input and output have been validated already
+    auto test_in = oi::Scanner(argv[1], oi::Scanner::Mode::Trusted, scanner_lang);
     auto user_out = oi::Scanner(argv[2], oi::Scanner::Mode::UserOutput, scanner_lang);
-    auto test_out = oi::Scanner(argv[3], oi::Scanner::Mode::Lax, scanner_lang);
+    auto test_out = oi::Scanner(argv[3], oi::Scanner::Mode::Trusted, scanner_lang);
     checker(test_in, test_out, user_out);
 }
 
@@ -108,7 +198,7 @@ YES
 1 1
 @checker
 WRONG
-
+Przypadek testowy 1
 0
 )")
 
@@ -267,7 +357,7 @@ YES
 2 1 2
 @checker
 WRONG
-
+Przypadek testowy 1
 0
 )")
 
@@ -345,7 +435,7 @@ YES
 NO
 @checker
 WRONG
-
+Przypadek testowy 1
 0
 )")
 
@@ -365,7 +455,7 @@ YES
 2 1 4
 @checker
 WRONG
-
+Przypadek testowy 1
 0
 )")
 
@@ -574,6 +664,100 @@ WRONG
 0
 )")
 
+CHECKER_TEST(R"(
+@test_in
+3
+2 1
+1 2 1
+3 4
+1 2 1
+2 3 2
+3 2 3
+2 1 1
+2 1
+2 1 1
+@test_out
+NO
+YES
+2 2 3
+NO
+@user
+NO
+YES
+4 3 2 3 2
+NO
+@checker
+OK
+
+100
+)")
+
+CHECKER_TEST(R"(
+@test_in
+3
+2 1
+1 2 1
+3 4
+1 2 1
+2 3 2
+3 2 3
+2 1 1
+2 1
+2 1 1
+@test_out
+NO
+YES
+2 2 3
+NO
+@user
+NO
+YES
+2 2 3
+YES
+1 1
+@checker
+OK
+Przypadek testowy 3
+66
+)")
+
+CHECKER_TEST(R"(
+@test_in
+4
+2 1
+1 2 1
+3 4
+1 2 1
+2 3 2
+3 2 3
+2 1 1
+3 4
+1 2 1
+2 3 2
+3 2 3
+2 1 1
+2 1
+2 1 1
+@test_out
+NO
+YES
+2 2 3
+YES
+2 2 3
+NO
+@user
+YES
+1 1
+YES
+2 2 1
+NO
+NO
+@checker
+OK
+Przypadek testowy 1
+25
+)")
+
 CHECKER_TEST(R"(
 @test_in
 1
@@ -593,3 +777,112 @@ WRONG
 Wiersz 2, pozycja 6: Wczytano '\n', oczekiwano liczby
 0
 )")
+
+CHECKER_TEST(R"(
+@test_in
+1
+20 20
+1 2 2
+2 3 1
+3 4 2
+4 5 1
+5 6 2
+6 7 1
+7 8 2
+8 9 1
+9 10 2
+10 11 1
+11 12 2
+12 13 1
+13 14 2
+14 15 1
+15 16 2
+16 17 1
+17 18 2
+18 19 1
+19 20 2
+20 1 1
+@test_out
+YES
+20 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20
+@user
+YES
+20 8 9 10 11 12 13 14 15 16 17 18 19 20 1 2 3 4 5 6 7
+@checker
+OK
+
+100
+)")
+
+CHECKER_TEST(R"(
+@test_in
+1
+20 20
+1 2 2
+2 3 1
+3 4 2
+4 5 1
+5 6 2
+6 7 1
+7 8 2
+8 9 1
+9 10 2
+10 11 1
+11 12 2
+12 13 1
+13 14 2
+14 15 1
+15 16 2
+16 17 1
+17 18 2
+18 19 1
+19 20 2
+20 1 1
+@test_out
+YES
+20 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20
+@user
+YES
+20 1 2 3 4 5 6 7 8 9 10 12 11 13 14 15 16 17 18 19 20
+@checker
+WRONG
+Przypadek testowy 1
+0
+)")
+
+CHECKER_TEST(R"(
+@test_in
+1
+21 21
+1 2 2
+2 3 1
+3 4 2
+4 5 1
+5 6 2
+6 7 1
+7 8 2
+8 9 1
+9 10 2
+10 11 1
+11 12 2
+12 13 1
+13 14 2
+14 15 1
+15 16 2
+16 17 1
+17 18 2
+18 19 1
+19 20 2
+20 21 1
+21 1 2
+@test_out
+YES
+21 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21
+@user
+YES
+21 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21
+@checker
+WRONG
+Przypadek testowy 1
+0
+)")